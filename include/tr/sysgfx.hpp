@@ -30,17 +30,23 @@
 #include "sysgfx/index_buffer.hpp"        // IWYU pragma: export
 #include "sysgfx/keyboard.hpp"            // IWYU pragma: export
 #include "sysgfx/layered_multidrawer.hpp" // IWYU pragma: export
+#include "sysgfx/line_renderer.hpp"       // IWYU pragma: export
 #include "sysgfx/main.hpp"                // IWYU pragma: export
 #include "sysgfx/mouse.hpp"               // IWYU pragma: export
 #include "sysgfx/path.hpp"                // IWYU pragma: export
 #include "sysgfx/render_target.hpp"       // IWYU pragma: export
 #include "sysgfx/render_texture.hpp"      // IWYU pragma: export
 #include "sysgfx/shader.hpp"              // IWYU pragma: export
+#include "sysgfx/shader_batch.hpp"        // IWYU pragma: export
 #include "sysgfx/shader_buffer.hpp"       // IWYU pragma: export
 #include "sysgfx/shader_pipeline.hpp"     // IWYU pragma: export
+#include "sysgfx/sprite_renderer.hpp"     // IWYU pragma: export
 #include "sysgfx/state_machine.hpp"       // IWYU pragma: export
+#include "sysgfx/stream_buffer.hpp"       // IWYU pragma: export
+#include "sysgfx/text_renderer.hpp"       // IWYU pragma: export
 #include "sysgfx/texture.hpp"             // IWYU pragma: export
 #include "sysgfx/texture_ref.hpp"         // IWYU pragma: export
+#include "sysgfx/tilemap_renderer.hpp"    // IWYU pragma: export
 #include "sysgfx/ttfont.hpp"              // IWYU pragma: export
 #include "sysgfx/uniform_buffer.hpp"      // IWYU pragma: export
 #include "sysgfx/vertex_buffer.hpp"       // IWYU pragma: export
@@ -33,62 +33,169 @@
 //       std::ranges::fill(mesh.colors, "FFFFFF"_rgba8)                                                                                  //
 //       -> adds a textured rectangle to the renderer on layer 1 using a custom texture, transformation matrix, and blending mode        //
 //                                                                                                                                       //
+// Meshes are capped at 65535 vertices by default, as their indices are uploaded as 16-bit integers; past that, primitives are split into//
+// a new mesh (and a new draw call). Renderers created with 32-bit indices enabled lift this cap, while each mesh is still uploaded with //
+// 16-bit indices if it is small enough to allow it:                                                                                     //
+//     - tr::basic_renderer basic{context, tr::index_format::u32}                                                                        //
+//       -> creates an empty renderer whose meshes may exceed 65535 vertices                                                             //
+//                                                                                                                                       //
+// Mesh vertices are always stored interleaved on the CPU (tr::basic_renderer_vertex), no matter which vertex layout is used, so the     //
+// references returned by the allocation methods are strided views over the individual attributes of the allocated vertices rather than  //
+// contiguous spans: they can be indexed, iterated and passed to range algorithms, but have no .data() and don't convert to std::span.   //
+// The vertex layout only affects how vertices are uploaded to the GPU. By default, the vertex attributes are uploaded into separate     //
+// arrays, but renderers can also be created with an interleaved vertex layout, in which case each mesh is uploaded with a single copy   //
+// and bound as a single vertex buffer:                                                                                                  //
+//     - tr::basic_renderer basic{context, tr::index_format::u16, tr::vertex_layout::interleaved}                                        //
+//       -> creates an empty renderer that uploads its vertices interleaved                                                              //
+//                                                                                                                                       //
+// By default, only meshes using the same texture are batched together. Renderers can instead be created with texture array batching, in //
+// which case the textures of up to 256x256 used in a draw are copied into the layers of shared texture arrays (grouped by format,       //
+// filtering and size rounded up to a power of two), and meshes using different textures in the same array are batched together.         //
+// Textures keep their layers between draws and are only copied again once they're modified (render textures are copied on every draw),  //
+// while layers of textures unused in the current draw are reused for new ones. Only textures clamped to their edge and not sampled with //
+// a mipmap filter are gathered, as layers are always sampled that way:                                                                  //
+//     - tr::basic_renderer basic{context, tr::index_format::u16, tr::vertex_layout::separate, tr::texture_batching::texture_arrays}     //
+//       -> creates an empty renderer that batches meshes using different textures                                                       //
+//                                                                                                                                       //
+// Renderers can also skip geometry lying entirely outside of the render target (according to the transformation matrix of its mesh)     //
+// when drawing, either per mesh by testing its bounding box, or per triangle and line. Culled triangles and lines are only removed from //
+// the indices of their mesh, so their vertices are still uploaded. The amount of geometry culled by the latest drawer can be queried:   //
+//     - basic.set_culling(tr::culling::primitives) -> triangles and lines outside of the target are no longer drawn                     //
+//     - basic.culled_meshes() -> gets the number of meshes culled by the latest drawer                                                  //
+//     - basic.culled_primitives() -> gets the number of triangles and lines culled by the latest drawer                                 //
+//                                                                                                                                       //
+// Meshes that rarely change can instead be registered once as retained meshes, which keeps their data resident on the GPU. Retained     //
+// meshes are drawn every time their layer is drawn (before the primitives added to that layer) until they are freed. Only their         //
+// transformation matrix, tint and visibility can be changed after registration:                                                         //
+//     - tr::basic_renderer::static_mesh_id id{basic.new_static_color_mesh(0, tr::primitive::tris, positions, colors, indices)}          //
+//       -> uploads a retained color mesh on layer 0                                                                                     //
+//     - basic.set_static_mesh_transform(id, mat); basic.set_static_mesh_tint(id, "FF000080"_rgba8)                                      //
+//       -> the mesh is now drawn with a different transform and a translucent red tint                                                  //
+//     - basic.set_static_mesh_visible(id, false) -> the mesh is skipped when drawing                                                    //
+//     - basic.free_static_mesh(id) -> frees the mesh and its GPU data                                                                   //
+//                                                                                                                                       //
+// Primitives are uploaded into a single streaming arena, and consecutive meshes sharing a primitive type, texture and blending mode are //
+// submitted together with one indirect multi-draw, with their transformation matrices read from a shader storage buffer.                //
+//                                                                                                                                       //
 // Added primitives are not drawn until a call to a drawing functions. Aside from supporting tr::layered_multidrawer, the basic renderer //
-// can be drawn alone. Drawn primitives are erased from the renderer:                                                                    //
+// can be drawn alone. Drawn primitives are erased from the renderer, while retained meshes persist:                                     //
 //     - basic.draw(target) -> draws all layers to the target                                                                            //
 //                                                                                                                                       //
+// Primitives can also be allocated from other threads through recorders, which provide the same allocation methods as the renderer      //
+// (with textures passed as plain references) but only write into their own storage. Recorders are then merged into the renderer on its  //
+// thread, which adds their primitives as if they had been allocated directly in the same order, so merging a set of recorders in a      //
+// fixed order always gives the same result regardless of how the work was scheduled. The defaults of the renderer must not be changed   //
+// while recorders are in use, and textures used by recorded primitives must not be moved or destroyed before the recorder is merged:    //
+//     - tr::basic_renderer::recorder recorder{basic} -> creates an empty recorder for 'basic'                                           //
+//     - recorder.new_color_fan(0, 4) -> allocates a color fan in the recorder (can be done on a worker thread)                          //
+//     - basic.merge(recorder) -> adds the recorded primitives to 'basic' and clears 'recorder'                                          //
+//                                                                                                                                       //
+// The CPU-side storage of drawn meshes is kept and reused by later primitives, so a renderer drawing an unchanging workload stops       //
+// allocating after its first frame. The number of times storage had to be allocated can be gotten with .allocations():                  //
+//     - basic.allocations() -> gets the number of allocations made by the renderer so far                                               //
+// Debug builds assert that nothing is allocated when the same primitives are added and every layer is drawn two frames in a row, or     //
+// when a recorder records the same primitives as before it was last cleared or merged (registering or freeing a retained mesh, or a     //
+// mesh outgrowing the vertex limit, skips the check for that frame).                                                                    //
+//                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
+#include "../utility/steady_allocation_check.hpp"
 #include "blending.hpp"
 #include "graphics_context.hpp"
 #include "index_buffer.hpp"
 #include "render_target.hpp"
 #include "shader_pipeline.hpp"
+#include "stream_buffer.hpp"
 #include "texture.hpp"
+#include "vertex_buffer.hpp"
+#include "vertex_format.hpp"
 
 //////////////////////////////////////////////////////////////// INTERFACE ////////////////////////////////////////////////////////////////
 
 namespace tr {
+	// Layout of the vertex data uploaded by a renderer (vertex data is always stored interleaved on the CPU).
+	enum class vertex_layout : u8 {
+		// Every vertex attribute is uploaded into its own array.
+		separate,
+		// The vertex attributes are uploaded interleaved into a single array.
+		interleaved
+	};
+
+	// How a renderer batches meshes with different textures.
+	enum class texture_batching : u8 {
+		// Only meshes using the same texture are batched together.
+		per_texture,
+		// Small textures are gathered into shared texture arrays, so meshes using different textures can be batched together.
+		texture_arrays
+	};
+
+	// How a renderer culls geometry lying entirely outside of the render target.
+	enum class culling : u8 {
+		// Nothing is culled.
+		disabled,
+		// Meshes whose bounding box lies entirely outside of the render target are skipped.
+		meshes,
+		// Triangles and lines lying entirely outside of the render target are skipped.
+		primitives
+	};
+
+	// Vertex of the basic renderer.
+	struct basic_renderer_vertex {
+		// The position of the vertex.
+		glm::vec2 position;
+		// The UV of the vertex.
+		glm::vec2 uv;
+		// The tint of the vertex.
+		tr::rgba8 tint;
+
+		// The vertex attributes of the vertex.
+		static constexpr auto as_vertex_attribute_list{tr::as_vertex_attribute_list<glm::vec2, glm::vec2, tr::rgba8>};
+	};
+	// Writable range over one attribute of a run of basic renderer vertices. As the vertices are stored interleaved regardless of the
+	// vertex layout of the renderer, the range is strided: it isn't contiguous, has no .data(), and doesn't convert to std::span.
+	template <typename T>
+	using basic_renderer_attribute_range = std::ranges::transform_view<std::span<basic_renderer_vertex>, T basic_renderer_vertex::*>;
+
 	// Simple basic renderer color mesh allocation reference.
 	struct simple_color_mesh_ref {
 		// Mesh position data.
-		std::ranges::subrange<std::vector<glm::vec2>::iterator> positions;
+		basic_renderer_attribute_range<glm::vec2> positions;
 		// Mesh color data.
-		std::ranges::subrange<std::vector<tr::rgba8>::iterator> colors;
+		basic_renderer_attribute_range<tr::rgba8> colors;
 	};
 	// Full basic renderer color mesh allocation reference.
 	struct color_mesh_ref {
 		// Mesh position data.
-		std::ranges::subrange<std::vector<glm::vec2>::iterator> positions;
+		basic_renderer_attribute_range<glm::vec2> positions;
 		// Mesh color data.
-		std::ranges::subrange<std::vector<tr::rgba8>::iterator> colors;
+		basic_renderer_attribute_range<tr::rgba8> colors;
 		// Mesh indices.
-		std::ranges::subrange<std::vector<u16>::iterator> indices;
+		std::ranges::subrange<std::vector<u32>::iterator> indices;
 		// The base index.
-		u16 base_index;
+		u32 base_index;
 	};
 	// Simple basic renderer textured mesh allocation reference.
 	struct simple_textured_mesh_ref {
 		// Mesh position data.
-		std::ranges::subrange<std::vector<glm::vec2>::iterator> positions;
+		basic_renderer_attribute_range<glm::vec2> positions;
 		// Mesh UV data.
-		std::ranges::subrange<std::vector<glm::vec2>::iterator> uvs;
+		basic_renderer_attribute_range<glm::vec2> uvs;
 		// Mesh tint data.
-		std::ranges::subrange<std::vector<tr::rgba8>::iterator> tints;
+		basic_renderer_attribute_range<tr::rgba8> tints;
 	};
 	// Full basic renderer textured mesh allocation reference.
 	struct textured_mesh_ref {
 		// Mesh position data.
-		std::ranges::subrange<std::vector<glm::vec2>::iterator> positions;
+		basic_renderer_attribute_range<glm::vec2> positions;
 		// Mesh UV data.
-		std::ranges::subrange<std::vector<glm::vec2>::iterator> uvs;
+		basic_renderer_attribute_range<glm::vec2> uvs;
 		// Mesh tint data.
-		std::ranges::subrange<std::vector<tr::rgba8>::iterator> tints;
+		basic_renderer_attribute_range<tr::rgba8> tints;
 		// Mesh indices.
-		std::ranges::subrange<std::vector<u16>::iterator> indices;
+		std::ranges::subrange<std::vector<u32>::iterator> indices;
 		// The base index.
-		u16 base_index;
+		u32 base_index;
 	};
 
 	// Basic renderer for batched rawing in 2D.
@@ -97,13 +204,34 @@ namespace tr {
 	  public:
 		// Drawer class to which the basic renderer delegates the calling of draw commands.
 		class drawer;
+		// Recording context primitives can be allocated through off the renderer's thread.
+		class recorder;
+		// ID of a mesh retained by the renderer.
+		enum class static_mesh_id : u32 {
+		};
 
 		// Creates a basic renderer.
-		basic_renderer(graphics_context& context);
+		basic_renderer(graphics_context& context, index_format max_index_format = index_format::u16,
+					   tr::vertex_layout layout = tr::vertex_layout::separate,
+					   tr::texture_batching batching = tr::texture_batching::per_texture);
 
 		// Gets a reference to the graphics context the renderer is on.
 		graphics_context& context() const;
+		// Gets the layout the renderer uploads vertex data in.
+		tr::vertex_layout vertex_layout() const;
+		// Gets how the renderer batches meshes with different textures.
+		tr::texture_batching texture_batching() const;
+		// Gets the number of times the renderer had to allocate CPU-side storage.
+		usize allocations() const;
+		// Gets how the renderer culls geometry outside of the render target.
+		tr::culling culling() const;
+		// Gets the number of meshes culled by the latest drawer.
+		usize culled_meshes() const;
+		// Gets the number of triangles and lines culled by the latest drawer (including those of culled meshes).
+		usize culled_primitives() const;
 
+		// Sets how the renderer culls geometry outside of the render target.
+		void set_culling(tr::culling culling);
 		// Sets the default transformation matrix used by primitives on any layer without its own default transform.
 		void set_default_transform(const glm::mat4& mat);
 		// Sets the default texture used by textured primitives on a layer.
@@ -157,6 +285,30 @@ namespace tr {
 		// Allocates a new color line mesh.
 		color_mesh_ref new_line_mesh(int layer, usize vertices, usize indices, const glm::mat4& mat, const blend_mode& blend_mode);
 
+		// Registers a retained color mesh.
+		static_mesh_id new_static_color_mesh(int layer, primitive type, std::span<const glm::vec2> positions,
+											 std::span<const tr::rgba8> colors, std::span<const u32> indices);
+		// Registers a retained color mesh.
+		static_mesh_id new_static_color_mesh(int layer, primitive type, std::span<const glm::vec2> positions,
+											 std::span<const tr::rgba8> colors, std::span<const u32> indices, const glm::mat4& mat,
+											 const blend_mode& blend_mode);
+		// Registers a retained textured mesh.
+		static_mesh_id new_static_textured_mesh(int layer, primitive type, std::span<const glm::vec2> positions,
+												std::span<const glm::vec2> uvs, std::span<const tr::rgba8> tints, std::span<const u32> indices,
+												texture_ref texture);
+		// Registers a retained textured mesh.
+		static_mesh_id new_static_textured_mesh(int layer, primitive type, std::span<const glm::vec2> positions,
+												std::span<const glm::vec2> uvs, std::span<const tr::rgba8> tints, std::span<const u32> indices,
+												texture_ref texture, const glm::mat4& mat, const blend_mode& blend_mode);
+		// Sets the transformation matrix of a retained mesh.
+		void set_static_mesh_transform(static_mesh_id id, const glm::mat4& mat);
+		// Sets the tint of a retained mesh.
+		void set_static_mesh_tint(static_mesh_id id, tr::rgba8 tint);
+		// Sets whether a retained mesh is drawn.
+		void set_static_mesh_visible(static_mesh_id id, bool visible);
+		// Frees a retained mesh.
+		void free_static_mesh(static_mesh_id id);
+
 		// Creates a drawer for all layers in a range. The renderer is "locked" and can't be interacted with while the drawer exists.
 		drawer create_drawer(int min_layer, int max_layer);
 		// Creates a drawer for all layers in the renderer. The renderer is "locked" and can't be interacted with while the drawer exists.
@@ -164,6 +316,9 @@ namespace tr {
 		// Draws all added primitives to a rendering target.
 		void draw(const render_target& target);
 
+		// Moves the primitives allocated through a recorder into the renderer as if they were allocated directly, and clears the recorder.
+		void merge(recorder& recorder);
+
 	  private:
 		// Default layer information.
 		struct layer_defaults {
@@ -186,46 +341,191 @@ namespace tr {
 			glm::mat4 mat;
 			// The blending mode used by the mesh.
 			blend_mode blend_mode;
+			// The vertices of the mesh.
+			std::vector<basic_renderer_vertex> vertices;
+			// The indices of the mesh.
+			std::vector<u32> indices;
+			// The texture the textured lookup entry of the mesh is keyed on (or nullptr if it has none), kept so that the entry can be
+			// erased even if the texture is destroyed in the meantime. Free slots keep it to find the entries of their previous mesh.
+			const texture* lookup_texture{nullptr};
+		};
+		// Key used to look up the mesh primitives with a given set of parameters are added to.
+		struct mesh_key {
+			// The drawing priority of the mesh.
+			int layer;
+			// The mesh type.
+			primitive type;
+			// The texture used by the mesh (or nullptr for untextured primitives).
+			const texture* texture;
+			// The transformation matrix used by the mesh.
+			glm::mat4 mat;
+			// The blending mode used by the mesh.
+			blend_mode blend_mode;
+
+			friend bool operator==(const mesh_key& l, const mesh_key& r) = default;
+		};
+		// Mesh key hasher.
+		struct mesh_key_hash {
+			usize operator()(const mesh_key& key) const;
+		};
+		// Vertex buffers of a retained mesh uploaded in the separate layout.
+		struct static_attribute_buffers {
 			// The positions of the vertices of the mesh.
-			std::vector<glm::vec2> positions;
+			static_vertex_buffer<glm::vec2> positions;
 			// The UVs of the vertices of the mesh.
-			std::vector<glm::vec2> uvs;
+			static_vertex_buffer<glm::vec2> uvs;
 			// The tints of the vertices of the mesh.
-			std::vector<tr::rgba8> tints;
+			static_vertex_buffer<tr::rgba8> tints;
+		};
+		// A texture gathered into a texture array, kept between draws.
+		struct batched_texture {
+			// The version of the texture when it was copied into the array.
+			std::optional<u64> version;
+			// The index of the texture array, or std::nullopt if the texture can't be gathered into one.
+			std::optional<usize> array;
+			// The layer of the array the texture was copied into.
+			int layer;
+			// The size of the texture relative to the size of the layer.
+			glm::vec2 scale;
+			// The draw the texture was last used in.
+			u64 last_draw;
+		};
+		// A texture array textures are gathered into.
+		struct texture_array_batch {
+			// The texture array.
+			texture_array array;
+			// The textures occupying the layers of the array (or nullptr for free layers).
+			std::vector<const texture*> layers;
+		};
+		// Retained mesh data.
+		struct static_mesh {
+			// The drawing priority of the mesh.
+			int layer;
+			// The mesh type.
+			primitive type;
+			// The texture used by the mesh.
+			texture_ref texture;
+			// The transformation matrix used by the mesh.
+			glm::mat4 mat;
+			// The blending mode used by the mesh.
+			blend_mode blend_mode;
+			// The tint applied to the whole mesh.
+			tr::rgba8 tint;
+			// Whether the mesh is drawn.
+			bool visible;
+			// The vertices of the mesh, in the layout used by the renderer.
+			std::variant<static_attribute_buffers, static_vertex_buffer<basic_renderer_vertex>> vertices;
 			// The indices of the mesh.
-			std::vector<u16> indices;
+			static_index_buffer indices;
+			// The number of indices in the mesh.
+			usize index_count;
 		};
 
+		// The maximum width and height of textures gathered into texture arrays.
+		static constexpr int max_batched_texture_size{256};
+		// The maximum number of layers in a texture array.
+		static constexpr int max_texture_array_layers{256};
+		// The approximate size of a texture array in bytes, used to pick its number of layers.
+		static constexpr usize texture_array_bytes{16 * 1024 * 1024};
+
 		// The ID of the renderer.
 		renderer_id m_id;
+		// The maximum number of vertices in a single mesh.
+		usize m_max_mesh_vertices;
+		// The layout vertex data is uploaded in.
+		tr::vertex_layout m_vertex_layout;
+		// How meshes with different textures are batched.
+		tr::texture_batching m_texture_batching;
+		// How geometry outside of the render target is culled.
+		tr::culling m_culling{tr::culling::disabled};
+		// The number of meshes culled by the latest drawer.
+		usize m_culled_meshes{0};
+		// The number of triangles and lines culled by the latest drawer.
+		usize m_culled_primitives{0};
+		// Scratch storage for the clip outcodes of the vertices of a mesh being culled, kept between frames.
+		std::vector<u8> m_outcode_scratch;
 		// Global default transform.
 		glm::mat4 m_default_transform{1.0f};
 		// Layer defaults.
 		boost::unordered_flat_map<int, layer_defaults> m_layer_defaults;
-		// The list of meshes to draw.
+		// Mesh slots. Slots are stable while recording and are reused once their mesh is drawn.
 		std::vector<mesh> m_meshes;
+		// Indices of unused mesh slots, sorted by the vertex capacity of the slot.
+		std::vector<usize> m_free_slots;
+		// Maps the parameters of the meshes freed by the latest drawers to their slots, so that a mesh with the same parameters gets the
+		// same slot back in the next frame instead of one that may have to grow.
+		boost::unordered_flat_map<mesh_key, usize, mesh_key_hash> m_free_slot_lookup;
+		// Maps batch parameters to the slot of the mesh primitives with those parameters are added to.
+		boost::unordered_flat_map<mesh_key, usize, mesh_key_hash> m_mesh_lookup;
+		// Mesh slots in creation order, sorted by layer before drawing.
+		std::vector<usize> m_mesh_order;
+		// Whether the mesh order is currently sorted by layer.
+		bool m_mesh_order_sorted{true};
+		// Scratch storage for sorting the mesh order by (layer, creation order), kept between frames.
+		std::vector<std::tuple<int, usize, usize>> m_sort_scratch;
+		// Scratch storage for the index formats of a drawer, kept between frames.
+		std::vector<index_format> m_index_formats;
+		// The number of times CPU-side storage had to be allocated.
+		usize m_allocations{0};
+		// Texture arrays small textures are gathered into when batching with texture arrays.
+		std::vector<texture_array_batch> m_texture_arrays;
+		// The textures gathered into texture arrays, kept between draws so that unchanged textures aren't copied again.
+		boost::unordered_flat_map<const texture*, batched_texture> m_batched_textures;
+		// The number of draws textures were gathered into texture arrays for.
+		u64 m_batch_draws{0};
+		// Retained mesh slots, indexed by ID.
+		std::vector<std::optional<static_mesh>> m_static_meshes;
+		// IDs of unused retained mesh slots.
+		std::vector<static_mesh_id> m_free_static_mesh_ids;
+		// Retained mesh IDs sorted by layer.
+		std::vector<static_mesh_id> m_static_mesh_order;
 		// The pipeline and shaders used by the renderer.
 		owning_shader_pipeline m_pipeline;
-		// Vertex buffer for the positions of the vertices.
-		dyn_vertex_buffer<glm::vec2> m_vbuffer_positions;
-		// Vertex buffer for the UVs of the vertices.
-		dyn_vertex_buffer<glm::vec2> m_vbuffer_uvs;
-		// Vertex buffer for the tints of the vertices.
-		dyn_vertex_buffer<tr::rgba8> m_vbuffer_tints;
-		// The index buffer used by the renderer.
-		dyn_index_buffer m_ibuffer;
-		// Last used transform.
-		glm::mat4 m_last_transform{1.0f};
+		// The vertex format used by the renderer.
+		vertex_format m_vertex_format;
+		// Streaming buffer the vertex and index data is uploaded to.
+		stream_buffer m_stream_buffer;
 		// Last used blending mode.
 		blend_mode m_last_blend_mode{alpha_blending};
 #ifdef TR_ENABLE_ASSERTS
 		// Flag that is set to true when a drawer for this renderer exists.
 		bool m_locked{false};
+		// Checks that drawing the same workload as in the previous frame doesn't allocate.
+		steady_allocation_check m_allocation_check;
 #endif
 
+		// Gets the transformation matrix used by primitives on a layer by default.
+		const glm::mat4& layer_transform(int layer) const;
+		// Gets the blending mode used by primitives on a layer by default.
+		const blend_mode& layer_blend_mode(int layer) const;
+		// Gets the texture used by textured primitives on a layer by default (or nullptr if there is none).
+		const texture* layer_texture(int layer) const;
 		// Finds an appropriate mesh.
 		mesh& find_mesh(int layer, primitive type, texture_ref texture, const glm::mat4& mat, const blend_mode& blend_mode,
 						usize space_needed);
+		// Allocates a mesh slot, reusing the slot of a freed mesh with the same parameters or a free slot with enough capacity if possible.
+		usize allocate_mesh(int layer, primitive type, texture_ref texture, const glm::mat4& mat, const blend_mode& blend_mode,
+							usize space_needed);
+		// Sorts the mesh order by layer if needed.
+		void sort_mesh_order();
+		// Frees the slots of drawn meshes.
+		void free_meshes(std::ranges::subrange<std::vector<usize>::iterator> range);
+		// Culls the meshes, triangles and lines lying entirely outside of the render target.
+		void cull_meshes(std::ranges::subrange<std::vector<usize>::iterator> range);
+		// Frees the layer of a texture gathered into a texture array.
+		void release_batched_texture(const batched_texture& batched);
+		// Gathers the small textures used by meshes into texture arrays, copying only those that changed or were evicted.
+		void batch_textures(std::ranges::subrange<std::vector<usize>::iterator> range);
+		// Uploads and registers a retained mesh.
+		static_mesh_id add_static_mesh(int layer, primitive type, texture_ref texture, const glm::mat4& mat, const blend_mode& blend_mode,
+									   std::span<const glm::vec2> positions, std::span<const glm::vec2> uvs, std::span<const tr::rgba8> tints,
+									   std::span<const u32> indices);
+		// Uploads the vertex data of a retained mesh in the layout used by the renderer.
+		std::variant<static_attribute_buffers, static_vertex_buffer<basic_renderer_vertex>> make_static_vertex_buffers(
+			graphics_context& context, std::span<const glm::vec2> positions, std::span<const glm::vec2> uvs,
+			std::span<const tr::rgba8> tints);
+		// Gets a registered retained mesh.
+		static_mesh& get_static_mesh(static_mesh_id id);
 	};
 
 	// Drawer class to which the basic renderer delegates the calling of draw commands.
@@ -243,6 +543,8 @@ namespace tr {
 		int min_layer() const;
 		// Gets the maximum available layer for drawing.
 		int max_layer() const;
+		// Gets the first available layer greater than or equal to a layer (or INT_MAX if there is none).
+		int next_layer(int layer) const;
 
 		// Draws a single layer.
 		void draw_layer(int layer, const render_target& target);
@@ -250,33 +552,175 @@ namespace tr {
 		void draw(const render_target& target);
 
 	  private:
-		// Mesh drawing information.
-		struct mesh_draw_info {
-			// Starting offset within the vertex buffer.
-			usize vertex_offset;
-			// Starting offset within the index buffer.
-			usize index_offset;
+		// Per-draw information read by the vertex shader.
+		struct draw_info {
+			// The transformation matrix of the draw.
+			glm::mat4 transform;
+			// The tint of the draw.
+			glm::vec4 tint;
+			// The size of the texture relative to its texture array layer (xy) and the layer (z), or -1 in z if it isn't in an array.
+			glm::vec4 texture_info;
+		};
+		// Offsets of the uploaded data blocks within the stream buffer.
+		struct stream_offsets {
+			// Offset of the per-draw information (in bytes).
+			usize draw_infos;
+			// Offset of the interleaved vertices (in bytes).
+			usize vertices;
+			// Offset of the vertex positions (in bytes).
+			usize positions;
+			// Offset of the vertex UVs (in bytes).
+			usize uvs;
+			// Offset of the vertex tints (in bytes).
+			usize tints;
+			// Offset of the 32-bit indices (in bytes).
+			usize u32_indices;
+			// Offset of the 16-bit indices (in bytes).
+			usize u16_indices;
+			// Offset of the indirect draw commands (in bytes).
+			usize commands;
+			// Offset of the per-draw indices into the draw information (in bytes).
+			usize draw_indices;
 		};
 
 		// Reference to the parent renderer.
 		opt_ref<basic_renderer> m_renderer;
-		// The range of meshes to draw.
-		std::ranges::subrange<std::vector<mesh>::iterator> m_range;
-		// The drawing data.
-		std::vector<mesh_draw_info> m_data;
+		// The range of mesh slots to draw.
+		std::ranges::subrange<std::vector<usize>::iterator> m_range;
+		// The range of retained meshes to draw.
+		std::ranges::subrange<std::vector<static_mesh_id>::iterator> m_static_range;
+		// The formats the indices of the meshes were uploaded in.
+		std::vector<index_format> m_index_formats;
+		// The offsets of the uploaded data within the stream buffer.
+		stream_offsets m_offsets{};
+		// Whether the per-draw information, indirect draw commands and draw indices of this drawer are bound.
+		bool m_draw_data_bound{false};
+		// The format the stream buffer's indices are currently bound as, or nullopt if the stream buffer isn't bound.
+		std::optional<index_format> m_bound_index_format;
 
 		// Creates a drawer.
-		drawer(basic_renderer& renderer, std::ranges::subrange<std::vector<mesh>::iterator> range);
+		drawer(basic_renderer& renderer, std::ranges::subrange<std::vector<usize>::iterator> range,
+			   std::ranges::subrange<std::vector<static_mesh_id>::iterator> static_range);
+
+		// Gets the layer of a mesh slot.
+		int layer_of(usize slot) const;
+		// Gets the layer of a retained mesh.
+		int layer_of(static_mesh_id id) const;
+		// Gets the format a mesh's indices are uploaded in.
+		static index_format index_format_of(const mesh& mesh);
+		// Gets the vertex buffer slot the per-draw indices are bound to.
+		int draw_index_slot() const;
+		// Gets the texture array slot of a mesh's texture, or nullptr if it isn't in a texture array.
+		const batched_texture* batched_texture_of(const mesh& mesh) const;
+		// Gets whether two meshes can be drawn in the same indirect draw call.
+		bool batchable(usize l, usize r) const;
 
 		// Sets up the graphical context for drawing.
 		void setup_context(graphics_context& context);
+		// Binds the per-draw data of the drawer if needed.
+		void bind_draw_data(graphics_context& context);
 		// Sets up the graphical context for a specific draw call.
-		void setup_draw_call_state(graphics_context& context, texture_ref texture, const glm::mat4& transform,
-								   const blend_mode& blend_mode);
+		void setup_draw_call_state(graphics_context& context, texture_ref texture, const blend_mode& blend_mode);
+		// Sets up the graphical context for a draw call of meshes whose textures were gathered into a texture array.
+		void setup_draw_call_state(graphics_context& context, const texture_array& array, const blend_mode& blend_mode);
+		// Sets the blending mode used by a draw call.
+		void set_blend_mode(graphics_context& context, const blend_mode& blend_mode);
+		// Draws a range of meshes, batching consecutive meshes with the same state into a single indirect draw call.
+		void draw_meshes(graphics_context& context, usize first, usize last);
+		// Draws a single retained mesh.
+		void draw_static_mesh(graphics_context& context, static_mesh_id id, usize draw_index);
 
 		// Cleans up the drawing data and unlocks the parent renderer.
 		void clean_up();
 
 		friend class basic_renderer;
 	};
+
+	// Recording context primitives can be allocated through off the renderer's thread.
+	class basic_renderer::recorder {
+	  public:
+		// Creates an empty recorder for a renderer.
+		recorder(const basic_renderer& renderer);
+
+		// Gets the number of times the recorder had to allocate storage.
+		usize allocations() const;
+
+		// Allocates a new color fan.
+		simple_color_mesh_ref new_color_fan(int layer, usize vertices);
+		// Allocates a new color fan.
+		simple_color_mesh_ref new_color_fan(int layer, usize vertices, const glm::mat4& mat, const blend_mode& blend_mode);
+		// Allocates a new color polygon outline.
+		simple_color_mesh_ref new_color_outline(int layer, usize vertices);
+		// Allocates a new color polygon outline.
+		simple_color_mesh_ref new_color_outline(int layer, usize vertices, const glm::mat4& mat, const blend_mode& blend_mode);
+		// Allocates a new color mesh.
+		color_mesh_ref new_color_mesh(int layer, usize vertices, usize indices);
+		// Allocates a new color mesh.
+		color_mesh_ref new_color_mesh(int layer, usize vertices, usize indices, const glm::mat4& mat, const blend_mode& blend_mode);
+		// Allocates a new textured fan.
+		simple_textured_mesh_ref new_textured_fan(int layer, usize vertices);
+		// Allocates a new textured fan.
+		simple_textured_mesh_ref new_textured_fan(int layer, usize vertices, const texture& texture);
+		// Allocates a new textured fan.
+		simple_textured_mesh_ref new_textured_fan(int layer, usize vertices, const texture& texture, const glm::mat4& mat,
+												  const blend_mode& blend_mode);
+		// Allocates a new textured mesh.
+		textured_mesh_ref new_textured_mesh(int layer, usize vertices, usize indices);
+		// Allocates a new textured mesh.
+		textured_mesh_ref new_textured_mesh(int layer, usize vertices, usize indices, const texture& texture);
+		// Allocates a new textured mesh.
+		textured_mesh_ref new_textured_mesh(int layer, usize vertices, usize indices, const texture& texture, const glm::mat4& mat,
+											const blend_mode& blend_mode);
+
+		// Allocates a number of new color lines.
+		simple_color_mesh_ref new_lines(int layer, usize lines);
+		// Allocates a number of new color lines.
+		simple_color_mesh_ref new_lines(int layer, usize lines, const glm::mat4& mat, const blend_mode& blend_mode);
+		// Allocates a new color line strip.
+		simple_color_mesh_ref new_line_strip(int layer, usize vertices);
+		// Allocates a new color line strip.
+		simple_color_mesh_ref new_line_strip(int layer, usize vertices, const glm::mat4& mat, const blend_mode& blend_mode);
+		// Allocates a new color line loop.
+		simple_color_mesh_ref new_line_loop(int layer, usize vertices);
+		// Allocates a new color line loop.
+		simple_color_mesh_ref new_line_loop(int layer, usize vertices, const glm::mat4& mat, const blend_mode& blend_mode);
+		// Allocates a new color line mesh.
+		color_mesh_ref new_line_mesh(int layer, usize vertices, usize indices);
+		// Allocates a new color line mesh.
+		color_mesh_ref new_line_mesh(int layer, usize vertices, usize indices, const glm::mat4& mat, const blend_mode& blend_mode);
+
+		// Discards all recorded primitives.
+		void clear();
+
+	  private:
+		// Recorded mesh data.
+		struct recorded_mesh {
+			// The parameters of the mesh.
+			mesh_key key;
+			// The vertices of the mesh.
+			std::vector<basic_renderer_vertex> vertices;
+			// The indices of the mesh (relative to the start of the recorded mesh).
+			std::vector<u32> indices;
+		};
+
+		// Reference to the renderer the recorder was created for.
+		ref<const basic_renderer> m_renderer;
+		// Recorded meshes in creation order. Meshes past the used ones are kept to reuse their storage.
+		std::vector<recorded_mesh> m_meshes;
+		// The number of recorded meshes in use.
+		usize m_used_meshes{0};
+		// Maps mesh parameters to the index of the mesh primitives with those parameters are added to.
+		boost::unordered_flat_map<mesh_key, usize, mesh_key_hash> m_mesh_lookup;
+		// The number of times storage had to be allocated.
+		usize m_allocations{0};
+#ifdef TR_ENABLE_ASSERTS
+		// Checks that recording the same workload as before the previous clear doesn't allocate.
+		steady_allocation_check m_allocation_check;
+#endif
+
+		// Finds an appropriate recorded mesh.
+		recorded_mesh& find_mesh(const mesh_key& key, usize space_needed);
+
+		friend class basic_renderer;
+	};
 } // namespace tr
\ No newline at end of file
@@ -27,18 +27,35 @@
 //     - circle.add_outlined_circle(0, {{100, 250}, 15}, 4, "0000FF"_rgba8, "00FF00"_rgba8)                                              //
 //       -> adds a blue circle of radius 15 centered at (100, 250)  with a green outline of thickness 4 to layer 0                       //
 //                                                                                                                                       //
+// Circles are written directly into a persistently-mapped streaming buffer when a drawer is created, after which every layer is drawn   //
+// with a single instanced draw call.                                                                                                    //
+//                                                                                                                                       //
 // Added circles are not drawn until a call to one of the drawing functions. Aside from supporting tr::layered_multidrawer, the circle   //
 // renderer can be drawn alone. Drawn circles are erased from the renderer:                                                              //
 //     - circle.draw(target) -> draws all layers to the target                                                                           //
 //                                                                                                                                       //
+// Circles lying entirely outside of the render target (according to the transformation matrix of their layer) can be culled when        //
+// drawing, in which case they are never uploaded. The number of circles culled by the latest drawer can be queried:                     //
+//     - circle.set_culling(true) -> circles outside of the target are no longer drawn                                                   //
+//     - circle.culled_circles() -> gets the number of circles culled by the latest drawer                                               //
+//                                                                                                                                       //
+// The storage of drawn layers is kept and reused by later circles, so a renderer drawing an unchanging workload stops allocating after  //
+// its first frame. The number of times storage had to be allocated can be gotten with .allocations():                                   //
+//     - circle.allocations() -> gets the number of allocations made by the renderer so far                                              //
+// Debug builds assert that nothing is allocated when the same circles are added and every layer is drawn two frames in a row.           //
+//                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#pragma once
 #include "../utility/circle.hpp"
 #include "../utility/reference.hpp"
+#include "../utility/steady_allocation_check.hpp"
 #include "blending.hpp"
 #include "graphics_context.hpp"
+#include "layered_instance_drawer.hpp"
 #include "render_target.hpp"
 #include "shader_pipeline.hpp"
+#include "stream_buffer.hpp"
 
 ///////////////////////////////////////////////////////////// CIRCLE RENDERER /////////////////////////////////////////////////////////////
 
@@ -57,6 +74,8 @@ namespace tr {
 
 		// Sets the render scale hint for the renderer.
 		void set_render_scale(float render_scale);
+		// Sets whether circles lying entirely outside of the render target are culled.
+		void set_culling(bool culling);
 		// Sets the default transformation matrix used by circles on any layer without its own default transform.
 		void set_default_transform(const glm::mat4& mat);
 		// Sets the transformation matrix used by circles on a layer.
@@ -71,6 +90,13 @@ namespace tr {
 		// Adds an outlined circle to the renderer.
 		void add_outlined_circle(int layer, circle circle, float outline_thickness, rgba8 fill_color, rgba8 outline_color);
 
+		// Gets the number of times the renderer had to allocate CPU-side storage.
+		usize allocations() const;
+		// Gets whether circles lying entirely outside of the render target are culled.
+		bool culling() const;
+		// Gets the number of circles culled by the latest drawer.
+		usize culled_circles() const;
+
 		// Creates a drawer for all layers in a range. The renderer is "locked" and can't be interacted with while the drawer exists.
 		drawer create_drawer(int min_layer, int max_layer);
 		// Creates a drawer for all layers in the renderer. The renderer is "locked" and can't be interacted with while the drawer exists.
@@ -97,12 +123,16 @@ namespace tr {
 		};
 		// Layer information.
 		struct layer {
+			// The drawing priority of the layer.
+			int priority;
 			// The transormation matrix of the layer (or empty for the global default).
 			std::optional<glm::mat4> transform;
 			// The blending mode of the layer.
 			blend_mode blend_mode{alpha_blending};
 			// The circles to draw on this layer.
 			std::vector<circle> circles;
+			// The offset of the circles of the layer within the stream buffer while they are being drawn (in bytes).
+			usize offset{0};
 		};
 
 		// The bindings of the circle renderer vertex format.
@@ -112,14 +142,22 @@ namespace tr {
 		renderer_id m_id;
 		// Global default transform.
 		glm::mat4 m_default_transform{1.0f};
-		// Drawing layers.
-		std::map<int, layer> m_layers;
+		// The render scale hint of the renderer.
+		float m_render_scale{1.0f};
+		// Whether circles outside of the render target are culled.
+		bool m_culling{false};
+		// The number of circles culled by the latest drawer.
+		usize m_culled_circles{0};
+		// Drawing layers sorted by priority. Drawn layers are cleared instead of erased so that their storage can be reused.
+		std::vector<layer> m_layers;
+		// The number of times CPU-side storage had to be allocated.
+		usize m_allocations{0};
 		// The pipeline and shaders used by the renderer.
 		owning_shader_pipeline m_pipeline;
 		// The circle renderer vertex format.
 		vertex_format m_vertex_format;
-		// The shader circle buffer.
-		dyn_vertex_buffer<circle> m_shader_circles;
+		// Streaming buffer the circles are uploaded to.
+		stream_buffer m_stream_buffer;
 		// The vertices of the quad used to draw circles.
 		static_vertex_buffer<glm::u8vec2> m_quad_vertices;
 		// Last used transform.
@@ -129,46 +167,23 @@ namespace tr {
 #ifdef TR_ENABLE_ASSERTS
 		// Flag that is set to true when a staggered draw is ongoing.
 		bool m_locked{false};
+		// Checks that drawing the same workload as in the previous frame doesn't allocate.
+		steady_allocation_check m_allocation_check;
 #endif
+
+		// Gets a layer, creating it if it doesn't exist yet.
+		layer& get_layer(int layer);
+		// Adds a circle to a layer.
+		void push_circle(int layer, const circle& circle);
+
+		template <typename Renderer, auto Instances> friend class layered_instance_drawer;
 	};
 
 	// Drawer class to which the circle renderer delegates the calling of draw commands.
-	class circle_renderer::drawer {
-	  public:
-		// Moves a drawer.
-		drawer(drawer&& r) noexcept;
-		// Cleans up the drawing data and unlocks the parent renderer.
-		~drawer();
-
-		// Moves a drawer.
-		drawer& operator=(drawer&& r) noexcept;
-
-		// Gets the minimum available layer for drawing.
-		int min_layer() const;
-		// Gets the maximum available layer for drawing.
-		int max_layer() const;
-
-		// Draws a single layer.
-		void draw_layer(int layer, const render_target& target);
-		// Draws everything.
-		void draw(const render_target& target);
-
+	class circle_renderer::drawer : public layered_instance_drawer<circle_renderer, &circle_renderer::layer::circles> {
 	  private:
-		// Reference to the parent renderer.
-		opt_ref<circle_renderer> m_renderer;
-		// The range of circles to draw.
-		std::ranges::subrange<std::map<int, layer>::iterator> m_range;
-
 		// Creates a drawer.
-		drawer(circle_renderer& renderer, std::ranges::subrange<std::map<int, layer>::iterator> range);
-
-		// Sets up the graphical context for drawing.
-		void setup_context(graphics_context& context);
-		// Sets up the graphical context for a specific draw call.
-		void setup_draw_call_state(graphics_context& context, const glm::mat4& transform, const blend_mode& blend_mode);
-
-		// Cleans up the drawing data and unlocks the parent renderer.
-		void clean_up();
+		drawer(circle_renderer& renderer, std::ranges::subrange<std::vector<layer>::iterator> range);
 
 		friend class circle_renderer;
 	};
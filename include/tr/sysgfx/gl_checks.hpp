@@ -41,7 +41,8 @@ namespace tr {
 		mat3x4,
 		mat4x2,
 		mat4x3,
-		sampler2D = 0x8B5E
+		sampler2D = 0x8B5E,
+		sampler2DArray = 0x8DC1
 	};
 
 	// GLSL variable information.
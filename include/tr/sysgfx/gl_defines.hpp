@@ -1365,4 +1365,6 @@ inline constexpr unsigned int GL_HISTOGRAM{0x8024};
 inline constexpr unsigned int GL_PROXY_HISTOGRAM{0x8025};
 inline constexpr unsigned int GL_MINMAX{0x802E};
 inline constexpr unsigned int GL_CONTEXT_RELEASE_BEHAVIOR{0x82FB};
-inline constexpr unsigned int GL_CONTEXT_RELEASE_BEHAVIOR_FLUSH{0x82FC};
\ No newline at end of file
+inline constexpr unsigned int GL_CONTEXT_RELEASE_BEHAVIOR_FLUSH{0x82FC};
+inline constexpr unsigned int GL_MAX_SHADER_COMPILER_THREADS_KHR{0x91B0};
+inline constexpr unsigned int GL_COMPLETION_STATUS_KHR{0x91B1};
\ No newline at end of file
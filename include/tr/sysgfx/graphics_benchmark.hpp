@@ -15,20 +15,34 @@
 //       -> measures the GPU time of draw_things                                                                                         //
 //     - benchmark.clear() -> clears the benchmark measurement deque                                                                     //
 //                                                                                                                                       //
+// Measurements are taken with GPU timestamps from a pool of query objects, and .fetch() never waits for the GPU: it only collects the   //
+// measurements whose results are already available, so measurements usually arrive a few frames late, and unfinished ones are simply    //
+// picked up by a later call.                                                                                                            //
+//                                                                                                                                       //
+// Named scopes can be nested within each other (and within .start() and .stop()) to time multiple parts of a frame separately. The      //
+// name of a nested scope is prefixed by the names of its enclosing named scopes:                                                        //
+//     - benchmark.start_scope("world");                                                                                                 //
+//       benchmark.start_scope("layer 0"); draw_layer_0(); benchmark.stop_scope();                                                       //
+//       benchmark.start_scope("layer 1"); draw_layer_1(); benchmark.stop_scope();                                                       //
+//       benchmark.stop_scope();                                                                                                         //
+//       -> measures the GPU time of the scopes 'world', 'world/layer 0' and 'world/layer 1'                                             //
+//                                                                                                                                       //
 // Again, must like the regular benchmark, the latest, fastest, average, and slowest time can be obtained using the appropriate method,  //
 // though the graphics benchmark doesn't have an equivalent to tr::benchmark::fps. The measurement deque also doesn't contain starting   //
-// time points, unlike the regular benchmark:                                                                                            //
+// time points, unlike the regular benchmark. Passing a scope name gets the measurements of that scope instead:                          //
 //     - benchmark.latest() -> gets the latest measurement                                                                               //
 //     - benchmark.min() -> gets the shortest measurement time                                                                           //
 //     - benchmark.avg() -> gets the average of recent measurement times                                                                 //
 //     - benchmark.max() -> gets the longest measurement time                                                                            //
 //     - benchmark.measurements() -> gets the deque holding recent measurement times                                                     //
+//     - benchmark.avg("world/layer 0") -> gets the average of recent measurement times of the scope 'world/layer 0'                     //
 //                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
 #include "../utility/chrono.hpp"
 #include "../utility/handle.hpp"
+#include "../utility/hash_map.hpp"
 
 namespace tr {
 	class graphics_context;
@@ -50,21 +64,35 @@ namespace tr {
 		void start();
 		// Stops a measurement.
 		void stop();
-		// Fetches the latest measurement from the GPU. This blocks execution until the GPU is done.
+		// Starts a new measurement of a named scope.
+		void start_scope(std::string_view name);
+		// Stops the measurement of the innermost named scope.
+		void stop_scope();
+		// Fetches all finished measurements from the GPU without waiting for unfinished ones.
 		void fetch();
 		// Clears all previous and ongoing measurements from the queue.
 		void clear();
 
 		// Gets the duration of the latest measurement.
 		duration latest() const;
+		// Gets the duration of the latest measurement of a named scope.
+		duration latest(std::string_view scope) const;
 		// Gets the duration of the shortest available measurement.
 		duration min() const;
+		// Gets the duration of the shortest available measurement of a named scope.
+		duration min(std::string_view scope) const;
 		// Gets the duration of the longest available measurement.
 		duration max() const;
+		// Gets the duration of the longest available measurement of a named scope.
+		duration max(std::string_view scope) const;
 		// Gets the average duration of the available measurements.
 		duration avg() const;
+		// Gets the average duration of the available measurements of a named scope.
+		duration avg(std::string_view scope) const;
 		// Gets the available measurements.
 		const std::deque<duration>& measurements() const;
+		// Gets the available measurements of a named scope.
+		const std::deque<duration>& measurements(std::string_view scope) const;
 
 	  private:
 		struct deleter {
@@ -73,10 +101,55 @@ namespace tr {
 
 			void operator()(unsigned int id) const;
 		};
-
 		// OpenGL query object handle.
-		tr::handle<unsigned int, 0, deleter> m_qo;
-		// The measurement deque.
-		std::deque<duration> m_durations;
+		using query_handle = handle<unsigned int, 0, deleter>;
+		// A measurement that was issued to the GPU, but not fetched yet.
+		struct pending_measurement {
+			// The name of the measured scope (empty for measurements made with .start() and .stop()).
+			std::string scope;
+			// The timestamp query at the start of the measurement.
+			unsigned int start;
+			// The timestamp query at the end of the measurement, or 0 if the measurement is still ongoing.
+			unsigned int end;
+		};
+
+		// An ongoing named scope measurement.
+		struct active_scope {
+			// The index of the measurement in the pending queue.
+			usize measurement;
+			// The length of the name of the enclosing named scope.
+			usize parent_name_length;
+		};
+
+		// The number of query objects allocated at once when the pool runs out.
+		static constexpr usize query_block_size{16};
+		// The maximum number of measurements kept per scope.
+		static constexpr usize max_measurements{256};
+
+		// All query objects owned by the benchmark.
+		std::vector<query_handle> m_queries;
+		// Query objects that aren't in use.
+		std::vector<unsigned int> m_free_queries;
+		// Issued measurements in the order they were started.
+		std::deque<pending_measurement> m_pending;
+		// The index of the ongoing .start()/.stop() measurement in the pending queue.
+		std::optional<usize> m_active_measurement;
+		// The ongoing named scope measurements, innermost last.
+		std::vector<active_scope> m_active_scopes;
+		// The full name of the innermost ongoing named scope.
+		std::string m_scope_name;
+		// The number of measurements popped from the front of the pending queue (used to keep indices into it stable).
+		usize m_popped_measurements{0};
+		// The measurement deques of each scope.
+		string_flat_map<std::deque<duration>> m_durations;
+
+		// Allocates a block of query objects into the pool.
+		void allocate_queries(graphics_context& context);
+		// Takes a query object from the pool and records a timestamp into it.
+		unsigned int record_timestamp();
+		// Starts a measurement and returns its index in the pending queue.
+		usize start_measurement(std::string&& scope);
+		// Stops a measurement with a given index in the pending queue.
+		void stop_measurement(usize index);
 	};
 } // namespace tr
\ No newline at end of file
@@ -34,9 +34,28 @@
 //     - context.set_blend_mode(mode) -> sets the blending mode                                                                          //
 //     - context.set_vertex_format(format) -> sets the expected format of vertex data                                                    //
 //     - context.set_vertex_buffer(buffer, 0, 100) -> sets a buffer vertex data is pulled from, starting at offset 100, in slot 0        //
-//     - context.set_index_buffer(buffer) -> sets the buffer index data is pulled from                                                   //
+//     - context.set_index_buffer(buffer) -> sets the buffer index data (and the format of the indices) is pulled from                   //
+//     - context.set_draw_indirect_buffer(buffer) -> sets the buffer indirect draw commands are pulled from                              //
+//     - context.set_storage_buffer(0, buffer, 256, 1024) -> binds 1024 bytes of a buffer at offset 256 to storage buffer binding 0      //
+// The offsets of storage buffer bindings must be multiples of an implementation-defined alignment, which can be gotten with             //
+// .storage_buffer_offset_alignment().                                                                                                   //
+// Vertex and index buffers are part of the state of a vertex format, so they (along with the format of the indices) must be set again   //
+// after changing the vertex format.                                                                                                     //
 //                                                                                                                                       //
-// After setting up the graphical context, one of the four drawing functions may be called:                                              //
+// The context keeps a shadow copy of the state set through it (as well as the values of shader uniforms), and skips any state changes   //
+// that wouldn't change anything. Counters of issued and elided state changes can be gotten with .state_stats() and reset with           //
+// .reset_state_stats() (once per frame, for example):                                                                                   //
+//     - context.state_stats().elided -> the number of redundant state changes that were skipped since the last reset                    //
+//                                                                                                                                       //
+// Compiling shaders can take a noticeable amount of time, so an on-disk cache of linked shader program binaries can be enabled. The     //
+// cache is keyed on the shader source, and entries are only used if they were made by the same driver (vendor, renderer and version     //
+// strings); otherwise, or if an entry is corrupted or refused by the driver, the shader is compiled from source and the entry is        //
+// replaced. Failing to read from or write to the cache is never an error:                                                               //
+//     - context.enable_shader_cache("cache/shaders") -> shaders are now loaded from and stored in 'cache/shaders'                       //
+//     - context.shader_cache_stats().hits -> the number of shaders loaded from the cache                                                //
+//     - context.disable_shader_cache() -> shaders are always compiled from source again                                                 //
+//                                                                                                                                       //
+// After setting up the graphical context, one of the five drawing functions may be called:                                              //
 //     - context.draw(tr::primitive::tri_fan, 0, 4)                                                                                      //
 //       -> draws a triangle fan from the set vertex buffer                                                                              //
 //     - context.draw_indexed(tr::primitive::tris, 10, 15)                                                                               //
@@ -45,6 +64,8 @@
 //       -> draws 10 instances of a line loop from the set vertex buffer                                                                 //
 //     - context.draw_indexed_instances(tr::primitive::line_strip, 0, 10, 10)                                                            //
 //       -> draws 10 instances of a line strip using data from the set vertex and index buffers                                          //
+//     - context.draw_indexed_indirect(tr::primitive::tris, 80, 100)                                                                     //
+//       -> draws triangle meshes using the 100 tr::indexed_draw_commands starting at byte 80 of the indirect draw buffer                //
 //                                                                                                                                       //
 // Each context holds a backbuffer, and a render target corresponding to it can be gotten with .backbuffer().                            //
 // The only direct way of manipulating the backbuffer's contents is by clearing it or a region of it.                                    //
@@ -66,6 +87,8 @@
 #include "../utility/exception.hpp"
 #include "../utility/logger.hpp"
 #include "../utility/zstring_view.hpp"
+#include "blending.hpp"
+#include "index_buffer.hpp"
 #include "render_target.hpp"
 #include "texture_ref.hpp"
 #include "vertex_buffer.hpp"
@@ -74,10 +97,8 @@
 struct SDL_GLContextState;
 struct SDL_Window;
 namespace tr {
-	struct blend_mode;
-	class dyn_index_buffer;
 	class shader_pipeline;
-	class static_index_buffer;
+	class stream_buffer;
 	class window_view;
 } // namespace tr
 #ifdef TR_HAS_IMGUI
@@ -108,6 +129,42 @@ namespace tr {
 		patches = 14 // The vertices are sent to the tessellation shaders as patches.
 	};
 
+	// Indexed draw command, as laid out in an indirect draw buffer.
+	struct indexed_draw_command {
+		// The number of indices to draw.
+		u32 indices;
+		// The number of instances to draw.
+		u32 instances;
+		// The offset of the first index within the index buffer (in indices).
+		u32 first_index;
+		// The value added to every index before fetching vertices.
+		i32 base_vertex;
+		// The value added to the instance index before fetching instanced attributes.
+		u32 base_instance;
+	};
+
+	// Counters of the state-changing calls made through a graphics context.
+	struct graphics_state_stats {
+		// The number of state changes that were issued to OpenGL.
+		usize issued;
+		// The number of redundant state changes that were elided.
+		usize elided;
+		// The number of times the context had to be made current.
+		usize make_current_issued;
+		// The number of times making the context current was elided because it already was.
+		usize make_current_elided;
+	};
+
+	// Counters of the shader program binary cache of a graphics context.
+	struct shader_binary_cache_stats {
+		// The number of shader programs that were loaded from the cache.
+		usize hits;
+		// The number of shader programs that had to be compiled from source.
+		usize misses;
+		// The number of cache entries that were rejected (made by a different driver, corrupted, or refused by the driver).
+		usize rejected;
+	};
+
 	// Graphics context initialization error.
 	class graphics_context_init_error : public exception {
 	  public:
@@ -160,6 +217,22 @@ namespace tr {
 		render_target backbuffer() const;
 		// Gets a commonly used 2D vertex format.
 		const tr::vertex_format& vertex2_format();
+		// Gets the alignment the offsets of storage buffer bindings must be a multiple of.
+		usize storage_buffer_offset_alignment() const;
+
+		// Gets the counters of state changes issued and elided since the last reset.
+		const graphics_state_stats& state_stats() const;
+		// Resets the state change counters (meant to be called once per frame).
+		void reset_state_stats();
+
+		// Enables the on-disk shader program binary cache, storing the binaries in a directory.
+		void enable_shader_cache(const std::filesystem::path& directory);
+		// Disables the on-disk shader program binary cache.
+		void disable_shader_cache();
+		// Gets whether the on-disk shader program binary cache is enabled.
+		bool shader_cache_enabled() const;
+		// Gets the counters of the shader program binary cache.
+		const shader_binary_cache_stats& shader_cache_stats() const;
 
 		// Allocates a fresh renderer ID.
 		renderer_id allocate_renderer_id();
@@ -189,10 +262,18 @@ namespace tr {
 		void set_vertex_buffer(const basic_dyn_vertex_buffer& buffer, int slot, ssize offset, usize stride);
 		// // Sets an active vertex buffer.
 		template <standard_layout T> void set_vertex_buffer(const dyn_vertex_buffer<T>& buffer, int slot, ssize offset);
+		// Sets an active vertex buffer.
+		void set_vertex_buffer(const stream_buffer& buffer, int slot, ssize offset, usize stride);
 		// Sets the active index buffer.
 		void set_index_buffer(const static_index_buffer& buffer);
 		// Sets the active index buffer.
 		void set_index_buffer(const dyn_index_buffer& buffer);
+		// Sets the active index buffer.
+		void set_index_buffer(const stream_buffer& buffer, index_format format);
+		// Sets the active indirect draw command buffer.
+		void set_draw_indirect_buffer(const stream_buffer& buffer);
+		// Binds a region of a buffer to a shader storage buffer binding point.
+		void set_storage_buffer(unsigned int index, const stream_buffer& buffer, usize offset, usize size);
 
 		// Clears the backbuffer's color.
 		void clear_backbuffer(const rgbaf& color = {0, 0, 0, 0});
@@ -211,12 +292,68 @@ namespace tr {
 		void draw_indexed(primitive type, usize offset, usize indices);
 		// Draws an instanced indexed mesh.
 		void draw_indexed_instances(primitive type, usize offset, usize indices, int instances);
+		// Draws a number of indexed meshes using consecutive commands from the indirect draw buffer, starting at a byte offset.
+		void draw_indexed_indirect(primitive type, usize offset, usize draws);
 
 	  private:
 		// Context deleter.
 		struct deleter {
 			void operator()(SDL_GLContextState* context) const;
 		};
+		// Shadowed vertex buffer binding.
+		struct vertex_buffer_binding {
+			// The ID of the bound buffer.
+			unsigned int buffer;
+			// The offset of the binding within the buffer.
+			ssize offset;
+			// The stride of the binding.
+			usize stride;
+
+			friend bool operator==(const vertex_buffer_binding&, const vertex_buffer_binding&) = default;
+		};
+		// Shadowed storage buffer binding.
+		struct storage_buffer_binding {
+			// The ID of the bound buffer.
+			unsigned int buffer;
+			// The offset of the binding within the buffer.
+			usize offset;
+			// The size of the binding.
+			usize size;
+
+			friend bool operator==(const storage_buffer_binding&, const storage_buffer_binding&) = default;
+		};
+		// Shadow copy of the OpenGL state set through the context. Empty values denote unknown state.
+		struct shadow_state {
+			// Whether wireframe mode is enabled.
+			std::optional<bool> wireframe_mode;
+			// Whether face culling is enabled.
+			std::optional<bool> face_culling;
+			// Whether depth testing is enabled.
+			std::optional<bool> depth_test;
+			// The ID of the bound program pipeline.
+			std::optional<unsigned int> pipeline;
+			// The active blending mode.
+			std::optional<tr::blend_mode> blending;
+			// The ID of the bound VAO.
+			std::optional<unsigned int> vao;
+			// The vertex buffers bound to the VAO.
+			std::array<std::optional<vertex_buffer_binding>, 16> vertex_buffers;
+			// The ID of the index buffer bound to the VAO.
+			std::optional<unsigned int> index_buffer_id;
+			// The format of the indices in the index buffer bound to the VAO.
+			std::optional<tr::index_format> index_buffer_format;
+			// The ID of the bound indirect draw buffer.
+			std::optional<unsigned int> draw_indirect_buffer_id;
+			// The buffers bound to the shader storage buffer binding points.
+			std::array<std::optional<storage_buffer_binding>, 16> storage_buffers;
+		};
+		// On-disk shader program binary cache.
+		struct shader_cache {
+			// The directory the binaries are stored in.
+			std::filesystem::path directory;
+			// String identifying the driver; binaries made by any other driver are rejected.
+			std::string driver;
+		};
 
 		// Structure holding OpenGL function pointers.
 		struct glapi {
@@ -224,6 +361,8 @@ namespace tr {
 											const char* message, const void* userParam);
 
 			void (*allocate_2d_texture_storage)(unsigned int texture, int levels, unsigned int internalformat, int width, int height);
+			void (*allocate_3d_texture_storage)(unsigned int texture, int levels, unsigned int internalformat, int width, int height,
+												int depth);
 			void (*allocate_buffer_storage)(unsigned int buffer, std::intptr_t size, const void* data, unsigned int flags);
 			void (*begin_query)(unsigned int target, unsigned int id);
 			void (*bind_buffer)(unsigned int target, unsigned int buffer);
@@ -239,11 +378,13 @@ namespace tr {
 			void (*clear_texture_image)(unsigned int texture, int level, unsigned int format, unsigned int type, const void* data);
 			void (*clear_texture_sub_image)(unsigned int texture, int level, int xoffset, int yoffset, int zoffset, int width, int height,
 											int depth, unsigned int format, unsigned int type, const void* data);
+			unsigned int (*client_wait_sync)(void* sync, unsigned int flags, std::uint64_t timeout);
 			void (*copy_image_sub_data)(unsigned int srcName, unsigned int srcTarget, int srcLevel, int srcX, int srcY, int srcZ,
 										unsigned int dstName, unsigned int dstTarget, int dstLevel, int dstX, int dstY, int dstZ,
 										int srcWidth, int srcHeight, int srcDepth);
 			void (*create_buffers)(int n, unsigned int* buffers);
 			void (*create_framebuffers)(int n, unsigned int* framebuffers);
+			unsigned int (*create_program)();
 			void (*create_program_pipelines)(int n, unsigned int* pipelines);
 			unsigned int (*create_shader_program_v)(unsigned int type, int count, const char** strings);
 			void (*create_textures)(unsigned int target, int n, unsigned int* textures);
@@ -253,6 +394,7 @@ namespace tr {
 			void (*delete_program)(unsigned int program);
 			void (*delete_program_pipelines)(int n, const unsigned int* pipelines);
 			void (*delete_queries)(int n, const unsigned int* queries);
+			void (*delete_sync)(void* sync);
 			void (*delete_textures)(int n, const unsigned int* textures);
 			void (*delete_vertex_arrays)(int n, const unsigned int* arrays);
 			void (*disable)(unsigned int cap);
@@ -263,12 +405,15 @@ namespace tr {
 			void (*enable)(unsigned int cap);
 			void (*enable_vertex_array_attribute)(unsigned int vaobj, unsigned int index);
 			void (*end_query)(unsigned int target);
+			void* (*fence_sync)(unsigned int condition, unsigned int flags);
+			void (*finish)();
 			void (*generate_queries)(int n, unsigned int* ids);
 			void (*generate_texture_mipmap)(unsigned int texture);
 			unsigned int (*get_error)();
 			void (*get_buffer_parameter_iv)(unsigned int buffer, unsigned int pname, int* params);
 			void (*get_integer_v)(unsigned int pname, int* data);
 			void (*get_object_label)(unsigned int identifier, unsigned int name, int bufSize, int* length, char* label);
+			void (*get_program_binary)(unsigned int program, int bufSize, int* length, unsigned int* binaryFormat, void* binary);
 			void (*get_program_info_log)(unsigned int program, int maxLength, int* length, char* infoLog);
 			void (*get_program_interface_iv)(unsigned int program, unsigned int programInterface, unsigned int pname, int* params);
 			void (*get_program_iv)(unsigned int program, unsigned int pname, int* params);
@@ -277,13 +422,22 @@ namespace tr {
 			void (*get_program_resource_name)(unsigned int program, unsigned int programInterface, unsigned int index, int bufSize,
 											  int* length, char* name);
 			void (*get_query_object_i64v)(unsigned int id, unsigned int pname, std::int64_t* params);
+			void (*get_query_object_iv)(unsigned int id, unsigned int pname, int* params);
 			const unsigned char* (*get_string)(unsigned int name);
 			void (*get_texture_parameter_fv)(unsigned int texture, unsigned int pname, float* params);
+			void (*get_texture_level_parameter_iv)(unsigned int texture, int level, unsigned int pname, int* params);
 			void (*get_texture_parameter_iv)(unsigned int texture, unsigned int pname, int* params);
+			void (*get_texture_sub_image)(unsigned int texture, int level, int xoffset, int yoffset, int zoffset, int width, int height,
+										  int depth, unsigned int format, unsigned int type, int bufSize, void* pixels);
 			void (*invalidate_buffer_data)(unsigned int buffer);
 			void* (*map_buffer_range)(unsigned int buffer, std::intptr_t offset, std::intptr_t length, unsigned int access);
+			void (*multi_draw_elements_indirect)(unsigned int mode, unsigned int type, const void* indirect, int drawcount, int stride);
+			void (*query_counter)(unsigned int id, unsigned int target);
+			void (*read_pixels)(int x, int y, int width, int height, unsigned int format, unsigned int type, void* data);
 			void (*set_2d_texture_sub_image)(unsigned int texture, int level, int xoffset, int yoffset, int width, int height,
 											 unsigned int format, unsigned int type, const void* pixels);
+			void (*set_3d_texture_sub_image)(unsigned int texture, int level, int xoffset, int yoffset, int zoffset, int width, int height,
+											 int depth, unsigned int format, unsigned int type, const void* pixels);
 			void (*set_buffer_sub_data)(unsigned int buffer, std::intptr_t offset, std::intptr_t size, const void* data);
 			void (*set_clear_color)(float red, float green, float blue, float alpha);
 			void (*set_clear_depth)(double depth);
@@ -292,9 +446,12 @@ namespace tr {
 			void (*set_debug_message_control)(unsigned int source, unsigned int type, unsigned int severity, int count,
 											  const unsigned int* ids, bool enabled);
 			void (*set_framebuffer_texture)(unsigned int framebuffer, unsigned int attachment, unsigned int texture, int level);
+			void (*set_max_shader_compiler_threads)(unsigned int count);
 			void (*set_object_label)(unsigned int identifier, unsigned int name, int length, const char* label);
 			void (*set_pixel_store_i)(unsigned int pname, int param);
 			void (*set_polygon_mode)(unsigned int face, unsigned int mode);
+			void (*set_program_binary)(unsigned int program, unsigned int binaryFormat, const void* binary, int length);
+			void (*set_program_parameter_i)(unsigned int program, unsigned int pname, int value);
 			void (*set_program_uniform_1f)(unsigned int program, int location, float v0);
 			void (*set_program_uniform_1fv)(unsigned int program, int location, int count, const float* value);
 			void (*set_program_uniform_2f)(unsigned int program, int location, float v0, float v1);
@@ -358,10 +515,26 @@ namespace tr {
 		renderer_id m_active_renderer{renderer_id::no_renderer};
 		// The current render target.
 		std::optional<render_target> m_render_target;
+		// Shadow copy of the OpenGL state.
+		shadow_state m_shadow_state;
+		// Counters of issued and elided state changes.
+		mutable graphics_state_stats m_state_stats{};
 		// Tracks which texture units are allocated and what the textures bound to them are.
 		std::array<std::optional<texture_ref>, 80> m_texture_units{};
+		// The IDs of textures whose mipmaps are out of date and are regenerated before the next draw.
+		std::vector<unsigned int> m_dirty_mipmaps;
+		// Next available texture version.
+		u64 m_next_texture_version{1};
 		// Commonly used 2D vertex format.
 		std::optional<tr::vertex_format> m_vertex2_format;
+		// The shader program binary cache, if enabled.
+		std::optional<shader_cache> m_shader_cache;
+		// Counters of the shader program binary cache.
+		shader_binary_cache_stats m_shader_cache_stats{};
+		// Whether shader programs are compiled in parallel by the driver (GL_KHR_parallel_shader_compile).
+		bool m_parallel_shader_compile{false};
+		// The alignment the offsets of storage buffer bindings must be a multiple of (GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT).
+		usize m_storage_buffer_offset_alignment;
 #ifdef TR_ENABLE_GL_CHECKS
 		// Bindings of the last bound vertex format.
 		std::span<const vertex_binding> m_vertex_format_bindings;
@@ -371,6 +544,34 @@ namespace tr {
 
 		// Sets the context as current and returns the OpenGL API.
 		const glapi& make_current_and_return_glapi() const;
+		// Waits for a fence to be signaled, falling back to waiting for all issued commands to finish if the fence can't be waited on.
+		void wait_for_fence(void* fence) const;
+
+		// Records whether a state change was issued or elided and returns whether it should be issued.
+		bool record_state_change(bool changed) const;
+		// Binds a vertex buffer to a slot of the active VAO if it isn't already bound.
+		void bind_vertex_buffer(unsigned int id, int slot, ssize offset, usize stride);
+		// Binds an index buffer to the active VAO if it isn't already bound.
+		void bind_index_buffer(unsigned int id);
+		// Binds a range of a buffer to a shader storage buffer binding point if it isn't already bound.
+		void bind_storage_buffer(unsigned int index, unsigned int id, usize offset, usize size);
+		// Forgets all shadowed state, forcing the next state changes to be issued.
+		void invalidate_shadow_state();
+		// Forgets shadowed bindings of a buffer that is being deleted.
+		void forget_buffer(unsigned int id);
+		// Forgets the shadowed binding of a program pipeline that is being deleted.
+		void forget_shader_pipeline(unsigned int id);
+		// Forgets the shadowed binding of a VAO that is being deleted.
+		void forget_vertex_format(unsigned int id);
+
+		// Creates a separable shader program, going through the shader program binary cache if it's enabled.
+		unsigned int create_shader_program(unsigned int type, zstring_view source);
+		// Starts compiling a separable shader program from source without waiting for it to finish.
+		unsigned int compile_shader_program(unsigned int type, zstring_view source);
+		// Tries to load a shader program from the shader cache, returning 0 if it's disabled or the entry is missing or rejected.
+		unsigned int load_cached_shader_program(unsigned int type, std::string_view source);
+		// Stores the binary of a successfully linked shader program into the shader cache if it's enabled.
+		void store_cached_shader_program(unsigned int program, unsigned int type, std::string_view source);
 
 		// Checks the render target's FBO ID.
 		bool is_fbo_of_render_target(unsigned int fbo);
@@ -385,6 +586,14 @@ namespace tr {
 		void free_texture_unit(unsigned int id);
 		// Rebinds texture units bound to a texture that got reallocated.
 		void rebind_texture_units(const texture& texture);
+		// Marks the mipmaps of a texture as out of date.
+		void mark_mipmaps_dirty(unsigned int texture);
+		// Forgets the out-of-date mipmaps of a texture that is being deleted or reallocated.
+		void forget_dirty_mipmaps(unsigned int texture);
+		// Regenerates all out-of-date mipmaps.
+		void generate_dirty_mipmaps();
+		// Allocates a fresh texture version.
+		u64 allocate_texture_version();
 
 #ifdef TR_ENABLE_GL_CHECKS
 		// Checks if a vertex buffer's type's attribute match those of the current vertex format.
@@ -404,9 +613,14 @@ namespace tr {
 		friend class graphics_buffer;
 		friend class render_texture;
 		friend class shader_base;
+		friend class shader_batch;
 		friend class shader_pipeline;
 		friend class static_index_buffer;
+		friend class stream_buffer;
 		friend class texture;
+		friend class texture_array;
+		friend class texture_readback;
+		friend class texture_uploader;
 		friend class vertex_format;
 #ifdef TR_HAS_IMGUI
 		friend void ImGui::Init(graphics_context& context);
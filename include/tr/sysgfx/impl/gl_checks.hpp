@@ -119,6 +119,9 @@ template <typename FormatContext> constexpr auto TR_FMT::formatter<tr::glsl_type
 	case tr::glsl_type::sampler2D:
 		str = "sampler2D";
 		break;
+	case tr::glsl_type::sampler2DArray:
+		str = "sampler2DArray";
+		break;
 	default:
 		str = "<unknown>";
 		break;
@@ -0,0 +1,15 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements the constexpr parts of index_buffer.hpp.                                                                                   //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../index_buffer.hpp"
+
+/////////////////////////////////////////////////////////////// INDEX FORMAT //////////////////////////////////////////////////////////////
+
+constexpr tr::usize tr::index_size(index_format format)
+{
+	return format == index_format::u32 ? sizeof(u32) : sizeof(u16);
+}
\ No newline at end of file
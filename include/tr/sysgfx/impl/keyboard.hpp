@@ -503,6 +503,28 @@ consteval tr::key_chord tr::keyboard_literals::operator""_kc(const char* cstr, u
 	return chord;
 }
 
+//////////////////////////////////////////////////////////////// BINARY IO ////////////////////////////////////////////////////////////////
+
+template <tr::binary_source Source> void tr::binary_reader<tr::scan_chord>::operator()(Source& is, tr::scan_chord& out) const
+{
+	read_binary(is, out.mods, out.scan);
+}
+
+template <tr::binary_sink Sink> void tr::binary_writer<tr::scan_chord>::operator()(Sink& os, const tr::scan_chord& in) const
+{
+	write_binary(os, in.mods, in.scan);
+}
+
+template <tr::binary_source Source> void tr::binary_reader<tr::key_chord>::operator()(Source& is, tr::key_chord& out) const
+{
+	read_binary(is, out.mods, out.key);
+}
+
+template <tr::binary_sink Sink> void tr::binary_writer<tr::key_chord>::operator()(Sink& os, const tr::key_chord& in) const
+{
+	write_binary(os, in.mods, in.key);
+}
+
 //////////////////////////////////////////////////////////////// FORMATTERS ///////////////////////////////////////////////////////////////
 
 template <typename FormatContext> constexpr auto TR_FMT::formatter<tr::scancode>::format(tr::scancode scan, FormatContext& ctx) const
@@ -0,0 +1,197 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements layered_instance_drawer.hpp.                                                                                               //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../layered_instance_drawer.hpp"
+
+///////////////////////////////////////////////////////////////// DRAWER //////////////////////////////////////////////////////////////////
+
+template <typename Renderer, auto Instances>
+tr::layered_instance_drawer<Renderer, Instances>::layered_instance_drawer(
+	Renderer& renderer, std::ranges::subrange<typename std::vector<layer_type>::iterator> range)
+	: m_renderer{renderer}
+	, m_range{range}
+{
+	TR_ASSERT(!m_renderer->m_locked, "Tried to create multiple simultaneous drawers of a layered renderer.");
+
+#ifdef TR_ENABLE_ASSERTS
+	m_renderer->m_locked = true;
+#endif
+}
+
+template <typename Renderer, auto Instances>
+tr::layered_instance_drawer<Renderer, Instances>::layered_instance_drawer(layered_instance_drawer&& r) noexcept
+	: m_renderer{std::exchange(r.m_renderer, std::nullopt)}
+	, m_range{r.m_range}
+{
+}
+
+template <typename Renderer, auto Instances> tr::layered_instance_drawer<Renderer, Instances>::~layered_instance_drawer()
+{
+	clean_up();
+}
+
+template <typename Renderer, auto Instances>
+tr::layered_instance_drawer<Renderer, Instances>& tr::layered_instance_drawer<Renderer, Instances>::operator=(
+	layered_instance_drawer&& r) noexcept
+{
+	clean_up();
+	m_renderer = std::exchange(r.m_renderer, std::nullopt);
+	m_range = r.m_range;
+	return *this;
+}
+
+//
+
+template <typename Renderer, auto Instances> int tr::layered_instance_drawer<Renderer, Instances>::min_layer() const
+{
+	const auto it{first_nonempty(m_range.begin())};
+	return it != m_range.end() ? it->priority : INT_MAX;
+}
+
+template <typename Renderer, auto Instances> int tr::layered_instance_drawer<Renderer, Instances>::max_layer() const
+{
+	for (auto it = m_range.end(); it != m_range.begin();) {
+		if (!((*--it).*Instances).empty()) {
+			return it->priority;
+		}
+	}
+	return INT_MIN;
+}
+
+template <typename Renderer, auto Instances> int tr::layered_instance_drawer<Renderer, Instances>::next_layer(int layer) const
+{
+	const auto it{first_nonempty(std::ranges::lower_bound(m_range, layer, std::less{}, &layer_type::priority))};
+	return it != m_range.end() ? it->priority : INT_MAX;
+}
+
+//
+
+template <typename Renderer, auto Instances>
+void tr::layered_instance_drawer<Renderer, Instances>::draw_layer(int layer, const render_target& target)
+{
+	TR_ASSERT(m_renderer.has_ref(), "Tried to draw a layer from a moved-from layered renderer drawer.");
+
+	const auto layer_it{std::ranges::lower_bound(m_range, layer, std::less{}, &layer_type::priority)};
+	if (layer_it == m_range.end() || layer_it->priority != layer || ((*layer_it).*Instances).empty()) {
+		return;
+	}
+
+	graphics_context& context{m_renderer->context()};
+	const layer_type& info{*layer_it};
+
+	setup_context(context);
+	context.set_render_target(target);
+	setup_draw_call_state(context, info.transform.has_value() ? *info.transform : m_renderer->m_default_transform, info.blend_mode);
+	context.set_vertex_buffer(m_renderer->m_stream_buffer, 1, info.offset, sizeof(instance_type));
+	context.draw_instances(primitive::tri_fan, 0, 4, (info.*Instances).size());
+}
+
+template <typename Renderer, auto Instances> void tr::layered_instance_drawer<Renderer, Instances>::draw(const render_target& target)
+{
+	TR_ASSERT(m_renderer.has_ref(), "Tried to draw from a moved-from layered renderer drawer.");
+
+	if (m_range.empty()) {
+		return;
+	}
+
+	graphics_context& context{m_renderer->context()};
+
+	setup_context(context);
+	context.set_render_target(target);
+
+	for (const layer_type& layer : m_range) {
+		if ((layer.*Instances).empty()) {
+			continue;
+		}
+		setup_draw_call_state(context, layer.transform.has_value() ? *layer.transform : m_renderer->m_default_transform, layer.blend_mode);
+		context.set_vertex_buffer(m_renderer->m_stream_buffer, 1, layer.offset, sizeof(instance_type));
+		context.draw_instances(primitive::tri_fan, 0, 4, (layer.*Instances).size());
+	}
+}
+
+//
+
+template <typename Renderer, auto Instances> void tr::layered_instance_drawer<Renderer, Instances>::upload()
+{
+	const usize size{std::accumulate(m_range.begin(), m_range.end(), 0_uz,
+									 [](usize s, const layer_type& layer) { return s + (layer.*Instances).size(); })};
+	if (size == 0) {
+		return;
+	}
+
+	// The instances are written straight into the mapped stream buffer, and the offset of each layer is kept for drawing.
+	stream_buffer& stream{m_renderer->m_stream_buffer};
+	stream.begin_region(size * sizeof(instance_type));
+	usize offset{stream.allocate<instance_type>(size)};
+	for (layer_type& layer : m_range) {
+		layer.offset = offset;
+		std::ranges::copy(layer.*Instances, stream.mapped<instance_type>(offset, (layer.*Instances).size()).begin());
+		offset += (layer.*Instances).size() * sizeof(instance_type);
+	}
+}
+
+//
+
+template <typename Renderer, auto Instances>
+auto tr::layered_instance_drawer<Renderer, Instances>::first_nonempty(typename std::vector<layer_type>::iterator it) const
+	-> typename std::vector<layer_type>::iterator
+{
+	return std::find_if(it, m_range.end(), [](const layer_type& layer) { return !(layer.*Instances).empty(); });
+}
+
+template <typename Renderer, auto Instances> void tr::layered_instance_drawer<Renderer, Instances>::setup_context(graphics_context& context)
+{
+	if (context.should_setup_renderer(m_renderer->m_id)) {
+		context.set_face_culling(false);
+		context.set_depth_test(false);
+		context.set_shader_pipeline(m_renderer->m_pipeline);
+		context.set_blend_mode(m_renderer->m_last_blend_mode);
+		context.set_vertex_format(m_renderer->m_vertex_format);
+		context.set_vertex_buffer(m_renderer->m_quad_vertices, 0, 0);
+	}
+}
+
+template <typename Renderer, auto Instances>
+void tr::layered_instance_drawer<Renderer, Instances>::setup_draw_call_state(graphics_context& context, const glm::mat4& transform,
+																			 const blend_mode& blend_mode)
+{
+	if (m_renderer->m_last_transform != transform) {
+		m_renderer->m_last_transform = transform;
+		m_renderer->m_pipeline.vertex_shader().set_uniform(0, m_renderer->m_last_transform);
+	}
+
+	if (m_renderer->m_last_blend_mode != blend_mode) {
+		m_renderer->m_last_blend_mode = blend_mode;
+		context.set_blend_mode(m_renderer->m_last_blend_mode);
+	}
+}
+
+//
+
+template <typename Renderer, auto Instances> void tr::layered_instance_drawer<Renderer, Instances>::clean_up()
+{
+	if (m_renderer.has_ref()) {
+		if (first_nonempty(m_range.begin()) != m_range.end()) {
+			m_renderer->m_stream_buffer.fence();
+		}
+		// Layers are reset instead of erased to keep the storage of their instances.
+		for (layer_type& layer : m_range) {
+			layer.transform = std::nullopt;
+			layer.blend_mode = alpha_blending;
+			(layer.*Instances).clear();
+		}
+#ifdef TR_ENABLE_ASSERTS
+		// Layers outside of the drawn range keep their instances into the next frame, which then can't be compared to this one.
+		if (!std::ranges::all_of(m_renderer->m_layers, [](const layer_type& layer) { return (layer.*Instances).empty(); })) {
+			m_renderer->m_allocation_check.invalidate();
+		}
+		const bool steady{m_renderer->m_allocation_check.end_frame(m_renderer->m_allocations)};
+		TR_ASSERT(steady, "A layered renderer allocated storage while drawing the same workload as in the previous frame.");
+		m_renderer->m_locked = false;
+#endif
+	}
+}
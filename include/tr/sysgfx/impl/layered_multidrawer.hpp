@@ -33,12 +33,12 @@ namespace tr {
 	// Forwards a drawer.
 	template <layered_renderer_drawer Drawer> Drawer&& get_drawer(Drawer&& drawer)
 	{
-		return std::forward(drawer);
+		return std::forward<Drawer>(drawer);
 	}
 	// Forwards a drawer.
 	template <layered_renderer_drawer Drawer> Drawer&& get_drawer(Drawer&& drawer, int, int)
 	{
-		return std::forward(drawer);
+		return std::forward<Drawer>(drawer);
 	}
 
 	// Multidrawer deduction guide.
@@ -70,14 +70,18 @@ tr::layered_multidrawer<Drawers...>::layered_multidrawer(int min_layer, int max_
 template <tr::layered_renderer_drawer... Drawers>
 void tr::layered_multidrawer<Drawers...>::draw_layer(int layer, const render_target& target)
 {
-	std::apply([layer, &target](Drawers&... drawers) { (drawers.draw_layer(layer, target), ...); });
+	std::apply([layer, &target](Drawers&... drawers) { (drawers.draw_layer(layer, target), ...); }, m_drawers);
 }
 
 template <tr::layered_renderer_drawer... Drawers>
 void tr::layered_multidrawer<Drawers...>::draw_layer_range(int min_layer, int max_layer, const render_target& target)
 {
-	for (int layer = min_layer; layer <= max_layer; ++layer) {
+	// Merges the sorted sets of populated layers of the drawers, visiting only layers that are populated in at least one of them.
+	for (int layer = next_layer(min_layer); layer <= max_layer; layer = next_layer(layer + 1)) {
 		draw_layer(layer, target);
+		if (layer == INT_MAX) {
+			break;
+		}
 	}
 }
 
@@ -90,10 +94,15 @@ template <tr::layered_renderer_drawer... Drawers> void tr::layered_multidrawer<D
 
 template <tr::layered_renderer_drawer... Drawers> int tr::layered_multidrawer<Drawers...>::min_layer() const
 {
-	return std::apply([](const Drawers&... drawers) { return std::min({drawers.min_layer()...}); });
+	return std::apply([](const Drawers&... drawers) { return std::min({drawers.min_layer()...}); }, m_drawers);
 }
 
 template <tr::layered_renderer_drawer... Drawers> int tr::layered_multidrawer<Drawers...>::max_layer() const
 {
-	return std::apply([](const Drawers&... drawers) { return std::min({drawers.max_layer()...}); });
+	return std::apply([](const Drawers&... drawers) { return std::max({drawers.max_layer()...}); }, m_drawers);
+}
+
+template <tr::layered_renderer_drawer... Drawers> int tr::layered_multidrawer<Drawers...>::next_layer(int layer) const
+{
+	return std::apply([layer](const Drawers&... drawers) { return std::min({drawers.next_layer(layer)...}); }, m_drawers);
 }
\ No newline at end of file
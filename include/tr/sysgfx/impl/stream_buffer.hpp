@@ -0,0 +1,22 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements the templated parts of stream_buffer.hpp.                                                                                  //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../stream_buffer.hpp"
+
+////////////////////////////////////////////////////////////// STREAM BUFFER //////////////////////////////////////////////////////////////
+
+template <tr::standard_layout Element> tr::usize tr::stream_buffer::allocate(usize count)
+{
+	return allocate(count * sizeof(Element), alignof(Element));
+}
+
+template <tr::standard_layout Element> std::span<Element> tr::stream_buffer::mapped(usize offset, usize count) const
+{
+	TR_ASSERT(offset % alignof(Element) == 0, "Tried to get misaligned mapped span at offset {} of stream buffer '{}'.", offset, label());
+
+	return {reinterpret_cast<Element*>(mapped(offset, count * sizeof(Element)).data()), count};
+}
\ No newline at end of file
@@ -2,22 +2,26 @@
 //                                                                                                                                       //
 // Provides index buffer classes.                                                                                                        //
 //                                                                                                                                       //
-// Index buffers are an abstraction over OpenGL EBOs. tr does not currently support 32-bit indices.                                      //
+// Index buffers are an abstraction over OpenGL EBOs. Index buffers hold either 16-bit or 32-bit indices, which is decided on creation:  //
+//     - tr::index_size(tr::index_format::u32) -> 4                                                                                      //
 //                                                                                                                                       //
 // The index buffer comes in two variants: tr::static_index_buffer is initialized once and is immutable, while tr::dyn_index_buffer can  //
 // be resized and modified at will.                                                                                                      //
 //                                                                                                                                       //
-// Static index buffers are constructed with a span of data that will be copied into the buffer:                                         //
+// Static index buffers are constructed with a span of data that will be copied into the buffer, the format of which is deduced from the //
+// span's element type:                                                                                                                  //
 //     - tr::static_index_buffer buffer{context, data} -> copies 'data' into the buffer                                                  //
 //                                                                                                                                       //
-// Dynamic index buffers are constructed empty. Whether a buffer is empty can be checked with the .empty() method. Much like std::vector,//
-// dynamic index buffers distinguish between buffer size and capacity, both of which can be queried with the respective method.          //
-// The buffer automatically reallocates itself if its current capacity is insufficient, but the user can reserve a capacity in           //
+// Dynamic index buffers are constructed empty with 16-bit indices by default; 32-bit indices must be requested explicitly, and only     //
+// data of the matching type may then be passed to the buffer. Whether a buffer is empty can be checked with the .empty() method. Much   //
+// like std::vector, dynamic index buffers distinguish between buffer size and capacity, both of which can be queried with the respective//
+// method. The buffer automatically reallocates itself if its current capacity is insufficient, but the user can reserve a capacity in   //
 // advance with the .advance() method. Note that unlike std::vector, this clears any previous buffer data. The buffer can be resized     //
 // with .resize() or set to a copy of a span with .set(), which automatically sets its size to match that of the copied buffer.          //
 // The .set_region() method can be used to set a region of the buffer; this function never affects the size or capacity of the buffer.   //
 // The buffer can be cleared with the .clear() method, but like with std::vector, the allocated capacity is retained:                    //
 //     - tr::dyn_index_buffer buffer{context}; buffer.empty() -> true                                                                    //
+//     - tr::dyn_index_buffer buffer32{context, tr::index_format::u32}; buffer32.format() -> tr::index_format::u32                       //
 //     - buffer.reserve(100); buffer.resize(50) -> buffer now has size 50, capacity 128                                                  //
 //     - buffer.size(); buffer.capacity() -> 50, 128                                                                                     //
 //     - std::array<u16, 500> data; buffer.set(data) -> buffer now stores a copy of 'data', has size 500, capacity 512                   //
@@ -36,19 +40,32 @@
 //////////////////////////////////////////////////////////////// INTERFACE ////////////////////////////////////////////////////////////////
 
 namespace tr {
+	// Index formats.
+	enum class index_format : u32 {
+		u16 = 0x1403, // 16-bit unsigned indices.
+		u32 = 0x1405  // 32-bit unsigned indices.
+	};
+	// Gets the size of an index of a certain format in bytes.
+	constexpr usize index_size(index_format format);
+
 	// Concept defining a contiguous range that can be passed to index buffer functions.
 	template <typename Range>
-	concept index_range = typed_contiguous_const_range<Range, u16>;
+	concept index_range = typed_contiguous_const_range<Range, u16> || typed_contiguous_const_range<Range, u32>;
 
 	// Static index buffer class for holding immutable index data.
 	class static_index_buffer : private graphics_buffer {
 	  public:
-		// Uploads index data into a static index buffer.
+		// Uploads 16-bit index data into a static index buffer.
 		static_index_buffer(graphics_context& context, std::span<const u16> data);
+		// Uploads 32-bit index data into a static index buffer.
+		static_index_buffer(graphics_context& context, std::span<const u32> data);
 
 		// Gets a reference to the graphics context the buffer is on.
 		using graphics_buffer::context;
 
+		// Gets the format of the indices in the buffer.
+		index_format format() const;
+
 		// Gets the debug label of the index buffer.
 		using graphics_buffer::label;
 		// Sets the debug label of the index buffer.
@@ -57,6 +74,8 @@ namespace tr {
 	  private:
 		// The size of the buffer.
 		ssize m_size;
+		// The format of the indices in the buffer.
+		index_format m_format;
 
 		friend class graphics_context;
 	};
@@ -65,11 +84,13 @@ namespace tr {
 	class dyn_index_buffer : private graphics_buffer {
 	  public:
 		// Creates a dynamic index buffer.
-		using graphics_buffer::graphics_buffer;
+		dyn_index_buffer(graphics_context& context, index_format format = index_format::u16);
 
 		// Gets a reference to the graphics context the buffer is on.
 		using graphics_buffer::context;
 
+		// Gets the format of the indices in the buffer.
+		index_format format() const;
 		// Gets whether the index buffer is empty.
 		bool empty() const;
 		// Gets the size of the index buffer contents.
@@ -83,10 +104,14 @@ namespace tr {
 		void resize(usize size);
 		// Clears the buffer and guarantees a certain capacity for it.
 		void reserve(usize capacity);
-		// Sets the contents of the buffer, potentially reallocating in the process.
+		// Sets the contents of a 16-bit buffer, potentially reallocating in the process.
 		void set(std::span<const u16> data);
-		// Sets a region of the buffer.
+		// Sets the contents of a 32-bit buffer, potentially reallocating in the process.
+		void set(std::span<const u32> data);
+		// Sets a region of a 16-bit buffer.
 		void set_region(usize offset, std::span<const u16> data);
+		// Sets a region of a 32-bit buffer.
+		void set_region(usize offset, std::span<const u32> data);
 
 		// Gets the debug label of the index buffer.
 		using graphics_buffer::label;
@@ -94,6 +119,8 @@ namespace tr {
 		using graphics_buffer::set_label;
 
 	  private:
+		// The format of the indices in the buffer.
+		index_format m_format;
 		// The used size of the buffer.
 		usize m_size{0};
 		// The capacity of the buffer.
@@ -101,4 +128,6 @@ namespace tr {
 
 		friend class graphics_context;
 	};
-} // namespace tr
\ No newline at end of file
+} // namespace tr
+
+#include "impl/index_buffer.hpp" // IWYU pragma: export
\ No newline at end of file
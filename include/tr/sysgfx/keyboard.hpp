@@ -279,11 +279,11 @@ template <> inline constexpr bool tr::enable_default_binary_io<tr::scancode>{tru
 
 // Scan chord binary reader.
 template <> struct tr::binary_reader<tr::scan_chord> {
-	void operator()(std::istream& is, tr::scan_chord& out) const;
+	template <tr::binary_source Source> void operator()(Source& is, tr::scan_chord& out) const;
 };
 // Scan chord binary writer.
 template <> struct tr::binary_writer<tr::scan_chord> {
-	void operator()(std::ostream& os, const tr::scan_chord& in) const;
+	template <tr::binary_sink Sink> void operator()(Sink& os, const tr::scan_chord& in) const;
 };
 
 // Enables default binary IO for keycodes.
@@ -291,11 +291,11 @@ template <> inline constexpr bool tr::enable_default_binary_io<tr::keycode>{true
 
 // Key chord binary reader.
 template <> struct tr::binary_reader<tr::key_chord> {
-	void operator()(std::istream& is, tr::key_chord& out) const;
+	template <tr::binary_source Source> void operator()(Source& is, tr::key_chord& out) const;
 };
 // Key chord binary writer.
 template <> struct tr::binary_writer<tr::key_chord> {
-	void operator()(std::ostream& os, const tr::key_chord& in) const;
+	template <tr::binary_sink Sink> void operator()(Sink& os, const tr::key_chord& in) const;
 };
 
 #include "impl/keyboard.hpp" // IWYU pragma: export
\ No newline at end of file
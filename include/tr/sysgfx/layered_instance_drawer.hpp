@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides the drawer shared by layered renderers that draw each layer as a single instanced draw call.                                 //
+//                                                                                                                                       //
+// tr::layered_instance_drawer is the base of the drawers of such renderers (see circle_renderer.hpp or sprite_renderer.hpp). It is      //
+// parameterized on the renderer and on the member of its layers holding the instances to draw:                                          //
+//     - class my_renderer::drawer : public tr::layered_instance_drawer<my_renderer, &my_renderer::layer::instances> { ... }             //
+//                                                                                                                                       //
+// The renderer is expected to keep its layers sorted by priority in a vector, each layer having a transform (or std::nullopt for the    //
+// default transform), a blending mode, its instances, and the offset of its instances within the stream buffer while they are drawn.    //
+// The renderer must also befriend the drawer template, as the drawer accesses the shader pipeline, vertex format, quad vertices, stream //
+// buffer and cached state of the renderer directly.                                                                                     //
+//                                                                                                                                       //
+// The instances of every layer are written into the stream buffer of the renderer by .upload(), which derived drawers call once their   //
+// layers are ready (for example, after culling). Drawn layers are cleared, but not erased, when the drawer is destroyed.                //
+// The renderer counts its allocations in m_allocations and, in debug builds, feeds its workload to a tr::steady_allocation_check in     //
+// m_allocation_check, which is checked whenever a drawer is destroyed (unless layers outside of the drawn range still hold instances).  //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../utility/reference.hpp"
+#include "blending.hpp"
+#include "graphics_context.hpp"
+#include "render_target.hpp"
+#include "stream_buffer.hpp"
+
+//////////////////////////////////////////////////////////////// INTERFACE ////////////////////////////////////////////////////////////////
+
+namespace tr {
+	// Base of the drawers of layered renderers that draw each layer as a single instanced draw call.
+	template <typename Renderer, auto Instances> class layered_instance_drawer {
+	  public:
+		// Moves a drawer.
+		layered_instance_drawer(layered_instance_drawer&& r) noexcept;
+		// Cleans up the drawing data and unlocks the parent renderer.
+		~layered_instance_drawer();
+
+		// Moves a drawer.
+		layered_instance_drawer& operator=(layered_instance_drawer&& r) noexcept;
+
+		// Gets the minimum available layer for drawing.
+		int min_layer() const;
+		// Gets the maximum available layer for drawing.
+		int max_layer() const;
+		// Gets the first available layer greater than or equal to a layer (or INT_MAX if there is none).
+		int next_layer(int layer) const;
+
+		// Draws a single layer.
+		void draw_layer(int layer, const render_target& target);
+		// Draws everything.
+		void draw(const render_target& target);
+
+	  protected:
+		// The layer type of the renderer.
+		using layer_type = Renderer::layer;
+		// The type of the instances drawn by the renderer.
+		using instance_type = std::ranges::range_value_t<decltype(std::declval<layer_type&>().*Instances)>;
+
+		// Reference to the parent renderer.
+		opt_ref<Renderer> m_renderer;
+		// The range of layers to draw.
+		std::ranges::subrange<typename std::vector<layer_type>::iterator> m_range;
+
+		// Creates a drawer and locks the parent renderer.
+		layered_instance_drawer(Renderer& renderer, std::ranges::subrange<typename std::vector<layer_type>::iterator> range);
+
+		// Writes the instances of every layer into the stream buffer of the renderer.
+		void upload();
+
+	  private:
+		// Gets the first layer with instances at or after an iterator within the range.
+		typename std::vector<layer_type>::iterator first_nonempty(typename std::vector<layer_type>::iterator it) const;
+
+		// Sets up the graphical context for drawing.
+		void setup_context(graphics_context& context);
+		// Sets up the graphical context for a specific draw call.
+		void setup_draw_call_state(graphics_context& context, const glm::mat4& transform, const blend_mode& blend_mode);
+
+		// Cleans up the drawing data and unlocks the parent renderer.
+		void clean_up();
+	};
+} // namespace tr
+
+#include "impl/layered_instance_drawer.hpp" // IWYU pragma: export
@@ -5,6 +5,8 @@
 // A layered rendere drawer is an object that is capable of drawing individual graphical layers using .draw_layer(layer, target).        //
 // In addition, a drawer must provide .min_layer() and .max_layer() functions for querying the minimum and maximum available layers.     //
 // In case of no layers being available, it is recommended to return INT_MAX for .min_layer() and INT_MIN for .max_layer().              //
+// A drawer must also provide .next_layer(layer), which returns the first available layer greater than or equal to the given one (or     //
+// INT_MAX if there is none), so that only populated layers need to be visited.                                                          //
 // A drawer must treat calling .draw_layer(layer, target) for an unavailable layer as a no-op.                                           //
 //                                                                                                                                       //
 // A layered renderer is one that provides .create_drawer() members with and without an explicit layer range.                            //
@@ -23,6 +25,7 @@
 // A single layer, a subrange of layers, or the entire available range of layers may be drawn:                                           //
 //     - drawer.draw_layer(0, target) -> draws layer 0 on the basic renderer, then layer 0 on the circle renderer                        //
 //     - drawer.draw_layer_range(0, 5, target) -> draws layer 0 on the basic and circle renderers, then layer 1...                       //
+//       (layers that are empty in every drawer are skipped without being visited)                                                       //
 //     - drawer.draw(target) -> draws the entire available range of layers on the basic and circle renderers                             //
 //                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -38,6 +41,7 @@ namespace tr {
 	concept layered_renderer_drawer = requires(T drawer, const render_target& target) {
 		{ std::as_const(drawer).min_layer() } -> std::same_as<int>;
 		{ std::as_const(drawer).max_layer() } -> std::same_as<int>;
+		{ std::as_const(drawer).next_layer(0) } -> std::same_as<int>;
 		drawer.draw_layer(0, target);
 	};
 	// Concept denoting a layered renderer.
@@ -76,6 +80,8 @@ namespace tr {
 		int min_layer() const;
 		// Determines the maximum available layer.
 		int max_layer() const;
+		// Determines the first layer greater than or equal to a layer that is available in any drawer.
+		int next_layer(int layer) const;
 	};
 } // namespace tr
 
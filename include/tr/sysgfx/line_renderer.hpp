@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides a thick line renderer.                                                                                                       //
+//                                                                                                                                       //
+// The line renderer draws every line segment as a single instance, which is expanded into a quad by the vertex shader. Its edges, caps  //
+// and joins are shaded with a signed distance function in the fragment shader, which also anti-aliases them, so no geometry is ever     //
+// tessellated on the CPU. Much like the circle renderer, the line renderer is constructed with an initial render scale (by default      //
+// 1.0f) used to determine the ratio between logical pixels and physical pixels on the render target, which can be modified with         //
+// .set_render_scale() at any point afterwards:                                                                                          //
+//     - tr::line_renderer{context} -> creates a line renderer with render scale 1.0f                                                    //
+//     - tr::line_renderer line{context}; line.set_render_scale(2.0f) -> sets the render scale of the line renderer to 2.0f              //
+//                                                                                                                                       //
+// The line renderer is a layer-based renderer, compatible with the utilities provided in layered_drawing.hpp. Each layer has its own    //
+// transformation matrix (falls back to the global default if not provided) and blending mode (falls back to alpha blending if not       //
+// provided) that can be set. The global default transformation matrix can also be set:                                                  //
+//     - line.set_default_transform(tr::ortho(tr::rectangle<float>{{1000, 1000}})) -> sets the global transformation matrix              //
+//     - line.set_layer_transform(1, tr::ortho(tr::rectangle<float>{{500, 500}})) -> sets the transformation matrix for layer 1          //
+//     - line.set_layer_blend_mode(1, tr::premultiplied_alpha_blending) -> sets the blending mode for layer 1                            //
+//                                                                                                                                       //
+// Lines are appended to the drawing list of the line renderer either as single segments, as polylines, or as closed polygon outlines.   //
+// The ends of segments and polylines can be cut off flush (tr::line_cap::butt), extended by half of the width (tr::line_cap::square),   //
+// or rounded (tr::line_cap::round). The points where the segments of polylines and outlines meet are joined with round joins:           //
+//     - line.add_line(0, {{100, 100}, {200, 200}}, 5, "FFFFFF"_rgba8)                                                                   //
+//       -> adds a white line of width 5 from (100, 100) to (200, 200) to layer 0                                                        //
+//     - line.add_polyline(0, points, 2, "FF0000"_rgba8, tr::line_cap::round) -> adds a red polyline with rounded ends to layer 0        //
+//     - line.add_polygon_outline(0, points, 3, "00FF00"_rgba8) -> adds a green closed outline through 'points' to layer 0               //
+//                                                                                                                                       //
+// Each segment of a polyline only draws its side of the line splitting a join in half, so translucent polylines are not blended twice   //
+// at their joins. Segments that otherwise overlap (such as those of self-intersecting polylines) are still blended twice.               //
+//                                                                                                                                       //
+// Added lines are not drawn until a call to one of the drawing functions. Aside from supporting tr::layered_multidrawer, the line       //
+// renderer can be drawn alone. Segments are written directly into a persistently-mapped streaming buffer when a drawer is created,      //
+// after which every layer is drawn with a single instanced draw call. Drawn lines are erased from the renderer:                         //
+//     - line.draw(target) -> draws all layers to the target                                                                             //
+//                                                                                                                                       //
+// The storage of drawn layers is kept and reused by later lines, so a renderer drawing an unchanging workload stops allocating after    //
+// its first frame. The number of times storage had to be allocated can be gotten with .allocations():                                   //
+//     - line.allocations() -> gets the number of allocations made by the renderer so far                                                //
+// Debug builds assert that nothing is allocated when the same lines are added and every layer is drawn two frames in a row.             //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../utility/line.hpp"
+#include "../utility/reference.hpp"
+#include "../utility/steady_allocation_check.hpp"
+#include "blending.hpp"
+#include "graphics_context.hpp"
+#include "layered_instance_drawer.hpp"
+#include "render_target.hpp"
+#include "shader_pipeline.hpp"
+#include "stream_buffer.hpp"
+
+//////////////////////////////////////////////////////////////// INTERFACE ////////////////////////////////////////////////////////////////
+
+namespace tr {
+	// Line end cap styles.
+	enum class line_cap : u8 {
+		butt,   // The line ends flush with its endpoint.
+		square, // The line is extended past its endpoint by half of its width.
+		round   // The line ends with a semicircle centered on its endpoint.
+	};
+
+	// SDF-based thick line renderer.
+	class line_renderer {
+	  public:
+		// Drawer class to which the line renderer delegates the calling of draw commands.
+		class drawer;
+
+		// Initializes the line renderer.
+		line_renderer(graphics_context& context, float render_scale = 1.0f);
+
+		// Gets a reference to the graphics context the renderer is on.
+		graphics_context& context() const;
+
+		// Sets the render scale hint for the renderer.
+		void set_render_scale(float render_scale);
+		// Sets the default transformation matrix used by lines on any layer without its own default transform.
+		void set_default_transform(const glm::mat4& mat);
+		// Sets the transformation matrix used by lines on a layer.
+		void set_layer_transform(int layer, const glm::mat4& mat);
+		// Sets the blending mode used by lines on a layer.
+		void set_layer_blend_mode(int layer, const blend_mode& blend_mode);
+
+		// Adds a line segment to the renderer.
+		void add_line(int layer, const line_segment& line, float width, rgba8 color, line_cap cap = line_cap::butt);
+		// Adds a polyline to the renderer.
+		void add_polyline(int layer, std::span<const glm::vec2> points, float width, rgba8 color, line_cap cap = line_cap::butt);
+		// Adds a closed polygon outline to the renderer.
+		void add_polygon_outline(int layer, std::span<const glm::vec2> points, float width, rgba8 color);
+
+		// Gets the number of times the renderer had to allocate CPU-side storage.
+		usize allocations() const;
+
+		// Creates a drawer for all layers in a range. The renderer is "locked" and can't be interacted with while the drawer exists.
+		drawer create_drawer(int min_layer, int max_layer);
+		// Creates a drawer for all layers in the renderer. The renderer is "locked" and can't be interacted with while the drawer exists.
+		drawer create_drawer();
+		// Draws all added lines to a rendering target.
+		void draw(const render_target& target);
+
+	  private:
+		// Line segment information.
+		struct segment {
+			// The starting point of the segment.
+			glm::vec2 start;
+			// The ending point of the segment.
+			glm::vec2 end;
+			// The width of the segment.
+			float width;
+			// The color of the segment.
+			rgba8 color;
+			// The cap at the start of the segment in the lower 2 bits, and the cap at the end of the segment in the 2 bits above them.
+			u32 caps;
+			// The normal of the line splitting the join at the start of the segment (or zero if there is no join to split).
+			glm::vec2 start_join;
+			// The normal of the line splitting the join at the end of the segment (or zero if there is no join to split).
+			glm::vec2 end_join;
+
+			// Provided for tr::as_vertex_attribute_list.
+			static constexpr auto as_vertex_attribute_list{
+				tr::as_vertex_attribute_list<glm::vec2, glm::vec2, float, rgba8, u32, glm::vec2, glm::vec2>};
+		};
+		// Layer information.
+		struct layer {
+			// The drawing priority of the layer.
+			int priority;
+			// The transormation matrix of the layer (or empty for the global default).
+			std::optional<glm::mat4> transform;
+			// The blending mode of the layer.
+			blend_mode blend_mode{alpha_blending};
+			// The segments to draw on this layer.
+			std::vector<segment> segments;
+			// The offset of the segments of the layer within the stream buffer while they are being drawn (in bytes).
+			usize offset{0};
+		};
+
+		// The bindings of the line renderer vertex format.
+		static constexpr std::array vertex_format_bindings{make_vertex_binding<glm::u8vec2>(), make_vertex_binding<segment>(1)};
+
+		// The ID of the renderer.
+		renderer_id m_id;
+		// Global default transform.
+		glm::mat4 m_default_transform{1.0f};
+		// Drawing layers sorted by priority. Drawn layers are cleared instead of erased so that their storage can be reused.
+		std::vector<layer> m_layers;
+		// The number of times CPU-side storage had to be allocated.
+		usize m_allocations{0};
+		// The pipeline and shaders used by the renderer.
+		owning_shader_pipeline m_pipeline;
+		// The line renderer vertex format.
+		vertex_format m_vertex_format;
+		// Streaming buffer the segments are uploaded to.
+		stream_buffer m_stream_buffer;
+		// The vertices of the quad used to draw segments.
+		static_vertex_buffer<glm::u8vec2> m_quad_vertices;
+		// Last used transform.
+		glm::mat4 m_last_transform{1.0f};
+		// Last used blending mode.
+		blend_mode m_last_blend_mode{alpha_blending};
+#ifdef TR_ENABLE_ASSERTS
+		// Flag that is set to true when a staggered draw is ongoing.
+		bool m_locked{false};
+		// Checks that drawing the same workload as in the previous frame doesn't allocate.
+		steady_allocation_check m_allocation_check;
+#endif
+
+		// Gets a layer, creating it if it doesn't exist yet.
+		layer& get_layer(int layer);
+		// Adds the segments connecting a sequence of points to a layer.
+		void push_segments(int layer, std::span<const glm::vec2> points, bool closed, float width, rgba8 color, line_cap cap);
+
+		template <typename Renderer, auto Instances> friend class layered_instance_drawer;
+	};
+
+	// Drawer class to which the line renderer delegates the calling of draw commands.
+	class line_renderer::drawer : public layered_instance_drawer<line_renderer, &line_renderer::layer::segments> {
+	  private:
+		// Creates a drawer.
+		drawer(line_renderer& renderer, std::ranges::subrange<std::vector<layer>::iterator> range);
+
+		friend class line_renderer;
+	};
+} // namespace tr
\ No newline at end of file
@@ -55,5 +55,6 @@ namespace tr {
 		friend render_target backbuffer_render_target();
 		friend class render_texture;
 		friend class graphics_context;
+		friend class texture_readback;
 	};
 } // namespace tr
\ No newline at end of file
@@ -9,6 +9,8 @@
 //     - tr::load_vertex_shader(context, "source.vert") -> loads a vertex shader from a source file                                      //
 //     - tr::fragment_shader{context, src} -> constructs a fragment shader from an embedded source code string                           //
 //     - tr::load_fragment_shader(context, "source.frag") -> loads a fragment shader from a source file                                  //
+// Many shaders can also be compiled at once with a shader batch, see shader_batch.hpp.                                                  //
+// If the context's shader cache is enabled (see graphics_context.hpp), the program is loaded from its cached binary when possible.      //
 // Leaving shaders alive after their context is erroneous.                                                                               //
 //                                                                                                                                       //
 // Setting shader uniforms of any GLSL type except doubles is supported:                                                                 //
@@ -156,7 +158,7 @@ namespace tr {
 		// Sets a mat4x3 array uniform.
 		void set_uniform(int index, std::span<const glm::mat4x3> value);
 
-		// Sets a texture sampler uniform.
+		// Sets a texture sampler uniform (sampler2D, or sampler2DArray for texture arrays).
 		void set_uniform(int index, texture_ref texture);
 
 		// Sets a shader storage buffer.
@@ -201,13 +203,28 @@ namespace tr {
 			handle<unsigned int, UINT_MAX, deleter> m_id;
 		};
 
+		// The last value set to a uniform location.
+		struct uniform_value {
+			// The bytes of the value (large enough for the largest type that fits in one location, a mat4).
+			std::array<std::byte, sizeof(glm::mat4)> bytes;
+			// The size of the value in bytes, or 0 if the location was never set.
+			u8 size{0};
+		};
+
 		// Handle to the OpenGL program.
 		handle<unsigned int, 0, deleter> m_program;
 		// Texture units allocated to this shader.
 		boost::unordered_flat_map<int, texture_unit> m_texture_units;
+		// The last values set to each uniform location, indexed by location and used to elide redundant uniform updates.
+		std::vector<uniform_value> m_uniform_values;
 
 		// Constructs a shader.
 		shader_base(graphics_context& context, zstring_view source, unsigned int type);
+		// Constructs a shader from an already created program, taking ownership of it.
+		shader_base(graphics_context& context, unsigned int program);
+
+		// Records the value being set to a uniform spanning a number of locations and returns whether it differs from the last one.
+		bool update_uniform_value(int index, std::span<const std::byte> value, usize locations);
 
 		friend class shader_pipeline;
 
@@ -234,6 +251,12 @@ namespace tr {
 		// Creates a vertex shader from source code.
 		// May throw: shader_load_error.
 		explicit vertex_shader(graphics_context& context, zstring_view source);
+
+	  private:
+		// Creates a vertex shader from an already created program.
+		vertex_shader(graphics_context& context, unsigned int program);
+
+		friend class shader_batch;
 	};
 	// Loads a vertex shader from file.
 	// May throw: shader_load_error.
@@ -245,6 +268,12 @@ namespace tr {
 		// Creates a fragment shader from source code.
 		// May throw: shader_load_error.
 		explicit fragment_shader(graphics_context& context, zstring_view source);
+
+	  private:
+		// Creates a fragment shader from an already created program.
+		fragment_shader(graphics_context& context, unsigned int program);
+
+		friend class shader_batch;
 	};
 	// Loads a fragment shader from file.
 	// May throw: shader_load_error.
@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides a shader batch class for compiling many shaders at once.                                                                     //
+//                                                                                                                                       //
+// Constructing shaders directly compiles and links them one after another, and waits for each one to finish. A shader batch instead     //
+// submits the sources of all of its shaders up front, which lets drivers supporting GL_KHR_parallel_shader_compile compile them in      //
+// parallel on background threads while the application keeps running (drawing a loading screen, for example). Every shader added to     //
+// the batch gets an index that is later used to take the finished shader out of it:                                                     //
+//     - tr::shader_batch batch{context} -> creates an empty shader batch                                                                //
+//     - tr::usize vs{batch.add_vertex_shader(vshader_src)} -> submits a vertex shader for compilation                                   //
+//     - tr::usize fs{batch.add_fragment_shader(fshader_src)} -> submits a fragment shader for compilation                               //
+//                                                                                                                                       //
+// The progress of the batch can be polled without ever blocking. Without parallel compilation support, all shaders are considered to    //
+// be finished right away, and the wait for them happens when they are taken out of the batch instead:                                   //
+//     - batch.size() -> 2                                                                                                               //
+//     - batch.finished() -> the number of shaders that finished compiling                                                               //
+//     - batch.ready() -> true if all shaders finished compiling                                                                         //
+//                                                                                                                                       //
+// Shaders are only finalized and checked for errors when they are taken out of the batch, which waits for them to finish compiling if   //
+// they haven't yet. Each shader can only be taken out once:                                                                             //
+//     - tr::vertex_shader vshader{batch.take_vertex_shader(vs)} -> takes the vertex shader out of the batch                             //
+//     - tr::owning_shader_pipeline pipeline{batch.take_pipeline(vs, fs)} -> takes both shaders out of the batch as a pipeline           //
+//                                                                                                                                       //
+// Shaders in a batch go through the context's shader cache if it's enabled (see graphics_context.hpp), with cached shaders being        //
+// finished as soon as they are added to the batch.                                                                                      //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../utility/handle.hpp"
+#include "shader_pipeline.hpp"
+
+//////////////////////////////////////////////////////////////// INTERFACE ////////////////////////////////////////////////////////////////
+
+namespace tr {
+	// Batch of shaders compiled in parallel.
+	class shader_batch {
+	  public:
+		// Creates an empty shader batch.
+		shader_batch(graphics_context& context);
+
+		// Gets a reference to the graphics context the batch is on.
+		graphics_context& context() const;
+
+		// Submits a vertex shader for compilation and returns its index in the batch.
+		usize add_vertex_shader(std::string source);
+		// Submits a fragment shader for compilation and returns its index in the batch.
+		usize add_fragment_shader(std::string source);
+
+		// Gets the number of shaders in the batch.
+		usize size() const;
+		// Gets the number of shaders that finished compiling (never blocks).
+		usize finished() const;
+		// Gets whether all shaders in the batch finished compiling (never blocks).
+		bool ready() const;
+
+		// Takes a vertex shader out of the batch, waiting for it to finish compiling if necessary.
+		// May throw: shader_load_error.
+		vertex_shader take_vertex_shader(usize index);
+		// Takes a fragment shader out of the batch, waiting for it to finish compiling if necessary.
+		// May throw: shader_load_error.
+		fragment_shader take_fragment_shader(usize index);
+		// Takes a vertex and fragment shader out of the batch and combines them into a pipeline.
+		// May throw: shader_load_error.
+		owning_shader_pipeline take_pipeline(usize vshader, usize fshader);
+
+	  private:
+		// Shader program deleter.
+		struct deleter {
+			// Reference to the graphics context the batch is on.
+			graphics_context& context;
+
+			void operator()(unsigned int id) const;
+		};
+		// Handle to a shader program in the batch.
+		using program_handle = handle<unsigned int, 0, deleter>;
+		// A shader submitted to the batch.
+		struct entry {
+			// Handle to the program (empty once the shader was taken out of the batch).
+			program_handle program;
+			// The type of the shader.
+			unsigned int type;
+			// The source code of the shader (kept to store the program into the shader cache once it's finished).
+			std::string source;
+			// Whether the program was loaded from the shader cache.
+			bool cached;
+			// Whether the program is known to have finished compiling.
+			mutable bool finished;
+		};
+
+		// Reference to the graphics context the batch is on.
+		graphics_context& m_context;
+		// The shaders submitted to the batch.
+		std::vector<entry> m_entries;
+		// The number of shaders known to have finished compiling.
+		mutable usize m_finished{0};
+
+		// Submits a shader for compilation and returns its index in the batch.
+		usize add_shader(unsigned int type, std::string&& source);
+		// Finalizes a shader and releases its program out of the batch.
+		unsigned int take_program(usize index, unsigned int type);
+	};
+} // namespace tr
\ No newline at end of file
@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides an instanced sprite renderer.                                                                                                //
+//                                                                                                                                       //
+// The sprite renderer draws textured, rotated and tinted quads. Each sprite is uploaded as a single compact 32-byte instance            //
+// (tr::sprite), which is expanded into a quad by the vertex shader. Sprites sample one of the renderer's texture slots, which can be    //
+// set at any point outside of drawing:                                                                                                  //
+//     - tr::sprite_renderer sprite{context} -> creates an empty sprite renderer                                                         //
+//     - sprite.set_texture(0, tex) -> sprites using texture slot 0 now sample 'tex'                                                     //
+//                                                                                                                                       //
+// The sprite renderer is a layer-based renderer, compatible with the utilities provided in layered_drawing.hpp. Each layer has its own  //
+// transformation matrix (falls back to the global default if not provided) and blending mode (falls back to alpha blending if not       //
+// provided) that can be set. The global default transformation matrix can also be set:                                                  //
+//     - sprite.set_default_transform(tr::ortho(tr::rectangle<float>{{1000, 1000}})) -> sets the global transformation matrix            //
+//     - sprite.set_layer_transform(1, tr::ortho(tr::rectangle<float>{{500, 500}})) -> sets the transformation matrix for layer 1        //
+//     - sprite.set_layer_blend_mode(1, tr::premultiplied_alpha_blending) -> sets the blending mode for layer 1                          //
+//                                                                                                                                       //
+// Sprites are appended to the drawing list of the sprite renderer either one-by-one, or as spans of already packed instances, which are //
+// copied as-is. Sprites with the tr::sprite::untextured texture slot are drawn with only their tint:                                    //
+//     - sprite.add_sprite(0, {500, 500}, {64, 64}, 45_deg, {{0, 0}, {0.5f, 0.5f}}, "FFFFFF"_rgba8, 0)                                   //
+//       -> adds a 64x64 sprite centered at (500, 500), rotated by 45 degrees and using the top-left quarter of texture slot 0 to layer 0//
+//     - sprite.add_sprites(1, sprites) -> copies the packed sprites in 'sprites' to layer 1                                             //
+//                                                                                                                                       //
+// Added sprites are not drawn until a call to one of the drawing functions. Aside from supporting tr::layered_multidrawer, the sprite   //
+// renderer can be drawn alone. Sprites are written directly into a persistently-mapped streaming buffer when a drawer is created, after //
+// which every layer is drawn with a single instanced draw call. Drawn sprites are erased from the renderer:                             //
+//     - sprite.draw(target) -> draws all layers to the target                                                                           //
+//                                                                                                                                       //
+// The storage of drawn layers is kept and reused by later sprites, so a renderer drawing an unchanging workload stops allocating after  //
+// its first frame. The number of times storage had to be allocated can be gotten with .allocations():                                   //
+//     - sprite.allocations() -> gets the number of allocations made by the renderer so far                                              //
+// Debug builds assert that nothing is allocated when the same sprites are added and every layer is drawn two frames in a row.           //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../utility/angle.hpp"
+#include "../utility/rectangle.hpp"
+#include "../utility/reference.hpp"
+#include "../utility/steady_allocation_check.hpp"
+#include "blending.hpp"
+#include "graphics_context.hpp"
+#include "layered_instance_drawer.hpp"
+#include "render_target.hpp"
+#include "shader_pipeline.hpp"
+#include "stream_buffer.hpp"
+#include "texture_ref.hpp"
+
+//////////////////////////////////////////////////////////////// INTERFACE ////////////////////////////////////////////////////////////////
+
+namespace tr {
+	// Sprite instance drawn by the sprite renderer.
+	struct sprite {
+		// The position of the center of the sprite.
+		glm::vec2 position;
+		// The size of the sprite.
+		glm::vec2 size;
+		// The UV rectangle of the sprite as normalized integers (top-left corner, then bottom-right corner).
+		glm::u16vec4 uvs;
+		// The tint of the sprite.
+		rgba8 tint;
+		// The rotation of the sprite around its center as a normalized fraction of a full turn.
+		u16 rotation;
+		// The texture slot sampled by the sprite.
+		u16 texture_slot;
+
+		// Texture slot of sprites drawn with only their tint.
+		static constexpr u16 untextured{UINT16_MAX};
+		// Provided for tr::as_vertex_attribute_list.
+		static constexpr auto as_vertex_attribute_list{
+			tr::as_vertex_attribute_list<glm::vec2, glm::vec2, normalized<glm::u16vec4>, rgba8, normalized<u16>, u16>};
+	};
+
+	// Instanced sprite renderer.
+	class sprite_renderer {
+	  public:
+		// Drawer class to which the sprite renderer delegates the calling of draw commands.
+		class drawer;
+
+		// The number of texture slots of the renderer.
+		static constexpr int texture_slots{8};
+
+		// Initializes the sprite renderer.
+		sprite_renderer(graphics_context& context);
+
+		// Gets a reference to the graphics context the renderer is on.
+		graphics_context& context() const;
+
+		// Sets the texture sampled by sprites using a texture slot.
+		void set_texture(int slot, texture_ref texture);
+		// Sets the default transformation matrix used by sprites on any layer without its own default transform.
+		void set_default_transform(const glm::mat4& mat);
+		// Sets the transformation matrix used by sprites on a layer.
+		void set_layer_transform(int layer, const glm::mat4& mat);
+		// Sets the blending mode used by sprites on a layer.
+		void set_layer_blend_mode(int layer, const blend_mode& blend_mode);
+
+		// Adds a sprite to the renderer.
+		void add_sprite(int layer, glm::vec2 position, glm::vec2 size, angle rotation, const rectangle<float>& uvs, rgba8 tint,
+						u16 texture_slot);
+		// Adds a packed sprite to the renderer.
+		void add_sprite(int layer, const sprite& sprite);
+		// Adds a span of packed sprites to the renderer.
+		void add_sprites(int layer, std::span<const sprite> sprites);
+
+		// Gets the number of times the renderer had to allocate CPU-side storage.
+		usize allocations() const;
+
+		// Creates a drawer for all layers in a range. The renderer is "locked" and can't be interacted with while the drawer exists.
+		drawer create_drawer(int min_layer, int max_layer);
+		// Creates a drawer for all layers in the renderer. The renderer is "locked" and can't be interacted with while the drawer exists.
+		drawer create_drawer();
+		// Draws all added sprites to a rendering target.
+		void draw(const render_target& target);
+
+	  private:
+		// Layer information.
+		struct layer {
+			// The drawing priority of the layer.
+			int priority;
+			// The transormation matrix of the layer (or empty for the global default).
+			std::optional<glm::mat4> transform;
+			// The blending mode of the layer.
+			blend_mode blend_mode{alpha_blending};
+			// The sprites to draw on this layer.
+			std::vector<sprite> sprites;
+			// The offset of the sprites of the layer within the stream buffer while they are being drawn (in bytes).
+			usize offset{0};
+		};
+
+		// The bindings of the sprite renderer vertex format.
+		static constexpr std::array vertex_format_bindings{make_vertex_binding<glm::u8vec2>(), make_vertex_binding<sprite>(1)};
+
+		// The ID of the renderer.
+		renderer_id m_id;
+		// Global default transform.
+		glm::mat4 m_default_transform{1.0f};
+		// Drawing layers sorted by priority. Drawn layers are cleared instead of erased so that their storage can be reused.
+		std::vector<layer> m_layers;
+		// The number of times CPU-side storage had to be allocated.
+		usize m_allocations{0};
+		// The pipeline and shaders used by the renderer.
+		owning_shader_pipeline m_pipeline;
+		// The sprite renderer vertex format.
+		vertex_format m_vertex_format;
+		// Streaming buffer the sprites are uploaded to.
+		stream_buffer m_stream_buffer;
+		// The vertices of the quad used to draw sprites.
+		static_vertex_buffer<glm::u8vec2> m_quad_vertices;
+		// Last used transform.
+		glm::mat4 m_last_transform{1.0f};
+		// Last used blending mode.
+		blend_mode m_last_blend_mode{alpha_blending};
+#ifdef TR_ENABLE_ASSERTS
+		// Flag that is set to true when a staggered draw is ongoing.
+		bool m_locked{false};
+		// Checks that drawing the same workload as in the previous frame doesn't allocate.
+		steady_allocation_check m_allocation_check;
+#endif
+
+		// Gets a layer, creating it if it doesn't exist yet.
+		layer& get_layer(int layer);
+
+		template <typename Renderer, auto Instances> friend class layered_instance_drawer;
+	};
+
+	// Drawer class to which the sprite renderer delegates the calling of draw commands.
+	class sprite_renderer::drawer : public layered_instance_drawer<sprite_renderer, &sprite_renderer::layer::sprites> {
+	  private:
+		// Creates a drawer.
+		drawer(sprite_renderer& renderer, std::ranges::subrange<std::vector<layer>::iterator> range);
+
+		friend class sprite_renderer;
+	};
+} // namespace tr
\ No newline at end of file
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides a persistently-mapped streaming buffer class.                                                                                //
+//                                                                                                                                       //
+// Stream buffers are an abstraction over an OpenGL buffer that is persistently and coherently mapped for the entirety of its lifetime,  //
+// and are meant for data that is rewritten every frame (vertex and index data of batched renderers, for example). The buffer is split   //
+// into a ring of equally-sized regions, each protected by a fence, so that the CPU can write into one region while the GPU is still     //
+// reading from the others without any driver-side copies or implicit synchronization. The number of regions can be set on creation:     //
+//     - tr::stream_buffer buffer{context} -> creates an empty stream buffer with 3 regions                                              //
+//     - tr::stream_buffer buffer{context, 2} -> creates an empty stream buffer with 2 regions                                           //
+//                                                                                                                                       //
+// Writing into the buffer is started with .begin_region(), which moves on to the next region of the ring (waiting for the GPU to finish //
+// using it if necessary) and guarantees a minimum capacity for it. If the capacity of the regions is insufficient, the buffer is        //
+// reallocated. Space is then allocated within the region with .allocate(), and the allocated data can be accessed with .mapped().       //
+// Once all commands reading from the region were issued, .fence() must be called to place a fence after them; .begin_region()           //
+// automatically fences the previous region if this was not done:                                                                        //
+//     - buffer.begin_region(1024) -> the current region now has a capacity of at least 1024 bytes                                       //
+//     - buffer.region_capacity() -> 1024                                                                                                //
+//     - tr::usize offset{buffer.allocate<glm::vec2>(4)} -> allocates space for 4 vec2s and returns its offset in the buffer             //
+//     - std::ranges::copy(data, buffer.mapped<glm::vec2>(offset, 4).begin()) -> copies 'data' into the allocated space                  //
+//     - buffer.region_size() -> 32                                                                                                      //
+//     - buffer.fence() -> fences the current region                                                                                     //
+//                                                                                                                                       //
+// The label of a stream buffer can be set with .set_label() and gotten with .label():                                                   //
+//     - buffer.set_label("Example buffer"); buffer.label() -> "Example buffer"                                                          //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../utility/concepts.hpp"
+#include "graphics_buffer.hpp"
+
+//////////////////////////////////////////////////////////////// INTERFACE ////////////////////////////////////////////////////////////////
+
+namespace tr {
+	// Persistently-mapped buffer split into a ring of fenced regions.
+	class stream_buffer : private graphics_buffer {
+	  public:
+		// The default number of regions in a stream buffer.
+		static constexpr usize default_regions{3};
+
+		// Creates an empty stream buffer.
+		stream_buffer(graphics_context& context, usize regions = default_regions);
+
+		// Gets a reference to the graphics context the buffer is on.
+		using graphics_buffer::context;
+
+		// Gets the capacity of a region of the buffer.
+		usize region_capacity() const;
+		// Gets the used size of the current region.
+		usize region_size() const;
+
+		// Moves on to the next region, waiting for the GPU to stop using it and guaranteeing a certain capacity for it.
+		void begin_region(usize capacity);
+		// Allocates space in the current region and returns its offset within the buffer.
+		usize allocate(usize size, usize alignment);
+		// Allocates space for a number of elements in the current region and returns its offset within the buffer.
+		template <standard_layout Element> usize allocate(usize count);
+		// Gets a mapped span of the buffer.
+		std::span<std::byte> mapped(usize offset, usize size) const;
+		// Gets a mapped span of elements in the buffer.
+		template <standard_layout Element> std::span<Element> mapped(usize offset, usize count) const;
+		// Places a fence after all commands issued so far, protecting the current region until they are finished.
+		void fence();
+
+		// Gets the debug label of the stream buffer.
+		using graphics_buffer::label;
+		// Sets the debug label of the stream buffer.
+		using graphics_buffer::set_label;
+
+	  private:
+		// Fence deleter.
+		struct fence_deleter {
+			// Reference to the context the fence is on.
+			graphics_context& context;
+
+			void operator()(void* fence) const;
+		};
+		// Handle to a fence protecting a region.
+		using fence_handle = handle<void*, nullptr, fence_deleter>;
+
+		// Pointer to the mapped buffer data.
+		std::byte* m_map{nullptr};
+		// The capacity of a single region.
+		usize m_region_capacity{0};
+		// The index of the current region.
+		usize m_region{0};
+		// The used size of the current region.
+		usize m_region_size{0};
+		// The fences protecting each region.
+		std::vector<fence_handle> m_fences;
+
+		// Waits for the fence protecting a region to be signaled.
+		void wait_for_region(usize region);
+
+		friend class graphics_context;
+		friend class texture_uploader;
+	};
+} // namespace tr
+
+#include "impl/stream_buffer.hpp" // IWYU pragma: export
\ No newline at end of file
@@ -0,0 +1,250 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides a glyph-atlas-based text renderer.                                                                                           //
+//                                                                                                                                       //
+// Unlike tr::ttfont::render, which rasterizes whole strings into a new bitmap, the text renderer rasterizes individual glyphs once and  //
+// caches them per (font, size, glyph) in a dynamic atlas. Strings are laid out from cached glyph metrics and kerning, and every glyph   //
+// is drawn as a single instance expanded into a quad by the vertex shader, so changing text never causes rasterization or texture       //
+// reallocation once its glyphs are cached. Fonts are owned by the text renderer and referred to by the index returned when adding them: //
+//     - tr::text_renderer text{context} -> creates a text renderer with no fonts                                                        //
+//     - tr::usize font{text.add_font(tr::load_ttfont_file("font.ttf"))} -> adds a font to the text renderer                             //
+//                                                                                                                                       //
+// The text renderer is a layer-based renderer, compatible with the utilities provided in layered_drawing.hpp. Each layer has its own    //
+// transformation matrix (falls back to the global default if not provided) and blending mode (falls back to alpha blending if not       //
+// provided) that can be set. The global default transformation matrix can also be set:                                                  //
+//     - text.set_default_transform(tr::ortho(tr::rectangle<float>{{1000, 1000}})) -> sets the global transformation matrix              //
+//     - text.set_layer_transform(1, tr::ortho(tr::rectangle<float>{{500, 500}})) -> sets the transformation matrix for layer 1          //
+//     - text.set_layer_blend_mode(1, tr::premultiplied_alpha_blending) -> sets the blending mode for layer 1                            //
+//                                                                                                                                       //
+// Text is appended to the drawing list of the text renderer one string at a time, either in a single color or as a sequence of          //
+// differently-colored spans. Strings are split into lines the same way as with tr::split_into_lines, and lines can additionally be      //
+// broken like with tr::break_overlong_lines if a maximum width is given. Lines are aligned within the maximum width, or within the      //
+// widest line if the width is unlimited:                                                                                                //
+//     - text.add_text(0, {100, 100}, font, 24, "Score: 100", "FFFFFF"_rgba8)                                                            //
+//       -> adds white 24-point text with its top-left corner at (100, 100) to layer 0                                                   //
+//     - text.add_text(0, {100, 200}, font, 16, std::array{tr::text_span{"HP: ", "FFFFFF"_rgba8}, tr::text_span{"50", "FF0000"_rgba8}})  //
+//       -> adds 16-point text where "HP: " is white and "50" is red to layer 0                                                          //
+//     - text.add_text(0, {100, 300}, font, 16, long_text, "FFFFFF"_rgba8, 200, tr::halign::center)                                      //
+//       -> adds centered text broken into lines no wider than 200 to layer 0                                                            //
+//                                                                                                                                       //
+// Added text is not drawn until a call to one of the drawing functions. Aside from supporting tr::layered_multidrawer, the text         //
+// renderer can be drawn alone. Glyphs are written directly into a persistently-mapped streaming buffer when a drawer is created, after  //
+// which every layer is drawn with a single instanced draw call. Drawn text is erased from the renderer:                                 //
+//     - text.draw(target) -> draws all layers to the target                                                                             //
+//                                                                                                                                       //
+// The glyph cache only ever grows, though it can be cleared when no text is waiting to be drawn. The storage of drawn layers is kept    //
+// and reused by later text, so a renderer drawing an unchanging workload stops allocating after its first frame:                        //
+//     - text.cached_glyphs() -> gets the number of glyphs in the glyph cache                                                            //
+//     - text.clear_glyph_cache() -> clears the glyph cache                                                                              //
+//     - text.allocations() -> gets the number of allocations made by the renderer so far                                                //
+// Debug builds assert that nothing is allocated when the same text is added and every layer is drawn two frames in a row (adding a      //
+// font or clearing the glyph cache in between skips the check).                                                                         //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../utility/alignment.hpp"
+#include "../utility/reference.hpp"
+#include "../utility/steady_allocation_check.hpp"
+#include "../utility/utf8.hpp"
+#include "atlas.hpp"
+#include "blending.hpp"
+#include "graphics_context.hpp"
+#include "layered_instance_drawer.hpp"
+#include "render_target.hpp"
+#include "shader_pipeline.hpp"
+#include "stream_buffer.hpp"
+#include "ttfont.hpp"
+
+//////////////////////////////////////////////////////////////// INTERFACE ////////////////////////////////////////////////////////////////
+
+namespace tr {
+	// A span of text drawn in a single color.
+	struct text_span {
+		// The text of the span.
+		std::string_view text;
+		// The color of the span.
+		rgba8 color;
+	};
+
+	// Glyph-atlas-based text renderer.
+	class text_renderer {
+	  public:
+		// Drawer class to which the text renderer delegates the calling of draw commands.
+		class drawer;
+
+		// Initializes the text renderer.
+		text_renderer(graphics_context& context);
+
+		// Gets a reference to the graphics context the renderer is on.
+		graphics_context& context() const;
+
+		// Adds a font to the renderer and returns its index.
+		usize add_font(ttfont&& font);
+
+		// Sets the default transformation matrix used by text on any layer without its own default transform.
+		void set_default_transform(const glm::mat4& mat);
+		// Sets the transformation matrix used by text on a layer.
+		void set_layer_transform(int layer, const glm::mat4& mat);
+		// Sets the blending mode used by text on a layer.
+		void set_layer_blend_mode(int layer, const blend_mode& blend_mode);
+
+		// Adds a string of text in a single color to the renderer.
+		// May throw: ttfont_error, ttfont_render_error.
+		void add_text(int layer, glm::vec2 pos, usize font, float size, std::string_view text, rgba8 color, int max_w = unlimited_width,
+					  halign align = halign::left);
+		// Adds a string of text made up of colored spans to the renderer.
+		// May throw: ttfont_error, ttfont_render_error.
+		void add_text(int layer, glm::vec2 pos, usize font, float size, std::span<const text_span> spans, int max_w = unlimited_width,
+					  halign align = halign::left);
+
+		// Gets the number of glyphs in the glyph cache.
+		usize cached_glyphs() const;
+		// Clears the glyph cache. There must not be any text waiting to be drawn.
+		void clear_glyph_cache();
+
+		// Gets the number of times the renderer had to allocate CPU-side storage.
+		usize allocations() const;
+
+		// Creates a drawer for all layers in a range. The renderer is "locked" and can't be interacted with while the drawer exists.
+		drawer create_drawer(int min_layer, int max_layer);
+		// Creates a drawer for all layers in the renderer. The renderer is "locked" and can't be interacted with while the drawer exists.
+		drawer create_drawer();
+		// Draws all added text to a rendering target.
+		void draw(const render_target& target);
+
+	  private:
+		// Glyph instance information.
+		struct glyph {
+			// The position of the top-left corner of the glyph.
+			glm::vec2 position;
+			// The rectangle of the glyph in the atlas in pixels (top-left corner, then size).
+			glm::u16vec4 atlas_rect;
+			// The color of the glyph.
+			rgba8 color;
+
+			// Provided for tr::as_vertex_attribute_list.
+			static constexpr auto as_vertex_attribute_list{tr::as_vertex_attribute_list<glm::vec2, glm::u16vec4, rgba8>};
+		};
+		// Layer information.
+		struct layer {
+			// The drawing priority of the layer.
+			int priority;
+			// The transormation matrix of the layer (or empty for the global default).
+			std::optional<glm::mat4> transform;
+			// The blending mode of the layer.
+			blend_mode blend_mode{alpha_blending};
+			// The glyphs to draw on this layer.
+			std::vector<glyph> glyphs;
+			// The offset of the glyphs of the layer within the stream buffer while they are being drawn (in bytes).
+			usize offset{0};
+		};
+		// A font owned by the renderer.
+		struct font_entry {
+			// The font.
+			ttfont font;
+			// The size the font is currently set to.
+			float size;
+		};
+		// Key of a cached glyph.
+		struct glyph_key {
+			// The index of the font of the glyph.
+			usize font;
+			// The size of the glyph.
+			float size;
+			// The codepoint of the glyph.
+			codepoint cp;
+
+			friend bool operator==(const glyph_key& l, const glyph_key& r) = default;
+		};
+		// Glyph key hasher.
+		struct glyph_key_hash {
+			usize operator()(const glyph_key& key) const;
+		};
+		// Key of a cached kerning value.
+		struct kerning_key {
+			// The index of the font of the glyphs.
+			usize font;
+			// The size of the glyphs.
+			float size;
+			// The codepoint of the first glyph.
+			codepoint prev;
+			// The codepoint of the second glyph.
+			codepoint next;
+
+			friend bool operator==(const kerning_key& l, const kerning_key& r) = default;
+		};
+		// Kerning key hasher.
+		struct kerning_key_hash {
+			usize operator()(const kerning_key& key) const;
+		};
+
+		// The initial size of the glyph atlas.
+		static constexpr glm::ivec2 initial_atlas_size{256, 256};
+		// The bindings of the text renderer vertex format.
+		static constexpr std::array vertex_format_bindings{make_vertex_binding<glm::u8vec2>(), make_vertex_binding<glyph>(1)};
+
+		// The ID of the renderer.
+		renderer_id m_id;
+		// Global default transform.
+		glm::mat4 m_default_transform{1.0f};
+		// The fonts owned by the renderer.
+		std::vector<font_entry> m_fonts;
+		// The atlas holding the bitmaps of cached glyphs.
+		dyn_atlas<glyph_key, rectangle<u16>, glyph_key_hash> m_atlas;
+		// The advances of cached glyphs (including glyphs without a bitmap, like spaces).
+		boost::unordered_flat_map<glyph_key, int, glyph_key_hash> m_advances;
+		// Cached kerning values.
+		boost::unordered_flat_map<kerning_key, int, kerning_key_hash> m_kerning;
+		// Drawing layers sorted by priority. Drawn layers are cleared instead of erased so that their storage can be reused.
+		std::vector<layer> m_layers;
+		// Scratch storage for the joined text of the spans being added, kept between calls.
+		std::string m_text_scratch;
+		// Scratch storage for the end offsets of the spans being added within the joined text, kept between calls.
+		std::vector<usize> m_span_ends;
+		// Scratch storage for the lines being added, kept between calls.
+		std::vector<std::string_view> m_lines;
+		// Scratch storage for the widths of the lines being added, kept between calls.
+		std::vector<int> m_line_widths;
+		// The number of times CPU-side storage had to be allocated.
+		usize m_allocations{0};
+		// The pipeline and shaders used by the renderer.
+		owning_shader_pipeline m_pipeline;
+		// The text renderer vertex format.
+		vertex_format m_vertex_format;
+		// Streaming buffer the glyphs are uploaded to.
+		stream_buffer m_stream_buffer;
+		// The vertices of the quad used to draw glyphs.
+		static_vertex_buffer<glm::u8vec2> m_quad_vertices;
+		// Last used transform.
+		glm::mat4 m_last_transform{1.0f};
+		// Last used blending mode.
+		blend_mode m_last_blend_mode{alpha_blending};
+#ifdef TR_ENABLE_ASSERTS
+		// Flag that is set to true when a staggered draw is ongoing.
+		bool m_locked{false};
+		// Checks that drawing the same workload as in the previous frame doesn't allocate.
+		steady_allocation_check m_allocation_check;
+#endif
+
+		// Gets a layer, creating it if it doesn't exist yet.
+		layer& get_layer(int layer);
+		// Gets the advance of a glyph of a font at its current size, caching the glyph if it isn't cached yet.
+		int cache_glyph(usize font, codepoint cp);
+		// Gets the kerning between two glyphs of a font at its current size, caching it if it isn't cached yet.
+		int cached_kerning(usize font, codepoint prev, codepoint next);
+		// Gets the width of a line of text in a font at its current size.
+		int line_width(usize font, std::string_view line);
+
+		template <typename Renderer, auto Instances> friend class layered_instance_drawer;
+	};
+
+	// Drawer class to which the text renderer delegates the calling of draw commands.
+	class text_renderer::drawer : public layered_instance_drawer<text_renderer, &text_renderer::layer::glyphs> {
+	  private:
+		// Creates a drawer.
+		drawer(text_renderer& renderer, std::ranges::subrange<std::vector<layer>::iterator> range);
+
+		friend class text_renderer;
+	};
+} // namespace tr
\ No newline at end of file
@@ -21,6 +21,10 @@
 //     - tr::texture tex{}; tex.empty() -> true                                                                                          //
 //     - tr::texture tex{{512, 512}}; tex.size() -> {512, 512}                                                                           //
 //                                                                                                                                       //
+// Textures also have a version that changes whenever their contents or sampling parameters are modified, which can be used to tell if   //
+// data derived from a texture is out of date. Render textures have no version, since drawing to them doesn't go through the texture:    //
+//     - tr::texture tex{bmp}; const auto v{tex.version()}; tex.clear("000000"_rgba8); tex.version() != v -> true                        //
+//                                                                                                                                       //
 // The filtering, wrapping, and border color attribtes of textures may be set:                                                           //
 //     - tex.set_filtering(tr::min_filter::linear, tr::mag_filter::linear) -> 'tex' uses linear filtering                                //
 //     - tex.set_wrap(tr::wrap::border_clamp) -> the border color is used for out-of-bounds UVs of 'tex'                                 //
@@ -32,18 +36,55 @@
 //     - tex.copy_region({256, 256}, tex2, {{256, 256}, {256, 256}}) -> copies a region of 'tex2' to 'tex' beginning at (256, 256)       //
 //     - tex.set_region({128, 128}, tr::load_bitmap_file("data.bmp")) -> sets a region of 'tex' beginning at (128, 128) with bitmap data //
 //                                                                                                                                       //
+// Modifying a mipmapped texture doesn't immediately regenerate its mipmaps, but only marks them as out of date: they are regenerated    //
+// once, right before the next draw call, no matter how many times the texture was modified before it. Textures created with             //
+// tr::mipmaps::disabled never have mipmaps generated for them.                                                                          //
+//                                                                                                                                       //
 // The label of a texture can be set with .set_label() and gotten with .label():                                                         //
 //     - tex.set_label("Example texture"); tex.label() -> "Example texture"                                                              //
 //                                                                                                                                       //
+// Texture arrays are collections of equally-sized 2D textures stored in the layers of a single GPU texture, and are sampled in shaders  //
+// as sampler2DArray. They are allocated uninitialized, either with an explicit format or with the storage format and filtering of a     //
+// prototype texture:                                                                                                                    //
+//     - tr::texture_array arr{context, {64, 64}, 16}                                                                                    //
+//       -> creates an uninitialized array of 16 64x64 RGBA32 layers                                                                     //
+//     - tr::texture_array arr{tex, {64, 64}, 16}                                                                                        //
+//       -> creates an uninitialized array of 16 64x64 layers using the format and filtering of 'tex'                                    //
+//                                                                                                                                       //
+// Layer regions can be cleared, set from a bitmap, or copied from a regular texture, each of which changes the version of the array.    //
+// Copying requires the texture to be compatible with the array, meaning it has the same storage format and filtering, fits into a       //
+// layer, and would be sampled the same way from a layer (clamped to its edge and without mipmaps):                                      //
+//     - arr.clear_layer(0, "FFFFFF"_rgba8) -> clears layer 0 of 'arr' to white                                                          //
+//     - arr.set_layer_region(1, {0, 0}, bmp) -> sets a region of layer 1 beginning at (0, 0) with bitmap data                           //
+//     - tr::texture_array::layerable(tex) -> true if 'tex' is clamped to its edge and not sampled with mipmaps                          //
+//     - arr.compatible(tex) -> true if 'tex' can be copied into the layers of 'arr'                                                     //
+//     - arr.copy_to_layer(2, {0, 0}, tex, {{}, tex.size()}) -> copies 'tex' into layer 2                                                //
+//                                                                                                                                       //
+// Setting texture regions directly makes the driver synchronize on the bitmap's memory. A texture uploader instead copies the bitmap    //
+// into persistently-mapped staging memory (see stream_buffer.hpp), from which the GPU copies it into the texture asynchronously. The    //
+// staging memory is split into fenced regions of at least the staging capacity, which are only reused once the GPU is done with them:   //
+//     - tr::texture_uploader uploader{context} -> creates an uploader with the default staging capacity                                 //
+//     - uploader.set_region(tex, {128, 128}, bmp) -> queues an upload of 'bmp' into 'tex' beginning at (128, 128)                       //
+//     - uploader.set_layer_region(arr, 1, {0, 0}, bmp) -> queues an upload of 'bmp' into layer 1 of 'arr'                               //
+//                                                                                                                                       //
+// Pixel data can be read back from textures or render targets asynchronously. The readback is issued into a pixel buffer on             //
+// construction, and can be polled on later frames; getting the data before the readback is finished waits for it:                       //
+//     - tr::texture_readback readback{tex, {{0, 0}, {64, 64}}} -> starts reading back a 64x64 region of 'tex' as RGBA32                 //
+//     - tr::texture_readback screenshot{context, context.backbuffer()} -> starts reading back the entire backbuffer                     //
+//     - if (screenshot.ready()) { tr::bitmap bmp{screenshot.get()}; } -> gets the screenshot as a bitmap once it's finished             //
+//                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
+#include "../utility/intrusive_list.hpp"
 #include "../utility/reference.hpp"
 #include "bitmap.hpp"
+#include "stream_buffer.hpp"
 
 namespace tr {
 	class graphics_context;
 	class texture;
+	class texture_array;
 	class texture_ref;
 	class render_target;
 } // namespace tr
@@ -114,6 +155,9 @@ namespace tr {
 		bool empty() const;
 		// Gets the size of the texture.
 		glm::ivec2 size() const;
+		// Gets the version of the texture, which changes whenever its contents or sampling parameters are modified (or std::nullopt for
+		// render textures, which are modified by drawing to them).
+		std::optional<u64> version() const;
 
 		// Reallocates the texture and releases the previously held storage as a new texture.
 		texture reallocate(glm::ivec2 size, mipmaps mipmaps = mipmaps::disabled, pixel_format format = pixel_format::rgba32);
@@ -146,13 +190,27 @@ namespace tr {
 		unsigned int m_handle;
 		// The cached size of the texture.
 		glm::ivec2 m_size;
-		// List of active references to this texture.
-		mutable std::vector<ref<texture_ref>> m_references;
+		// Whether the texture has mipmaps.
+		bool m_mipmapped{false};
+		// Whether the texture can be drawn to, which modifies it without its version changing.
+		bool m_renderable{false};
+		// The version of the texture.
+		u64 m_version;
+		// The active references to this texture.
+		mutable intrusive_list<texture_ref> m_references;
 
 		// Creates a released texture.
-		texture(graphics_context& context, unsigned int handle, glm::ivec2 size);
+		texture(graphics_context& context, unsigned int handle, glm::ivec2 size, bool mipmapped);
+		// Unbinds all active references to this texture.
+		void unbind_references();
 
+		// Marks the contents of the texture as modified, changing its version and marking its mipmaps as out of date.
+		void mark_modified();
+
+		friend class texture_array;
+		friend class texture_readback;
 		friend class texture_ref;
+		friend class texture_uploader;
 		friend class shader_base;
 		friend class graphics_context;
 
@@ -160,4 +218,139 @@ namespace tr {
 		friend ImTextureID ImGui::GetTextureID(const texture& texture);
 #endif
 	};
+
+	// Array of equally-sized 2D textures living on the GPU.
+	class texture_array : private texture {
+	  public:
+		// Allocates an uninitialized texture array.
+		texture_array(graphics_context& context, glm::ivec2 size, int layers, pixel_format format = pixel_format::rgba32);
+		// Allocates an uninitialized texture array with the same storage format and filtering as a texture.
+		texture_array(const texture& prototype, glm::ivec2 size, int layers);
+		// Moves a texture array, updating all references pointing to it.
+		texture_array(texture_array&& r) noexcept = default;
+
+		// Moves a texture array, updating all references pointing to it.
+		texture_array& operator=(texture_array&& r) noexcept = default;
+
+		// Gets a reference to the graphics context the texture array is on.
+		using texture::context;
+
+		// Gets a reference to the texture array.
+		operator texture_ref() const;
+
+		// Gets whether the texture array is empty.
+		using texture::empty;
+		// Gets the size of a layer of the texture array.
+		using texture::size;
+		// Gets the number of layers in the texture array.
+		int layers() const;
+		// Gets whether a texture would be sampled the same way from a layer as on its own (clamped to its edge and without mipmaps).
+		static bool layerable(const texture& texture);
+		// Gets whether a texture is layerable, has the same storage format and filtering as the array, and fits into a layer.
+		bool compatible(const texture& texture) const;
+
+		// Sets the filters used by the texture sampler.
+		using texture::set_filtering;
+		// Sets the wrapping used for by the texture sampler.
+		using texture::set_wrap;
+		// Sets the border color of the texture sampler (used when wrap::BORDER_CLAMP is in use).
+		using texture::set_border_color;
+
+		// Clears a layer of the texture array.
+		void clear_layer(int layer, const rgbaf& color);
+		// Copies a region from a compatible texture into a layer.
+		void copy_to_layer(int layer, glm::ivec2 tl, const texture& src, const rectangle<int>& region);
+		// Sets a region of a layer.
+		void set_layer_region(int layer, glm::ivec2 tl, const sub_bitmap& bitmap);
+
+		// Gets the debug label of the texture array.
+		using texture::label;
+		// Sets the debug label of the texture array.
+		using texture::set_label;
+
+	  private:
+		// The number of layers in the array.
+		int m_layers;
+
+		// Allocates the storage of the array.
+		void allocate(unsigned int internal_format);
+
+		friend class texture_uploader;
+	};
+
+	// Queue of texture uploads staged through persistently-mapped pixel buffer memory.
+	class texture_uploader {
+	  public:
+		// The default capacity of a region of staging memory.
+		static constexpr usize default_staging_capacity{4 * 1024 * 1024};
+
+		// Creates a texture uploader.
+		texture_uploader(graphics_context& context, usize staging_capacity = default_staging_capacity);
+
+		// Gets a reference to the graphics context the uploader is on.
+		graphics_context& context() const;
+
+		// Gets the capacity of a region of staging memory.
+		usize staging_capacity() const;
+
+		// Stages bitmap data and queues a copy of it into a region of a texture.
+		void set_region(texture& texture, glm::ivec2 tl, const sub_bitmap& bitmap);
+		// Stages bitmap data and queues a copy of it into a region of a layer of a texture array.
+		void set_layer_region(texture_array& array, int layer, glm::ivec2 tl, const sub_bitmap& bitmap);
+
+	  private:
+		// The staging memory the GPU copies pixel data from.
+		stream_buffer m_staging;
+		// The minimum capacity of a region of staging memory.
+		usize m_staging_capacity;
+
+		// Copies tightly packed bitmap data into staging memory and returns its offset within the staging buffer.
+		usize stage(const sub_bitmap& bitmap);
+	};
+
+	// Pending asynchronous readback of pixel data from the GPU.
+	class texture_readback {
+	  public:
+		// Starts reading back a region of a texture.
+		texture_readback(const texture& texture, const rectangle<int>& region, pixel_format format = pixel_format::rgba32);
+		// Starts reading back the viewport of a render target.
+		texture_readback(graphics_context& context, const render_target& target, pixel_format format = pixel_format::rgba32);
+
+		// Gets a reference to the graphics context the readback is on.
+		graphics_context& context() const;
+
+		// Gets the size of the read back region.
+		glm::ivec2 size() const;
+		// Gets whether the readback finished (never blocks).
+		bool ready() const;
+		// Gets the read back pixel data, waiting for the readback to finish if necessary.
+		bitmap get() const;
+
+	  private:
+		// Fence deleter.
+		struct fence_deleter {
+			// Reference to the context the fence is on.
+			graphics_context& context;
+
+			void operator()(void* fence) const;
+		};
+		// Handle to the fence placed after the readback.
+		using fence_handle = handle<void*, nullptr, fence_deleter>;
+
+		// The pixel buffer the data is read back into.
+		graphics_buffer m_buffer;
+		// The fence placed after the readback.
+		fence_handle m_fence;
+		// The size of the read back region.
+		glm::ivec2 m_size;
+		// The format of the read back data.
+		pixel_format m_format;
+		// Whether the rows were read back bottom-to-top (as is the case with render targets).
+		bool m_flipped;
+		// Whether the fence was already found to be signaled.
+		mutable bool m_ready{false};
+
+		// Allocates the pixel buffer.
+		void allocate_buffer();
+	};
 } // namespace tr
\ No newline at end of file
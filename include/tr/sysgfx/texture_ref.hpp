@@ -10,9 +10,13 @@
 //       std::swap(tex1, tex2)                                                                                                           //
 //       -> ref now points to tex2                                                                                                       //
 //                                                                                                                                       //
+// Textures keep track of their references in an intrusive linked list, so creating, moving and destroying references takes constant     //
+// time no matter how many other references to the same texture exist.                                                                   //
+//                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
+#include "../utility/intrusive_list.hpp"
 #include "../utility/reference.hpp"
 
 namespace tr {
@@ -23,7 +27,7 @@ namespace tr {
 
 namespace tr {
 	// Smart texture reference (updated on texture moves and updates, emptied on deletion).
-	class texture_ref {
+	class texture_ref : intrusive_list_node<texture_ref> {
 	  public:
 		// Creates an empty reference.
 		constexpr texture_ref() = default;
@@ -52,7 +56,7 @@ namespace tr {
 		texture_ref& operator=(texture_ref&& r) noexcept;
 
 		// Compares references for equality.
-		friend bool operator==(const texture_ref& l, const texture_ref& r) = default;
+		friend bool operator==(const texture_ref& l, const texture_ref& r);
 
 		// Dereferences the texture.
 		const texture& operator*() const;
@@ -71,6 +75,7 @@ namespace tr {
 		// Rebinds the reference.
 		void rebind(const texture& texture);
 
+		friend class intrusive_list<texture_ref>;
 		friend class texture;
 #ifdef TR_HAS_IMGUI
 		friend ImTextureID ImGui::GetTextureID(const texture_ref& texture);
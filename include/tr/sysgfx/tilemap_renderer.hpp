@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides a chunked tilemap renderer.                                                                                                  //
+//                                                                                                                                       //
+// The tilemap renderer keeps a grid of tiles resident on the GPU, so that it doesn't have to be rebuilt every frame. The map is split   //
+// into square chunks of tilemap_renderer::chunk_size tiles, and only chunks containing tiles that changed since the previous draw are   //
+// re-uploaded. The tilemap renderer is constructed with the size of the map in tiles and the size of a single tile, with the top-left   //
+// corner of the map at the origin:                                                                                                      //
+//     - tr::tilemap_renderer tilemap{context, {4096, 4096}, {16, 16}} -> creates an empty 4096x4096 map of 16x16 tiles                  //
+//                                                                                                                                       //
+// Tiles are indices into a tileset: a texture split into a grid of equally-sized tiles, numbered left-to-right, then top-to-bottom.     //
+// Nearest filtering is recommended for the tileset to prevent neighbouring tiles from bleeding into each other. Tiles can be set and    //
+// gotten individually, with tilemap_renderer::empty_tile marking tiles that aren't drawn:                                               //
+//     - tilemap.set_tileset(tileset, {16, 8}) -> sets the tileset to a texture containing 16x8 tiles                                    //
+//     - tilemap.set_tile({10, 20}, 5) -> sets the tile at (10, 20) to the 6th tile of the tileset                                       //
+//     - tilemap.tile({10, 20}) -> 5                                                                                                     //
+//     - tilemap.clear() -> sets every tile to tr::tilemap_renderer::empty_tile                                                          //
+//                                                                                                                                       //
+// The transformation matrix and blending mode (alpha blending by default) of the tilemap renderer can be set:                           //
+//     - tilemap.set_transform(tr::ortho(tr::rectangle<float>{camera_pos, {1000, 1000}})) -> sets the transformation matrix              //
+//     - tilemap.set_blend_mode(tr::premultiplied_alpha_blending) -> sets the blending mode                                              //
+//                                                                                                                                       //
+// When drawing, chunks lying entirely outside of the render target (according to the transformation matrix) and chunks without any      //
+// tiles are skipped, and every remaining chunk is drawn with a single instanced draw call. The number of chunks uploaded and drawn by   //
+// the latest draw can be queried:                                                                                                       //
+//     - tilemap.draw(target) -> uploads changed chunks and draws the visible part of the map to the target                              //
+//     - tilemap.uploaded_chunks() -> gets the number of chunks uploaded by the latest draw                                              //
+//     - tilemap.drawn_chunks() -> gets the number of chunks drawn by the latest draw                                                    //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "blending.hpp"
+#include "graphics_context.hpp"
+#include "render_target.hpp"
+#include "shader_pipeline.hpp"
+#include "texture_ref.hpp"
+
+//////////////////////////////////////////////////////////////// INTERFACE ////////////////////////////////////////////////////////////////
+
+namespace tr {
+	// Chunked tilemap renderer.
+	class tilemap_renderer {
+	  public:
+		// The width and height of a chunk in tiles.
+		static constexpr int chunk_size{32};
+		// The number of tiles in a chunk.
+		static constexpr usize chunk_tiles{chunk_size * chunk_size};
+		// Sentinel for a tile that isn't drawn.
+		static constexpr u16 empty_tile{UINT16_MAX};
+
+		// Initializes an empty tilemap renderer.
+		tilemap_renderer(graphics_context& context, glm::ivec2 size, glm::vec2 tile_size);
+
+		// Gets a reference to the graphics context the renderer is on.
+		graphics_context& context() const;
+
+		// Gets the size of the map in tiles.
+		glm::ivec2 size() const;
+		// Gets the size of a tile.
+		glm::vec2 tile_size() const;
+		// Gets a tile.
+		u16 tile(glm::ivec2 pos) const;
+
+		// Sets a tile.
+		void set_tile(glm::ivec2 pos, u16 tile);
+		// Sets every tile to be empty.
+		void clear();
+		// Sets the tileset texture and the number of tiles in it along each axis.
+		void set_tileset(texture_ref texture, glm::ivec2 tiles);
+		// Sets the transformation matrix used by the map.
+		void set_transform(const glm::mat4& mat);
+		// Sets the blending mode used by the map.
+		void set_blend_mode(const blend_mode& blend_mode);
+
+		// Gets the number of chunks uploaded by the latest draw.
+		usize uploaded_chunks() const;
+		// Gets the number of chunks drawn by the latest draw.
+		usize drawn_chunks() const;
+
+		// Uploads the changed chunks and draws the visible part of the map to a rendering target.
+		void draw(const render_target& target);
+
+	  private:
+		// The bindings of the tilemap renderer vertex format.
+		static constexpr std::array vertex_format_bindings{make_vertex_binding<glm::u8vec2>(), make_vertex_binding<u16>(1)};
+
+		// The ID of the renderer.
+		renderer_id m_id;
+		// The size of the map in tiles.
+		glm::ivec2 m_size;
+		// The size of the map in chunks.
+		glm::ivec2 m_chunks;
+		// The size of a tile.
+		glm::vec2 m_tile_size;
+		// The transformation matrix of the map.
+		glm::mat4 m_transform{1.0f};
+		// The blending mode of the map.
+		blend_mode m_blend_mode{alpha_blending};
+		// Whether a tileset was set.
+		bool m_has_tileset{false};
+		// The tiles of the map, stored chunk by chunk so that every chunk is contiguous.
+		std::vector<u16> m_tiles;
+		// The number of non-empty tiles in each chunk.
+		std::vector<u16> m_chunk_tile_counts;
+		// Whether each chunk was changed since the previous draw.
+		std::vector<bool> m_dirty;
+		// The indices of the chunks that were changed since the previous draw.
+		std::vector<usize> m_dirty_chunks;
+		// The number of chunks uploaded by the latest draw.
+		usize m_uploaded_chunks{0};
+		// The number of chunks drawn by the latest draw.
+		usize m_drawn_chunks{0};
+		// The pipeline and shaders used by the renderer.
+		owning_shader_pipeline m_pipeline;
+		// The tilemap renderer vertex format.
+		vertex_format m_vertex_format;
+		// The vertices of the quad used to draw tiles.
+		static_vertex_buffer<glm::u8vec2> m_quad_vertices;
+		// The GPU copy of the tiles of the map, laid out like the CPU-side copy.
+		dyn_vertex_buffer<u16> m_tile_buffer;
+
+		// Gets the index of a tile within the chunk-by-chunk tile storage.
+		usize tile_index(glm::ivec2 pos) const;
+		// Uploads the chunks changed since the previous draw.
+		void upload_dirty_chunks();
+	};
+} // namespace tr
\ No newline at end of file
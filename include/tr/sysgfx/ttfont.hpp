@@ -210,6 +210,8 @@ namespace tr {
 
 	// Splits a string view into a list of lines.
 	std::vector<std::string_view> split_into_lines(std::string_view str);
+	// Splits a string view into lines, appending them to an existing list (which allows its storage to be reused).
+	void split_into_lines(std::string_view str, std::vector<std::string_view>& lines);
 	// Splits a vector of lines, breaking overlong lines according to the font's current size, style, and outline.
 	std::vector<std::string_view> break_overlong_lines(std::vector<std::string_view>&& lines, const ttfont& font, int max_w);
 	// Splits a string view into a list of lines, breaking overlong lines according to the font's current size, style, and outline.
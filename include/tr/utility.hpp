@@ -5,48 +5,50 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
-#include "utility/alignment.hpp"        // IWYU pragma: export
-#include "utility/angle.hpp"            // IWYU pragma: export
-#include "utility/atlas_packer.hpp"     // IWYU pragma: export
-#include "utility/benchmark.hpp"        // IWYU pragma: export
-#include "utility/binary_io.hpp"        // IWYU pragma: export
-#include "utility/chrono.hpp"           // IWYU pragma: export
-#include "utility/circle.hpp"           // IWYU pragma: export
-#include "utility/color.hpp"            // IWYU pragma: export
-#include "utility/concepts.hpp"         // IWYU pragma: export
-#include "utility/defer.hpp"            // IWYU pragma: export
-#include "utility/draw_geometry.hpp"    // IWYU pragma: export
-#include "utility/encryption.hpp"       // IWYU pragma: export
-#include "utility/enum.hpp"             // IWYU pragma: export
-#include "utility/exception.hpp"        // IWYU pragma: export
-#include "utility/handle.hpp"           // IWYU pragma: export
-#include "utility/hash_map.hpp"         // IWYU pragma: export
-#include "utility/integer.hpp"          // IWYU pragma: export
-#include "utility/iostream.hpp"         // IWYU pragma: export
-#include "utility/iterator.hpp"         // IWYU pragma: export
-#include "utility/line.hpp"             // IWYU pragma: export
-#include "utility/localization_map.hpp" // IWYU pragma: export
-#include "utility/logger.hpp"           // IWYU pragma: export
-#include "utility/macro.hpp"            // IWYU pragma: export
-#include "utility/math.hpp"             // IWYU pragma: export
-#include "utility/matrix.hpp"           // IWYU pragma: export
-#include "utility/mstream.hpp"          // IWYU pragma: export
-#include "utility/norm_cast.hpp"        // IWYU pragma: export
-#include "utility/optional.hpp"         // IWYU pragma: export
-#include "utility/polygon.hpp"          // IWYU pragma: export
-#include "utility/print.hpp"            // IWYU pragma: export
-#include "utility/ranges.hpp"           // IWYU pragma: export
-#include "utility/rectangle.hpp"        // IWYU pragma: export
-#include "utility/rectangle_edges.hpp"  // IWYU pragma: export
-#include "utility/reference.hpp"        // IWYU pragma: export
-#include "utility/rng.hpp"              // IWYU pragma: export
-#include "utility/static_string.hpp"    // IWYU pragma: export
-#include "utility/static_vector.hpp"    // IWYU pragma: export
-#include "utility/stopwatch.hpp"        // IWYU pragma: export
-#include "utility/template.hpp"         // IWYU pragma: export
-#include "utility/timer.hpp"            // IWYU pragma: export
-#include "utility/triangle.hpp"         // IWYU pragma: export
-#include "utility/utf8.hpp"             // IWYU pragma: export
-#include "utility/variant.hpp"          // IWYU pragma: export
-#include "utility/vector.hpp"           // IWYU pragma: export
-#include "utility/zstring_view.hpp"     // IWYU pragma: export
\ No newline at end of file
+#include "utility/alignment.hpp"               // IWYU pragma: export
+#include "utility/angle.hpp"                   // IWYU pragma: export
+#include "utility/atlas_packer.hpp"            // IWYU pragma: export
+#include "utility/benchmark.hpp"               // IWYU pragma: export
+#include "utility/binary_io.hpp"               // IWYU pragma: export
+#include "utility/chrono.hpp"                  // IWYU pragma: export
+#include "utility/circle.hpp"                  // IWYU pragma: export
+#include "utility/color.hpp"                   // IWYU pragma: export
+#include "utility/concepts.hpp"                // IWYU pragma: export
+#include "utility/defer.hpp"                   // IWYU pragma: export
+#include "utility/draw_geometry.hpp"           // IWYU pragma: export
+#include "utility/encryption.hpp"              // IWYU pragma: export
+#include "utility/enum.hpp"                    // IWYU pragma: export
+#include "utility/exception.hpp"               // IWYU pragma: export
+#include "utility/handle.hpp"                  // IWYU pragma: export
+#include "utility/hash_map.hpp"                // IWYU pragma: export
+#include "utility/integer.hpp"                 // IWYU pragma: export
+#include "utility/intrusive_list.hpp"          // IWYU pragma: export
+#include "utility/iostream.hpp"                // IWYU pragma: export
+#include "utility/iterator.hpp"                // IWYU pragma: export
+#include "utility/line.hpp"                    // IWYU pragma: export
+#include "utility/localization_map.hpp"        // IWYU pragma: export
+#include "utility/logger.hpp"                  // IWYU pragma: export
+#include "utility/macro.hpp"                   // IWYU pragma: export
+#include "utility/math.hpp"                    // IWYU pragma: export
+#include "utility/matrix.hpp"                  // IWYU pragma: export
+#include "utility/mstream.hpp"                 // IWYU pragma: export
+#include "utility/norm_cast.hpp"               // IWYU pragma: export
+#include "utility/optional.hpp"                // IWYU pragma: export
+#include "utility/polygon.hpp"                 // IWYU pragma: export
+#include "utility/print.hpp"                   // IWYU pragma: export
+#include "utility/ranges.hpp"                  // IWYU pragma: export
+#include "utility/rectangle.hpp"               // IWYU pragma: export
+#include "utility/rectangle_edges.hpp"         // IWYU pragma: export
+#include "utility/reference.hpp"               // IWYU pragma: export
+#include "utility/rng.hpp"                     // IWYU pragma: export
+#include "utility/static_string.hpp"           // IWYU pragma: export
+#include "utility/static_vector.hpp"           // IWYU pragma: export
+#include "utility/steady_allocation_check.hpp" // IWYU pragma: export
+#include "utility/stopwatch.hpp"               // IWYU pragma: export
+#include "utility/template.hpp"                // IWYU pragma: export
+#include "utility/timer.hpp"                   // IWYU pragma: export
+#include "utility/triangle.hpp"                // IWYU pragma: export
+#include "utility/utf8.hpp"                    // IWYU pragma: export
+#include "utility/variant.hpp"                 // IWYU pragma: export
+#include "utility/vector.hpp"                  // IWYU pragma: export
+#include "utility/zstring_view.hpp"            // IWYU pragma: export
\ No newline at end of file
@@ -18,9 +18,19 @@
 // Binary data can be written to an output stream using tr::write_binary:                                                                //
 //     - tr::write_binary(os, 50, 1.0f) -> writes the bytes of integer value '50' and float '1.0f' to 'os'                               //
 //                                                                                                                                       //
+// Besides streams, binary data can be read from a span of bytes with tr::binary_span_reader, and written to a span of bytes with        //
+// tr::binary_span_writer or to a growable tr::binary_buffer. These skip the overhead of streams entirely: every read or write is a      //
+// single bounds check followed by a memcpy, and reading or writing past the end of a span throws an exception instead of setting a      //
+// stream state:                                                                                                                         //
+//     - tr::binary_span_reader reader{bytes}; tr::read_binary<int>(reader) -> reads an integer value from the start of 'bytes'          //
+//     - tr::binary_buffer buffer; tr::write_binary(buffer, 50, 1.0f); buffer.bytes() -> span over the 8 written bytes                   //
+//     - std::array<std::byte, 2> out; tr::binary_span_writer writer{out}; tr::write_binary(writer, 50) -> throws tr::custom_exception   //
+//                                                                                                                                       //
 // To enable binary reading and/or writing for a custom type, the structs tr::binary_reader and tr::binary_writer respectively must be   //
 // specialized, tr::binary_reader with operator()(std::istream&, T&) and tr::binary_writer with operator()(std::ostream&, const T&).     //
-// Most primitives and standard library containers, as well as some tr types have specialized readers and writers.                       //
+// To also support span readers and writers, operator() can instead be a template over a tr::binary_source or a tr::binary_sink.         //
+// Most primitives and standard library containers, as well as some tr types have specialized readers and writers for all sources and    //
+// sinks.                                                                                                                                //
 // tr::enable_default_binary_io may be specialized to true for the simplest case (read/write the bytes of an object directly):           //
 //     - template <> inline constexpr bool tr::enable_default_binary_io<my_int>{true};                                                   //
 //       -> enables binary reading and writing of class my_int, writer directly reads from the bytes of a my_int object                  //
@@ -42,55 +52,166 @@
 //////////////////////////////////////////////////////////////// INTERFACE ////////////////////////////////////////////////////////////////
 
 namespace tr {
+	// Binary data reader over a span of bytes.
+	class binary_span_reader {
+	  public:
+		// Constructs a reader over a span of bytes.
+		explicit binary_span_reader(std::span<const std::byte> data);
+
+		// Gets the number of bytes read so far.
+		usize position() const;
+		// Gets the number of bytes left to read.
+		usize remaining() const;
+		// Gets the bytes left to read.
+		std::span<const std::byte> remaining_bytes() const;
+
+		// Reads raw bytes (throws if there aren't enough bytes left).
+		void read(char* out, usize size);
+		// Skips over bytes (throws if there aren't enough bytes left).
+		void skip(usize size);
+		// Checks that there are enough bytes left to read (throws if there aren't).
+		void require(usize size) const;
+
+	  private:
+		// The span being read from.
+		std::span<const std::byte> m_data;
+		// The number of bytes read so far.
+		usize m_position{0};
+
+		// Throws an exception about reading past the end of the span.
+		[[noreturn]] void throw_overrun(usize size) const;
+	};
+	// Binary data writer over a span of bytes.
+	class binary_span_writer {
+	  public:
+		// Constructs a writer over a span of bytes.
+		explicit binary_span_writer(std::span<std::byte> data);
+
+		// Gets the number of bytes written so far.
+		usize position() const;
+		// Gets the number of bytes that can still be written.
+		usize remaining() const;
+		// Gets the bytes written so far.
+		std::span<std::byte> written_bytes() const;
+
+		// Writes raw bytes (throws if there isn't enough space left).
+		void write(const char* in, usize size);
+
+	  private:
+		// The span being written to.
+		std::span<std::byte> m_data;
+		// The number of bytes written so far.
+		usize m_position{0};
+
+		// Throws an exception about writing past the end of the span.
+		[[noreturn]] void throw_overrun(usize size) const;
+	};
+	// Growable byte buffer binary data can be written to.
+	class binary_buffer {
+	  public:
+		// Constructs an empty buffer.
+		binary_buffer() = default;
+		// Constructs an empty buffer with reserved capacity.
+		explicit binary_buffer(usize capacity);
+
+		// Gets the number of bytes in the buffer.
+		usize size() const;
+		// Gets the bytes in the buffer.
+		std::span<const std::byte> bytes() const;
+
+		// Reserves capacity in the buffer.
+		void reserve(usize capacity);
+		// Clears the buffer, keeping its capacity.
+		void clear();
+		// Moves the bytes out of the buffer, leaving it empty.
+		std::vector<std::byte> release();
+
+		// Appends raw bytes to the buffer.
+		void write(const char* in, usize size);
+
+	  private:
+		// The bytes in the buffer.
+		std::vector<std::byte> m_bytes;
+	};
+
 	// Interface for custom readers for use in read_binary.
 	template <cv_unqualified_object Out> struct binary_reader;
 	// Interface for custom writers for use in write_binary.
 	template <cv_unqualified_object In> struct binary_writer;
 
+	// Concept that denotes a source of binary data: an input stream or a span reader.
+	template <typename T>
+	concept binary_source = std::derived_from<T, std::istream> || std::same_as<T, binary_span_reader>;
+	// Concept that denotes a sink for binary data: an output stream, a span writer or a byte buffer.
+	template <typename T>
+	concept binary_sink = std::derived_from<T, std::ostream> || std::same_as<T, binary_span_writer> || std::same_as<T, binary_buffer>;
+
+	// Concept that denotes a type able to be read with read_binary from a specific source.
+	template <typename T, typename Source>
+	concept binary_readable_from =
+		binary_source<Source> && requires(Source& is, T& out) { tr::binary_reader<std::remove_volatile_t<T>>{}(is, out); };
 	// Concept that denotes a type able to be read with read_binary.
 	template <typename T>
-	concept binary_readable = requires(std::istream& is, T& out) { tr::binary_reader<std::remove_volatile_t<T>>{}(is, out); };
+	concept binary_readable = binary_readable_from<T, std::istream>;
+	// Concept that denotes a type passable to the variadic read_binary: a span or a reference to a type readable from a source.
+	template <typename T, typename Source>
+	concept span_or_ref_to_binary_readable_from = (lvalue_reference<T> && binary_readable_from<std::remove_reference_t<T>, Source>) ||
+												  specialization_of_tv<std::remove_cvref_t<T>, std::span>;
 	// Concept that denotes a type passable to the variadic read_binary: a span or a reference to a binary readable.
 	template <typename T>
-	concept span_or_ref_to_binary_readable = (lvalue_reference<T> && binary_readable<std::remove_reference_t<T>>) ||
-											 specialization_of_tv<std::remove_cvref_t<T>, std::span>;
+	concept span_or_ref_to_binary_readable = span_or_ref_to_binary_readable_from<T, std::istream>;
+	// Concept that denotes a type able to be constructed with read_binary from a specific source.
+	template <typename T, typename Source>
+	concept binary_constructible_from = binary_readable_from<T, Source> && std::default_initializable<T>;
 	// Concept that denotes a type able to be constructed with read_binary.
 	template <typename T>
-	concept binary_constructible = binary_readable<T> && std::default_initializable<T>;
+	concept binary_constructible = binary_constructible_from<T, std::istream>;
 	// Concept that denotes a flush_binary-compatible iterator.
 	template <typename T>
 	concept binary_flushable_iterator = std::output_iterator<T, char> || std::output_iterator<T, signed char> ||
 										std::output_iterator<T, unsigned char> || std::output_iterator<T, std::byte>;
-	// Concept that denotes a type able to be read with a stream write_binary.
+	// Concept that denotes a type able to be written with write_binary to a specific sink.
+	template <typename T, typename Sink>
+	concept binary_writable_to =
+		binary_sink<Sink> && requires(Sink& os, const T& in) { tr::binary_writer<std::remove_cv_t<T>>{}(os, in); };
+	// Concept that denotes a type able to be written with write_binary.
 	template <typename T>
-	concept binary_writable = requires(std::ostream& os, const T& in) { tr::binary_writer<std::remove_cv_t<T>>{}(os, in); };
-
-	// Reads binary data from a stream.
-	template <binary_readable Out> void read_binary(std::istream& is, Out& out);
-	// Reads binary data from a stream.
-	template <binary_readable Out, usize Size> void read_binary(std::istream& is, std::span<Out, Size> out);
-	// Reads binary data from a stream.
-	template <span_or_ref_to_binary_readable... Outs>
-		requires(sizeof...(Outs) >= 2)
-	void read_binary(std::istream& is, Outs&&... outs);
-	// Reads binary data from a stream.
-	template <binary_constructible Out> Out read_binary(std::istream& is);
+	concept binary_writable = binary_writable_to<T, std::ostream>;
+
+	// Reads binary data from a source.
+	template <binary_source Source, binary_readable_from<Source> Out> void read_binary(Source& is, Out& out);
+	// Reads binary data from a source.
+	template <binary_source Source, binary_readable_from<Source> Out, usize Size> void read_binary(Source& is, std::span<Out, Size> out);
+	// Reads binary data from a source.
+	template <binary_source Source, typename... Outs>
+		requires(sizeof...(Outs) >= 2 && (span_or_ref_to_binary_readable_from<Outs, Source> && ...))
+	void read_binary(Source& is, Outs&&... outs);
+	// Reads binary data from a source.
+	template <typename Out, binary_source Source>
+		requires(binary_constructible_from<Out, Source>)
+	Out read_binary(Source& is);
 	// Checks for magic bytes from a stream.
 	bool read_binary_magic(std::istream& is, std::string_view magic);
+	// Checks for magic bytes from a span reader.
+	bool read_binary_magic(binary_span_reader& is, std::string_view magic);
 
 	// Flushes the rest of the stream into an output iterator.
 	template <tr::binary_flushable_iterator Iterator> void flush_binary(std::istream& is, Iterator out);
+	// Flushes the rest of the span reader into an output iterator.
+	template <tr::binary_flushable_iterator Iterator> void flush_binary(binary_span_reader& is, Iterator out);
 	// Flushes the rest of the stream into a vector of bytes.
 	std::vector<std::byte> flush_binary(std::istream& is);
+	// Flushes the rest of the span reader into a vector of bytes.
+	std::vector<std::byte> flush_binary(binary_span_reader& is);
 
-	// Writes binary data to a stream.
-	template <binary_writable In> void write_binary(std::ostream& os, const In& in);
-	// Writes binary data to a stream.
-	template <binary_writable... Ins>
-		requires(sizeof...(Ins) >= 2)
-	void write_binary(std::ostream& os, const Ins&... ins);
-	// Writes magic bytes to a stream.
-	void write_binary_magic(std::ostream& os, std::string_view magic);
+	// Writes binary data to a sink.
+	template <binary_sink Sink, binary_writable_to<Sink> In> void write_binary(Sink& os, const In& in);
+	// Writes binary data to a sink.
+	template <binary_sink Sink, typename... Ins>
+		requires(sizeof...(Ins) >= 2 && (binary_writable_to<Ins, Sink> && ...))
+	void write_binary(Sink& os, const Ins&... ins);
+	// Writes magic bytes to a sink.
+	template <binary_sink Sink> void write_binary_magic(Sink& os, std::string_view magic);
 } // namespace tr
 
 ///////////////////////////////////////////////////////////// SPECIALIZATIONS /////////////////////////////////////////////////////////////
@@ -114,50 +235,50 @@ namespace tr {
 	template <cv_unqualified_object Defaulted>
 		requires(enable_default_binary_io<Defaulted>)
 	struct binary_reader<Defaulted> {
-		using default_reader = std::true_type;
-		void operator()(std::istream& is, Defaulted& out) const;
+		using raw_reader = std::true_type;
+		template <binary_source Source> void operator()(Source& is, Defaulted& out) const;
 	};
 	// Array binary reader.
 	template <binary_readable Element, usize Size> struct binary_reader<std::array<Element, Size>> {
-		void operator()(std::istream& is, std::array<Element, Size>& out) const;
+		template <binary_source Source> void operator()(Source& is, std::array<Element, Size>& out) const;
 	};
 	// Pair binary reader.
 	template <binary_readable First, binary_readable Second> struct binary_reader<std::pair<First, Second>> {
-		void operator()(std::istream& is, std::pair<First, Second>& out) const;
+		template <binary_source Source> void operator()(Source& is, std::pair<First, Second>& out) const;
 	};
 	// String binary reader.
 	template <> struct binary_reader<std::string> {
-		void operator()(std::istream& is, std::string& out) const;
+		template <binary_source Source> void operator()(Source& is, std::string& out) const;
 	};
 	// Vector binary reader.
 	template <binary_constructible Element> struct binary_reader<std::vector<Element>> {
-		void operator()(std::istream& is, std::vector<Element>& out) const;
+		template <binary_source Source> void operator()(Source& is, std::vector<Element>& out) const;
 	};
 	// Set binary reader.
 	template <binary_constructible Key, typename... Other> struct binary_reader<std::set<Key, Other...>> {
-		void operator()(std::istream& is, std::set<Key, Other...>& out) const;
+		template <binary_source Source> void operator()(Source& is, std::set<Key, Other...>& out) const;
 	};
 	// Map binary reader.
 	template <binary_constructible Key, binary_constructible V, typename... Other> struct binary_reader<std::map<Key, V, Other...>> {
-		void operator()(std::istream& is, std::map<Key, V, Other...>& out) const;
+		template <binary_source Source> void operator()(Source& is, std::map<Key, V, Other...>& out) const;
 	};
 	// Unordered flat set binary reader.
 	template <binary_constructible Key, typename... Other> struct binary_reader<boost::unordered_flat_set<Key, Other...>> {
-		void operator()(std::istream& is, boost::unordered_flat_set<Key, Other...>& out) const;
+		template <binary_source Source> void operator()(Source& is, boost::unordered_flat_set<Key, Other...>& out) const;
 	};
 	// Unordered node set binary reader.
 	template <binary_constructible Key, typename... Other> struct binary_reader<boost::unordered_node_set<Key, Other...>> {
-		void operator()(std::istream& is, boost::unordered_node_set<Key, Other...>& out) const;
+		template <binary_source Source> void operator()(Source& is, boost::unordered_node_set<Key, Other...>& out) const;
 	};
 	// Unordered flat map binary reader.
 	template <binary_constructible Key, binary_constructible V, typename... Other>
 	struct binary_reader<boost::unordered_flat_map<Key, V, Other...>> {
-		void operator()(std::istream& is, boost::unordered_flat_map<Key, V, Other...>& out) const;
+		template <binary_source Source> void operator()(Source& is, boost::unordered_flat_map<Key, V, Other...>& out) const;
 	};
 	// Unordered node map binary reader.
 	template <binary_constructible Key, binary_constructible V, typename... Other>
 	struct binary_reader<boost::unordered_node_map<Key, V, Other...>> {
-		void operator()(std::istream& is, boost::unordered_node_map<Key, V, Other...>& out) const;
+		template <binary_source Source> void operator()(Source& is, boost::unordered_node_map<Key, V, Other...>& out) const;
 	};
 
 	// Default binary writer.
@@ -165,69 +286,69 @@ namespace tr {
 		requires(enable_default_binary_io<Defaulted>)
 	struct binary_writer<Defaulted> {
 		using raw_writer = std::true_type;
-		void operator()(std::ostream& os, const Defaulted& in);
+		template <binary_sink Sink> void operator()(Sink& os, const Defaulted& in);
 	};
 	// Span binary writer.
 	template <binary_writable Element, usize Size> struct binary_writer<std::span<Element, Size>> {
-		void operator()(std::ostream& os, const std::span<Element, Size>& in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const std::span<Element, Size>& in) const;
 	};
 	// Pair binary writer.
 	template <binary_writable First, binary_writable Second> struct binary_writer<std::pair<First, Second>> {
-		void operator()(std::ostream& os, const std::pair<First, Second> in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const std::pair<First, Second> in) const;
 	};
 	// C String binary writer.
 	template <> struct binary_writer<const char*> {
-		void operator()(std::ostream& os, const char* in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const char* in) const;
 	};
 	// C String binary writer.
 	template <usize Size> struct binary_writer<char[Size]> {
-		void operator()(std::ostream& os, const char (&in)[Size]) const;
+		template <binary_sink Sink> void operator()(Sink& os, const char (&in)[Size]) const;
 	};
 	// String view binary writer.
 	template <> struct binary_writer<std::string_view> {
-		void operator()(std::ostream& os, const std::string_view& in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const std::string_view& in) const;
 	};
 	// String binary writer.
 	template <> struct binary_writer<std::string> {
-		void operator()(std::ostream& os, const std::string& in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const std::string& in) const;
 	};
 	// Raw array binary writer.
 	template <binary_writable Element, usize Size> struct binary_writer<Element[Size]> {
-		void operator()(std::ostream& os, const Element (&in)[Size]) const;
+		template <binary_sink Sink> void operator()(Sink& os, const Element (&in)[Size]) const;
 	};
 	// Array binary writer.
 	template <binary_writable Element, usize Size> struct binary_writer<std::array<Element, Size>> {
-		void operator()(std::ostream& os, const std::array<Element, Size>& in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const std::array<Element, Size>& in) const;
 	};
 	// Vector binary writer.
 	template <binary_writable Element> struct binary_writer<std::vector<Element>> {
-		void operator()(std::ostream& os, const std::vector<Element>& in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const std::vector<Element>& in) const;
 	};
 	// Set binary writer.
 	template <binary_writable Key, typename... Other> struct binary_writer<std::set<Key, Other...>> {
-		void operator()(std::ostream& os, const std::set<Key, Other...>& in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const std::set<Key, Other...>& in) const;
 	};
 	// Map binary writer.
 	template <binary_writable Key, binary_writable Value, typename... Other> struct binary_writer<std::map<Key, Value, Other...>> {
-		void operator()(std::ostream& os, const std::map<Key, Value, Other...>& in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const std::map<Key, Value, Other...>& in) const;
 	};
 	// Unordered flat set binary writer.
 	template <binary_writable Key, typename... Other> struct binary_writer<boost::unordered_flat_set<Key, Other...>> {
-		void operator()(std::ostream& os, const boost::unordered_flat_set<Key, Other...>& in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const boost::unordered_flat_set<Key, Other...>& in) const;
 	};
 	// Unordered node set binary writer.
 	template <binary_writable Key, typename... Other> struct binary_writer<boost::unordered_node_set<Key, Other...>> {
-		void operator()(std::ostream& os, const boost::unordered_node_set<Key, Other...>& in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const boost::unordered_node_set<Key, Other...>& in) const;
 	};
 	// Unordered flat map writer.
 	template <binary_writable Key, binary_writable Value, typename... Other>
 	struct binary_writer<boost::unordered_flat_map<Key, Value, Other...>> {
-		void operator()(std::ostream& os, const boost::unordered_flat_map<Key, Value, Other...>& in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const boost::unordered_flat_map<Key, Value, Other...>& in) const;
 	};
 	// Unordered node map writer.
 	template <binary_writable Key, binary_writable Value, typename... Other>
 	struct binary_writer<boost::unordered_node_map<Key, Value, Other...>> {
-		void operator()(std::ostream& os, const boost::unordered_node_map<Key, Value, Other...>& in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const boost::unordered_node_map<Key, Value, Other...>& in) const;
 	};
 } // namespace tr
 
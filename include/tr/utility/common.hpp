@@ -13,6 +13,8 @@
 #include <algorithm>                              // IWYU pragma: export
 #include <any>                                    // IWYU pragma: export
 #include <array>                                  // IWYU pragma: export
+#include <atomic>                                 // IWYU pragma: export
+#include <bit>                                    // IWYU pragma: export
 #include <bitset>                                 // IWYU pragma: export
 #include <boost/container_hash/hash.hpp>          // IWYU pragma: export
 #include <boost/unordered/unordered_flat_map.hpp> // IWYU pragma: export
@@ -26,6 +28,7 @@
 #include <concepts>                               // IWYU pragma: export
 #include <cstdint>                                // IWYU pragma: export
 #include <cstdlib>                                // IWYU pragma: export
+#include <cstring>                                // IWYU pragma: export
 #include <deque>                                  // IWYU pragma: export
 #include <exception>                              // IWYU pragma: export
 #include <filesystem>                             // IWYU pragma: export
@@ -68,32 +68,32 @@ namespace tr {
 	inline usize smooth_arc_vertices(float r, angle sizeth);
 
 	// Calculates the number of indices needed for a line strip.
-	constexpr usize line_strip_indices(u16 vertices);
+	constexpr usize line_strip_indices(usize vertices);
 	// Calculates the number of indices needed for a line loop.
-	constexpr usize line_loop_indices(u16 vertices);
+	constexpr usize line_loop_indices(usize vertices);
 	// Calculates the number of indices needed for a simple polygon mesh with no holes.
-	constexpr usize polygon_indices(u16 vertices);
+	constexpr usize polygon_indices(usize vertices);
 	// Calculates the number of indices needed for a simple polygon mesh with no holes.
-	constexpr usize polygon_outline_indices(u16 vertices);
+	constexpr usize polygon_outline_indices(usize vertices);
 
 	// Outputs indices for a line strip to an output iterator.
 	// out needs to have space for line_strip_indices(vertices) indices.
-	template <std::output_iterator<u16> Iterator> constexpr Iterator fill_line_strip_indices(Iterator out, u16 vertices, u16 base);
+	template <std::output_iterator<u32> Iterator> constexpr Iterator fill_line_strip_indices(Iterator out, usize vertices, u32 base);
 	// Outputs indices for a line loop to an output iterator.
 	// out needs to have space for line_loop_indices(vertices) indices.
-	template <std::output_iterator<u16> Iterator> constexpr Iterator fill_line_loop_indices(Iterator out, u16 vertices, u16 base);
+	template <std::output_iterator<u32> Iterator> constexpr Iterator fill_line_loop_indices(Iterator out, usize vertices, u32 base);
 	// Outputs indices for a convex polygon to an output iterator.
 	// out needs to have space for polygon_indices(vertices) indices.
-	template <std::output_iterator<u16> Iterator> constexpr Iterator fill_convex_polygon_indices(Iterator out, u16 vertices, u16 base);
+	template <std::output_iterator<u32> Iterator> constexpr Iterator fill_convex_polygon_indices(Iterator out, usize vertices, u32 base);
 	// Outputs indices for a convex polygon outline to an output iterator.
 	// out needs to have space for polygon_outline_indices(vertices) indices.
 	// vertices is the number of vertices in the polygon, not the mesh.
-	template <std::output_iterator<u16> Iterator>
-	constexpr Iterator fill_convex_polygon_outline_indices(Iterator out, u16 vertices, u16 base);
+	template <std::output_iterator<u32> Iterator>
+	constexpr Iterator fill_convex_polygon_outline_indices(Iterator out, usize vertices, u32 base);
 	// Outputs indices for a simple polygon to an output iterator.
 	// out needs to have space for polygon_indices(vertices) indices.
-	template <std::output_iterator<u16> Iterator>
-	constexpr Iterator fill_simple_polygon_indices(Iterator out, std::span<const glm::vec2> vertices, u16 base);
+	template <std::output_iterator<u32> Iterator>
+	constexpr Iterator fill_simple_polygon_indices(Iterator out, std::span<const glm::vec2> vertices, u32 base);
 
 	// Outputs rectangle vertices to an output iterator.
 	// out needs to have space for 4 vertices.
@@ -7,14 +7,131 @@
 #pragma once
 #include "../binary_io.hpp"
 
+////////////////////////////////////////////////////////// BINARY SPAN READER ///////////////////////////////////////////////////////////
+
+inline tr::binary_span_reader::binary_span_reader(std::span<const std::byte> data)
+	: m_data{data}
+{
+}
+
+inline tr::usize tr::binary_span_reader::position() const
+{
+	return m_position;
+}
+
+inline tr::usize tr::binary_span_reader::remaining() const
+{
+	return m_data.size() - m_position;
+}
+
+inline std::span<const std::byte> tr::binary_span_reader::remaining_bytes() const
+{
+	return m_data.subspan(m_position);
+}
+
+inline void tr::binary_span_reader::read(char* out, usize size)
+{
+	if (size > remaining()) [[unlikely]] {
+		throw_overrun(size);
+	}
+	std::memcpy(out, m_data.data() + m_position, size);
+	m_position += size;
+}
+
+inline void tr::binary_span_reader::skip(usize size)
+{
+	if (size > remaining()) [[unlikely]] {
+		throw_overrun(size);
+	}
+	m_position += size;
+}
+
+inline void tr::binary_span_reader::require(usize size) const
+{
+	if (size > remaining()) [[unlikely]] {
+		throw_overrun(size);
+	}
+}
+
+////////////////////////////////////////////////////////// BINARY SPAN WRITER ///////////////////////////////////////////////////////////
+
+inline tr::binary_span_writer::binary_span_writer(std::span<std::byte> data)
+	: m_data{data}
+{
+}
+
+inline tr::usize tr::binary_span_writer::position() const
+{
+	return m_position;
+}
+
+inline tr::usize tr::binary_span_writer::remaining() const
+{
+	return m_data.size() - m_position;
+}
+
+inline std::span<std::byte> tr::binary_span_writer::written_bytes() const
+{
+	return m_data.first(m_position);
+}
+
+inline void tr::binary_span_writer::write(const char* in, usize size)
+{
+	if (size > remaining()) [[unlikely]] {
+		throw_overrun(size);
+	}
+	std::memcpy(m_data.data() + m_position, in, size);
+	m_position += size;
+}
+
+////////////////////////////////////////////////////////////// BINARY BUFFER //////////////////////////////////////////////////////////////
+
+inline tr::binary_buffer::binary_buffer(usize capacity)
+{
+	m_bytes.reserve(capacity);
+}
+
+inline tr::usize tr::binary_buffer::size() const
+{
+	return m_bytes.size();
+}
+
+inline std::span<const std::byte> tr::binary_buffer::bytes() const
+{
+	return m_bytes;
+}
+
+inline void tr::binary_buffer::reserve(usize capacity)
+{
+	m_bytes.reserve(capacity);
+}
+
+inline void tr::binary_buffer::clear()
+{
+	m_bytes.clear();
+}
+
+inline std::vector<std::byte> tr::binary_buffer::release()
+{
+	return std::exchange(m_bytes, {});
+}
+
+inline void tr::binary_buffer::write(const char* in, usize size)
+{
+	const usize old_size{m_bytes.size()};
+	m_bytes.resize(old_size + size);
+	std::memcpy(m_bytes.data() + old_size, in, size);
+}
+
 /////////////////////////////////////////////////////////// BINARY IO FUNCTIONS ///////////////////////////////////////////////////////////
 
-template <tr::binary_readable Out> void tr::read_binary(std::istream& is, Out& out)
+template <tr::binary_source Source, tr::binary_readable_from<Source> Out> void tr::read_binary(Source& is, Out& out)
 {
 	binary_reader<std::remove_volatile_t<Out>>{}(is, out);
 }
 
-template <tr::binary_readable Out, tr::usize Size> void tr::read_binary(std::istream& is, std::span<Out, Size> out)
+template <tr::binary_source Source, tr::binary_readable_from<Source> Out, tr::usize Size>
+void tr::read_binary(Source& is, std::span<Out, Size> out)
 {
 	if constexpr (requires { requires std::same_as<typename binary_reader<Out>::raw_reader, std::true_type>; }) {
 		is.read(reinterpret_cast<char*>(out.data()), out.size_bytes());
@@ -26,14 +143,16 @@ template <tr::binary_readable Out, tr::usize Size> void tr::read_binary(std::ist
 	}
 }
 
-template <tr::span_or_ref_to_binary_readable... Outs>
-	requires(sizeof...(Outs) >= 2)
-void tr::read_binary(std::istream& is, Outs&&... outs)
+template <tr::binary_source Source, typename... Outs>
+	requires(sizeof...(Outs) >= 2 && (tr::span_or_ref_to_binary_readable_from<Outs, Source> && ...))
+void tr::read_binary(Source& is, Outs&&... outs)
 {
 	(read_binary(is, outs), ...);
 }
 
-template <tr::binary_constructible Out> Out tr::read_binary(std::istream& is)
+template <typename Out, tr::binary_source Source>
+	requires(tr::binary_constructible_from<Out, Source>)
+Out tr::read_binary(Source& is)
 {
 	Out out;
 	read_binary(is, out);
@@ -42,64 +161,121 @@ template <tr::binary_constructible Out> Out tr::read_binary(std::istream& is)
 
 template <tr::binary_flushable_iterator Iterator> void tr::flush_binary(std::istream& is, Iterator out)
 {
-	while (is.peek() != EOF) {
-		if constexpr (std::output_iterator<Iterator, char>) {
-			*out++ = static_cast<char>(is.get());
-		}
-		else if constexpr (std::output_iterator<Iterator, signed char>) {
-			*out++ = static_cast<signed char>(is.get());
-		}
-		else if constexpr (std::output_iterator<Iterator, unsigned char>) {
-			*out++ = static_cast<unsigned char>(is.get());
-		}
-		else {
-			*out++ = static_cast<std::byte>(is.get());
+	// Reading through the stream buffer directly, as a short read through the stream would set the failbit (and throw if the stream
+	// has exceptions enabled for it), while running out of data isn't an error here.
+	std::array<char, 4096> chunk;
+	std::streamsize read;
+	while ((read = is.rdbuf()->sgetn(chunk.data(), chunk.size())) > 0) {
+		for (char chr : std::span{chunk}.first(static_cast<usize>(read))) {
+			if constexpr (std::output_iterator<Iterator, char>) {
+				*out++ = chr;
+			}
+			else if constexpr (std::output_iterator<Iterator, signed char>) {
+				*out++ = static_cast<signed char>(chr);
+			}
+			else if constexpr (std::output_iterator<Iterator, unsigned char>) {
+				*out++ = static_cast<unsigned char>(chr);
+			}
+			else {
+				*out++ = static_cast<std::byte>(chr);
+			}
 		}
 	}
+	is.setstate(std::ios::eofbit);
+}
+
+template <tr::binary_flushable_iterator Iterator> void tr::flush_binary(binary_span_reader& is, Iterator out)
+{
+	const std::span<const std::byte> data{is.remaining_bytes()};
+	if constexpr (std::output_iterator<Iterator, std::byte>) {
+		std::ranges::copy(data, out);
+	}
+	else if constexpr (std::output_iterator<Iterator, char>) {
+		std::ranges::copy(data | std::views::transform([](std::byte v) { return static_cast<char>(v); }), out);
+	}
+	else if constexpr (std::output_iterator<Iterator, signed char>) {
+		std::ranges::copy(data | std::views::transform([](std::byte v) { return static_cast<signed char>(v); }), out);
+	}
+	else {
+		std::ranges::copy(data | std::views::transform([](std::byte v) { return static_cast<unsigned char>(v); }), out);
+	}
+	is.skip(data.size());
 }
 
-template <tr::binary_writable In> void tr::write_binary(std::ostream& os, const In& in)
+template <tr::binary_sink Sink, tr::binary_writable_to<Sink> In> void tr::write_binary(Sink& os, const In& in)
 {
 	binary_writer<std::remove_cv_t<In>>{}(os, in);
 }
 
-template <tr::binary_writable... Ins>
-	requires(sizeof...(Ins) >= 2)
-void tr::write_binary(std::ostream& os, const Ins&... ins)
+template <tr::binary_sink Sink, typename... Ins>
+	requires(sizeof...(Ins) >= 2 && (tr::binary_writable_to<Ins, Sink> && ...))
+void tr::write_binary(Sink& os, const Ins&... ins)
 {
 	(write_binary(os, ins), ...);
 }
 
+template <tr::binary_sink Sink> void tr::write_binary_magic(Sink& os, std::string_view magic)
+{
+	os.write(magic.data(), magic.size());
+}
+
 ////////////////////////////////////////////////////// BINARY READER SPECIALIZATIONS //////////////////////////////////////////////////////
 
 template <tr::cv_unqualified_object Defaulted>
 	requires(tr::enable_default_binary_io<Defaulted>)
-void tr::binary_reader<Defaulted>::operator()(std::istream& is, Defaulted& out) const
+template <tr::binary_source Source>
+void tr::binary_reader<Defaulted>::operator()(Source& is, Defaulted& out) const
 {
 	is.read(reinterpret_cast<char*>(std::addressof(out)), sizeof(Defaulted));
 }
 
 template <tr::binary_readable Element, tr::usize Size>
-void tr::binary_reader<std::array<Element, Size>>::operator()(std::istream& is, std::array<Element, Size>& out) const
+template <tr::binary_source Source>
+void tr::binary_reader<std::array<Element, Size>>::operator()(Source& is, std::array<Element, Size>& out) const
 {
 	read_binary(is, std::span{out});
 }
 
 template <tr::binary_readable First, tr::binary_readable Second>
-void tr::binary_reader<std::pair<First, Second>>::operator()(std::istream& is, std::pair<First, Second>& out) const
+template <tr::binary_source Source>
+void tr::binary_reader<std::pair<First, Second>>::operator()(Source& is, std::pair<First, Second>& out) const
 {
 	read_binary(is, out.first, out.second);
 }
 
+template <tr::binary_source Source> void tr::binary_reader<std::string>::operator()(Source& is, std::string& out) const
+{
+	const u32 size{read_binary<u32>(is)};
+	// A corrupted size mustn't be able to trigger a huge allocation when it can be checked against the data that's left.
+	if constexpr (std::same_as<Source, binary_span_reader>) {
+		is.require(size);
+	}
+	out.resize(size);
+	is.read(out.data(), out.size());
+}
+
 template <tr::binary_constructible Element>
-void tr::binary_reader<std::vector<Element>>::operator()(std::istream& is, std::vector<Element>& out) const
+template <tr::binary_source Source>
+void tr::binary_reader<std::vector<Element>>::operator()(Source& is, std::vector<Element>& out) const
 {
-	out.resize(read_binary<u32>(is));
+	const u32 size{read_binary<u32>(is)};
+	// A corrupted size mustn't be able to trigger a huge allocation when it can be checked against the data that's left.
+	// Elements without a raw reader are assumed to take up at least a byte.
+	if constexpr (std::same_as<Source, binary_span_reader>) {
+		if constexpr (requires { requires std::same_as<typename binary_reader<Element>::raw_reader, std::true_type>; }) {
+			is.require(usize(size) * sizeof(Element));
+		}
+		else {
+			is.require(size);
+		}
+	}
+	out.resize(size);
 	read_binary(is, std::span{out});
 }
 
 template <tr::binary_constructible Key, typename... Other>
-void tr::binary_reader<std::set<Key, Other...>>::operator()(std::istream& is, std::set<Key, Other...>& out) const
+template <tr::binary_source Source>
+void tr::binary_reader<std::set<Key, Other...>>::operator()(Source& is, std::set<Key, Other...>& out) const
 {
 	const u32 size{read_binary<u32>(is)};
 	out.clear();
@@ -109,7 +285,8 @@ void tr::binary_reader<std::set<Key, Other...>>::operator()(std::istream& is, st
 }
 
 template <tr::binary_constructible Key, tr::binary_constructible Value, typename... Other>
-void tr::binary_reader<std::map<Key, Value, Other...>>::operator()(std::istream& is, std::map<Key, Value, Other...>& out) const
+template <tr::binary_source Source>
+void tr::binary_reader<std::map<Key, Value, Other...>>::operator()(Source& is, std::map<Key, Value, Other...>& out) const
 {
 	const u32 size{read_binary<u32>(is)};
 	out.clear();
@@ -121,7 +298,8 @@ void tr::binary_reader<std::map<Key, Value, Other...>>::operator()(std::istream&
 }
 
 template <tr::binary_constructible Key, typename... Other>
-void tr::binary_reader<boost::unordered_flat_set<Key, Other...>>::operator()(std::istream& is,
+template <tr::binary_source Source>
+void tr::binary_reader<boost::unordered_flat_set<Key, Other...>>::operator()(Source& is,
 																			 boost::unordered_flat_set<Key, Other...>& out) const
 {
 	const u32 size{read_binary<u32>(is)};
@@ -133,7 +311,8 @@ void tr::binary_reader<boost::unordered_flat_set<Key, Other...>>::operator()(std
 }
 
 template <tr::binary_constructible Key, typename... Other>
-void tr::binary_reader<boost::unordered_node_set<Key, Other...>>::operator()(std::istream& is,
+template <tr::binary_source Source>
+void tr::binary_reader<boost::unordered_node_set<Key, Other...>>::operator()(Source& is,
 																			 boost::unordered_node_set<Key, Other...>& out) const
 {
 	const u32 size{read_binary<u32>(is)};
@@ -145,8 +324,9 @@ void tr::binary_reader<boost::unordered_node_set<Key, Other...>>::operator()(std
 }
 
 template <tr::binary_constructible Key, tr::binary_constructible Value, typename... Other>
+template <tr::binary_source Source>
 void tr::binary_reader<boost::unordered_flat_map<Key, Value, Other...>>::operator()(
-	std::istream& is, boost::unordered_flat_map<Key, Value, Other...>& out) const
+	Source& is, boost::unordered_flat_map<Key, Value, Other...>& out) const
 {
 	const u32 size{read_binary<u32>(is)};
 	out.clear();
@@ -159,8 +339,9 @@ void tr::binary_reader<boost::unordered_flat_map<Key, Value, Other...>>::operato
 }
 
 template <tr::binary_constructible Key, tr::binary_constructible Value, typename... Other>
+template <tr::binary_source Source>
 void tr::binary_reader<boost::unordered_node_map<Key, Value, Other...>>::operator()(
-	std::istream& is, boost::unordered_node_map<Key, Value, Other...>& out) const
+	Source& is, boost::unordered_node_map<Key, Value, Other...>& out) const
 {
 	const u32 size{read_binary<u32>(is)};
 	out.clear();
@@ -176,13 +357,15 @@ void tr::binary_reader<boost::unordered_node_map<Key, Value, Other...>>::operato
 
 template <tr::cv_unqualified_object Defaulted>
 	requires(tr::enable_default_binary_io<Defaulted>)
-void tr::binary_writer<Defaulted>::operator()(std::ostream& os, const Defaulted& in)
+template <tr::binary_sink Sink>
+void tr::binary_writer<Defaulted>::operator()(Sink& os, const Defaulted& in)
 {
 	os.write(reinterpret_cast<const char*>(std::addressof(in)), sizeof(Defaulted));
 }
 
 template <tr::binary_writable Element, tr::usize Size>
-void tr::binary_writer<std::span<Element, Size>>::operator()(std::ostream& os, const std::span<Element, Size>& in) const
+template <tr::binary_sink Sink>
+void tr::binary_writer<std::span<Element, Size>>::operator()(Sink& os, const std::span<Element, Size>& in) const
 {
 	if constexpr (requires { requires std::same_as<typename binary_writer<std::remove_const_t<Element>>::raw_writer, std::true_type>; }) {
 		os.write(reinterpret_cast<const char*>(in.data()), in.size_bytes());
@@ -195,36 +378,59 @@ void tr::binary_writer<std::span<Element, Size>>::operator()(std::ostream& os, c
 }
 
 template <tr::binary_writable First, tr::binary_writable Second>
-void tr::binary_writer<std::pair<First, Second>>::operator()(std::ostream& os, const std::pair<First, Second> in) const
+template <tr::binary_sink Sink>
+void tr::binary_writer<std::pair<First, Second>>::operator()(Sink& os, const std::pair<First, Second> in) const
 {
 	write_binary(os, in.first, in.second);
 }
 
-template <tr::usize Size> void tr::binary_writer<char[Size]>::operator()(std::ostream& os, const char (&in)[Size]) const
+template <tr::binary_sink Sink> void tr::binary_writer<const char*>::operator()(Sink& os, const char* in) const
+{
+	write_binary(os, std::string_view{in});
+}
+
+template <tr::usize Size>
+template <tr::binary_sink Sink>
+void tr::binary_writer<char[Size]>::operator()(Sink& os, const char (&in)[Size]) const
+{
+	write_binary(os, std::string_view{in});
+}
+
+template <tr::binary_sink Sink> void tr::binary_writer<std::string_view>::operator()(Sink& os, const std::string_view& in) const
+{
+	write_binary(os, static_cast<u32>(in.size()));
+	os.write(in.data(), in.size());
+}
+
+template <tr::binary_sink Sink> void tr::binary_writer<std::string>::operator()(Sink& os, const std::string& in) const
 {
 	write_binary(os, std::string_view{in});
 }
 
 template <tr::binary_writable Element, tr::usize Size>
-void tr::binary_writer<Element[Size]>::operator()(std::ostream& os, const Element (&in)[Size]) const
+template <tr::binary_sink Sink>
+void tr::binary_writer<Element[Size]>::operator()(Sink& os, const Element (&in)[Size]) const
 {
 	write_binary(os, std::span{in});
 }
 
 template <tr::binary_writable Element, tr::usize Size>
-void tr::binary_writer<std::array<Element, Size>>::operator()(std::ostream& os, const std::array<Element, Size>& in) const
+template <tr::binary_sink Sink>
+void tr::binary_writer<std::array<Element, Size>>::operator()(Sink& os, const std::array<Element, Size>& in) const
 {
 	write_binary(os, std::span{in});
 }
 
 template <tr::binary_writable Element>
-void tr::binary_writer<std::vector<Element>>::operator()(std::ostream& os, const std::vector<Element>& in) const
+template <tr::binary_sink Sink>
+void tr::binary_writer<std::vector<Element>>::operator()(Sink& os, const std::vector<Element>& in) const
 {
 	write_binary(os, static_cast<u32>(in.size()), std::span{in});
 }
 
 template <tr::binary_writable Key, typename... Other>
-void tr::binary_writer<std::set<Key, Other...>>::operator()(std::ostream& os, const std::set<Key, Other...>& in) const
+template <tr::binary_sink Sink>
+void tr::binary_writer<std::set<Key, Other...>>::operator()(Sink& os, const std::set<Key, Other...>& in) const
 {
 	write_binary(os, static_cast<u32>(in.size()));
 	for (const Key& key : in) {
@@ -233,7 +439,8 @@ void tr::binary_writer<std::set<Key, Other...>>::operator()(std::ostream& os, co
 }
 
 template <tr::binary_writable Key, tr::binary_writable Value, typename... Other>
-void tr::binary_writer<std::map<Key, Value, Other...>>::operator()(std::ostream& os, const std::map<Key, Value, Other...>& in) const
+template <tr::binary_sink Sink>
+void tr::binary_writer<std::map<Key, Value, Other...>>::operator()(Sink& os, const std::map<Key, Value, Other...>& in) const
 {
 	write_binary(os, static_cast<u32>(in.size()));
 	for (const auto& [key, value] : in) {
@@ -242,7 +449,8 @@ void tr::binary_writer<std::map<Key, Value, Other...>>::operator()(std::ostream&
 }
 
 template <tr::binary_writable Key, typename... Other>
-void tr::binary_writer<boost::unordered_flat_set<Key, Other...>>::operator()(std::ostream& os,
+template <tr::binary_sink Sink>
+void tr::binary_writer<boost::unordered_flat_set<Key, Other...>>::operator()(Sink& os,
 																			 const boost::unordered_flat_set<Key, Other...>& in) const
 {
 	write_binary(os, static_cast<u32>(in.size()));
@@ -252,7 +460,8 @@ void tr::binary_writer<boost::unordered_flat_set<Key, Other...>>::operator()(std
 }
 
 template <tr::binary_writable Key, typename... Other>
-void tr::binary_writer<boost::unordered_node_set<Key, Other...>>::operator()(std::ostream& os,
+template <tr::binary_sink Sink>
+void tr::binary_writer<boost::unordered_node_set<Key, Other...>>::operator()(Sink& os,
 																			 const boost::unordered_node_set<Key, Other...>& in) const
 {
 	write_binary(os, static_cast<u32>(in.size()));
@@ -262,8 +471,9 @@ void tr::binary_writer<boost::unordered_node_set<Key, Other...>>::operator()(std
 }
 
 template <tr::binary_writable Key, tr::binary_writable Value, typename... Other>
+template <tr::binary_sink Sink>
 void tr::binary_writer<boost::unordered_flat_map<Key, Value, Other...>>::operator()(
-	std::ostream& os, const boost::unordered_flat_map<Key, Value, Other...>& in) const
+	Sink& os, const boost::unordered_flat_map<Key, Value, Other...>& in) const
 {
 	write_binary(os, static_cast<u32>(in.size()));
 	for (const auto& [key, value] : in) {
@@ -272,8 +482,9 @@ void tr::binary_writer<boost::unordered_flat_map<Key, Value, Other...>>::operato
 }
 
 template <tr::binary_writable Key, tr::binary_writable Value, typename... Other>
+template <tr::binary_sink Sink>
 void tr::binary_writer<boost::unordered_node_map<Key, Value, Other...>>::operator()(
-	std::ostream& os, const boost::unordered_node_map<Key, Value, Other...>& in) const
+	Sink& os, const boost::unordered_node_map<Key, Value, Other...>& in) const
 {
 	write_binary(os, static_cast<u32>(in.size()));
 	for (const auto& [key, value] : in) {
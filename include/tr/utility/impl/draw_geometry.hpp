@@ -28,53 +28,53 @@ inline tr::usize tr::smooth_arc_vertices(float r, angle sizeth)
 	return std::max(static_cast<usize>(7 * std::pow(r, 1 / 2.4f) / (sizeth / 1_tr)), 3_uz);
 }
 
-constexpr tr::usize tr::line_strip_indices(u16 vertices)
+constexpr tr::usize tr::line_strip_indices(usize vertices)
 {
 	return (vertices - 1) * 2;
 }
 
-constexpr tr::usize tr::line_loop_indices(u16 vertices)
+constexpr tr::usize tr::line_loop_indices(usize vertices)
 {
 	return vertices * 2;
 }
 
-constexpr tr::usize tr::polygon_indices(u16 vertices)
+constexpr tr::usize tr::polygon_indices(usize vertices)
 {
 	return (vertices - 2) * 3;
 }
 
-constexpr tr::usize tr::polygon_outline_indices(u16 vertices)
+constexpr tr::usize tr::polygon_outline_indices(usize vertices)
 {
 	return vertices * 6;
 }
 
 ///////////////////////////////////////////////////////////////// INDICES /////////////////////////////////////////////////////////////////
 
-template <std::output_iterator<tr::u16> Iterator> constexpr Iterator tr::fill_line_strip_indices(Iterator out, u16 vertices, u16 base)
+template <std::output_iterator<tr::u32> Iterator> constexpr Iterator tr::fill_line_strip_indices(Iterator out, usize vertices, u32 base)
 {
-	TR_ASSERT(base + vertices <= UINT16_MAX, "Index overflow detected in fill_line_strip_indices.");
+	TR_ASSERT(u64(base) + vertices <= UINT32_MAX, "Index overflow detected in fill_line_strip_indices.");
 
-	for (u16 i = 0; i < vertices - 1; ++i) {
+	for (u32 i = 0; i < vertices - 1; ++i) {
 		*out++ = base + i;
 		*out++ = base + i + 1;
 	}
 	return out;
 }
 
-template <std::output_iterator<tr::u16> Iterator> constexpr Iterator tr::fill_line_loop_indices(Iterator out, u16 vertices, u16 base)
+template <std::output_iterator<tr::u32> Iterator> constexpr Iterator tr::fill_line_loop_indices(Iterator out, usize vertices, u32 base)
 {
 	out = fill_line_strip_indices(out, vertices, base);
-	*out++ = base + vertices - 1;
+	*out++ = base + u32(vertices) - 1;
 	*out++ = base;
 	return out;
 }
 
-template <std::output_iterator<tr::u16> Iterator> constexpr Iterator tr::fill_convex_polygon_indices(Iterator out, u16 vertices, u16 base)
+template <std::output_iterator<tr::u32> Iterator> constexpr Iterator tr::fill_convex_polygon_indices(Iterator out, usize vertices, u32 base)
 {
 	TR_ASSERT(vertices >= 3, "Tried to calculate indices for {}-sided polygon.", vertices);
-	TR_ASSERT(base + vertices <= UINT16_MAX, "Index overflow detected in fill_convex_polygon_indices.");
+	TR_ASSERT(u64(base) + vertices <= UINT32_MAX, "Index overflow detected in fill_convex_polygon_indices.");
 
-	for (u16 i = 0; i < vertices - 2; ++i) {
+	for (u32 i = 0; i < vertices - 2; ++i) {
 		*out++ = base;
 		*out++ = base + i + 1;
 		*out++ = base + i + 2;
@@ -82,43 +82,44 @@ template <std::output_iterator<tr::u16> Iterator> constexpr Iterator tr::fill_co
 	return out;
 }
 
-template <std::output_iterator<tr::u16> Iterator>
-constexpr Iterator tr::fill_convex_polygon_outline_indices(Iterator out, u16 vertices, u16 base)
+template <std::output_iterator<tr::u32> Iterator>
+constexpr Iterator tr::fill_convex_polygon_outline_indices(Iterator out, usize vertices, u32 base)
 {
 	TR_ASSERT(vertices >= 3, "Tried to calculate indices for {}-sided polygon outline.", vertices);
-	TR_ASSERT(base + vertices <= UINT16_MAX, "Index overflow detected in fill_convex_polygon_outline_indices.");
+	TR_ASSERT(u64(base) + vertices * 2 <= UINT32_MAX, "Index overflow detected in fill_convex_polygon_outline_indices.");
 
-	for (u16 i = 0; i < vertices - 1; ++i) {
+	const u32 size{u32(vertices)};
+	for (u32 i = 0; i < size - 1; ++i) {
 		*out++ = base + i;
 		*out++ = base + i + 1;
-		*out++ = base + i + vertices;
+		*out++ = base + i + size;
 		*out++ = base + i + 1;
-		*out++ = base + i + vertices;
-		*out++ = base + i + vertices + 1;
+		*out++ = base + i + size;
+		*out++ = base + i + size + 1;
 	}
-	*out++ = base + vertices - 1;
+	*out++ = base + size - 1;
 	*out++ = base;
-	*out++ = base + 2 * vertices - 1;
+	*out++ = base + 2 * size - 1;
 	*out++ = base;
-	*out++ = base + 2 * vertices - 1;
-	*out++ = base + vertices;
+	*out++ = base + 2 * size - 1;
+	*out++ = base + size;
 	return out;
 }
 
-template <std::output_iterator<tr::u16> Iterator>
-constexpr Iterator tr::fill_simple_polygon_indices(Iterator out, std::span<const glm::vec2> vertices, u16 base)
+template <std::output_iterator<tr::u32> Iterator>
+constexpr Iterator tr::fill_simple_polygon_indices(Iterator out, std::span<const glm::vec2> vertices, u32 base)
 {
 	TR_ASSERT(vertices.size() >= 3, "Tried to calculate indices for {}-sided polygon.", vertices.size());
-	TR_ASSERT(base + vertices.size() <= UINT16_MAX, "Index overflow detected in fill_simple_polygon_indices.");
+	TR_ASSERT(u64(base) + vertices.size() <= UINT32_MAX, "Index overflow detected in fill_simple_polygon_indices.");
 
 	const winding_order winding_order{polygon_winding_order(vertices)};
 
-	std::vector<u16> indices(vertices.size());
-	std::iota(indices.begin(), indices.end(), 0_u16);
+	std::vector<u32> indices(vertices.size());
+	std::iota(indices.begin(), indices.end(), 0_u32);
 	while (indices.size() >= 3) {
 		for (usize i = 0; i < indices.size(); ++i) {
-			const u16 left{static_cast<u16>(i == 0 ? indices.size() - 1 : i - 1)};
-			const u16 right{static_cast<u16>(i == indices.size() - 1 ? 0 : i + 1)};
+			const usize left{i == 0 ? indices.size() - 1 : i - 1};
+			const usize right{i == indices.size() - 1 ? 0 : i + 1};
 
 			if (indices.size() > 3) {
 				const triangle tri{vertices[indices[left]], vertices[indices[i]], vertices[indices[right]]};
@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements intrusive_list.hpp.                                                                                                        //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../intrusive_list.hpp"
+#include "../macro.hpp"
+
+/////////////////////////////////////////////////////////// INTRUSIVE LIST NODE ///////////////////////////////////////////////////////////
+
+template <typename T> constexpr tr::intrusive_list_node<T>::intrusive_list_node(const intrusive_list_node&) noexcept
+{
+}
+
+template <typename T> constexpr tr::intrusive_list_node<T>& tr::intrusive_list_node<T>::operator=(const intrusive_list_node&) noexcept
+{
+	return *this;
+}
+
+////////////////////////////////////////////////////////////// INTRUSIVE LIST /////////////////////////////////////////////////////////////
+
+template <typename T>
+constexpr tr::intrusive_list<T>::intrusive_list(intrusive_list&& r) noexcept
+	: m_head{std::exchange(r.m_head, nullptr)}
+{
+}
+
+template <typename T> constexpr tr::intrusive_list<T>& tr::intrusive_list<T>::operator=(intrusive_list&& r) noexcept
+{
+	TR_ASSERT(this == &r || empty(), "Tried to move into a non-empty intrusive list.");
+
+	if (this != &r) {
+		m_head = std::exchange(r.m_head, nullptr);
+	}
+	return *this;
+}
+
+//
+
+template <typename T> constexpr bool tr::intrusive_list<T>::empty() const
+{
+	return m_head == nullptr;
+}
+
+//
+
+template <typename T> constexpr void tr::intrusive_list<T>::push_front(T& element)
+{
+	intrusive_list_node<T>& node{intrusive_list::node(element)};
+	node.m_prev = nullptr;
+	node.m_next = std::exchange(m_head, &element);
+	if (node.m_next != nullptr) {
+		intrusive_list::node(*node.m_next).m_prev = &element;
+	}
+}
+
+template <typename T> constexpr void tr::intrusive_list<T>::erase(T& element)
+{
+	intrusive_list_node<T>& node{intrusive_list::node(element)};
+	if (node.m_prev != nullptr) {
+		intrusive_list::node(*node.m_prev).m_next = node.m_next;
+	}
+	else {
+		m_head = node.m_next;
+	}
+	if (node.m_next != nullptr) {
+		intrusive_list::node(*node.m_next).m_prev = node.m_prev;
+	}
+	node.m_prev = nullptr;
+	node.m_next = nullptr;
+}
+
+template <typename T> constexpr void tr::intrusive_list<T>::replace(T& old_element, T& new_element)
+{
+	intrusive_list_node<T>& old_node{node(old_element)};
+	intrusive_list_node<T>& new_node{node(new_element)};
+	new_node.m_prev = std::exchange(old_node.m_prev, nullptr);
+	new_node.m_next = std::exchange(old_node.m_next, nullptr);
+	if (new_node.m_prev != nullptr) {
+		node(*new_node.m_prev).m_next = &new_element;
+	}
+	else {
+		m_head = &new_element;
+	}
+	if (new_node.m_next != nullptr) {
+		node(*new_node.m_next).m_prev = &new_element;
+	}
+}
+
+//
+
+template <typename T> template <std::invocable<T&> Fn> constexpr void tr::intrusive_list<T>::for_each(Fn fn) const
+{
+	for (T* element = m_head; element != nullptr; element = node(*element).m_next) {
+		fn(*element);
+	}
+}
+
+template <typename T> template <std::invocable<T&> Fn> constexpr void tr::intrusive_list<T>::clear(Fn fn)
+{
+	T* element{std::exchange(m_head, nullptr)};
+	while (element != nullptr) {
+		intrusive_list_node<T>& node{intrusive_list::node(*element)};
+		T* next{std::exchange(node.m_next, nullptr)};
+		node.m_prev = nullptr;
+		fn(*element);
+		element = next;
+	}
+}
+
+//
+
+template <typename T> constexpr tr::intrusive_list_node<T>& tr::intrusive_list<T>::node(T& element)
+{
+	return static_cast<intrusive_list_node<T>&>(element);
+}
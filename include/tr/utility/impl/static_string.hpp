@@ -326,14 +326,16 @@ template <tr::usize Capacity> constexpr void tr::static_string<Capacity>::resize
 //////////////////////////////////////////////////////////////////// IO ///////////////////////////////////////////////////////////////////
 
 template <tr::usize Capacity>
-void tr::binary_reader<tr::static_string<Capacity>>::operator()(std::istream& is, static_string<Capacity>& out) const
+template <tr::binary_source Source>
+void tr::binary_reader<tr::static_string<Capacity>>::operator()(Source& is, static_string<Capacity>& out) const
 {
 	out.resize(read_binary<typename static_string<Capacity>::size_type>(is));
 	is.read(out.data(), out.size());
 }
 
 template <tr::usize Capacity>
-void tr::binary_writer<tr::static_string<Capacity>>::operator()(std::ostream& os, const static_string<Capacity>& in) const
+template <tr::binary_sink Sink>
+void tr::binary_writer<tr::static_string<Capacity>>::operator()(Sink& os, const static_string<Capacity>& in) const
 {
 	write_binary(os, in.size());
 	write_binary(os, std::span{in});
@@ -423,14 +423,16 @@ void tr::static_vector<Element, Capacity>::resize(size_type size, const Element&
 //////////////////////////////////////////////////////////////// BINARY IO ////////////////////////////////////////////////////////////////
 
 template <tr::binary_constructible Element, tr::usize Capacity>
-void tr::binary_reader<tr::static_vector<Element, Capacity>>::operator()(std::istream& is, static_vector<Element, Capacity>& out) const
+template <tr::binary_source Source>
+void tr::binary_reader<tr::static_vector<Element, Capacity>>::operator()(Source& is, static_vector<Element, Capacity>& out) const
 {
 	out.resize(read_binary<typename tr::static_vector<Element, Capacity>::size_type>(is));
 	read_binary(is, std::span{out});
 }
 
 template <tr::binary_writable Element, tr::usize Capacity>
-void tr::binary_writer<tr::static_vector<Element, Capacity>>::operator()(std::ostream& os, const static_vector<Element, Capacity>& in) const
+template <tr::binary_sink Sink>
+void tr::binary_writer<tr::static_vector<Element, Capacity>>::operator()(Sink& os, const static_vector<Element, Capacity>& in) const
 {
 	write_binary(os, in.size());
 	write_binary(os, std::span{in});
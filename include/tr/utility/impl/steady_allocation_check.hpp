@@ -0,0 +1,15 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements steady_allocation_check.hpp.                                                                                               //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../steady_allocation_check.hpp"
+
+///////////////////////////////////////////////////////// STEADY ALLOCATION CHECK /////////////////////////////////////////////////////////
+
+template <typename T> void tr::steady_allocation_check::add_workload(const T& value)
+{
+	boost::hash_combine(m_workload, value);
+}
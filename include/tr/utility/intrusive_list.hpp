@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides an intrusive doubly-linked list.                                                                                             //
+//                                                                                                                                       //
+// tr::intrusive_list links together objects that derive from tr::intrusive_list_node without allocating any memory of its own, so       //
+// adding, removing and replacing elements takes constant time no matter how long the list is. Elements that derive from the node type   //
+// privately must befriend the list type. The links of a node are not copied when the node is:                                           //
+//     - struct element : tr::intrusive_list_node<element> { int value; } -> defines a type that can be linked into a list               //
+//     - tr::intrusive_list<element> list; list.push_front(a) -> adds 'a' to the front of the list                                       //
+//     - list.erase(a) -> removes 'a' from the list                                                                                      //
+//     - list.replace(a, b) -> makes 'b' take the place of 'a' in the list                                                               //
+//                                                                                                                                       //
+// The elements of the list can be visited in order, or all unlinked at once (an element may be safely modified by the function it is    //
+// passed to, as it is already unlinked by then). Moving a list transfers its elements, but the moved-to list must be empty:             //
+//     - list.for_each([](element& e) { ++e.value; }) -> increments the value of every element                                           //
+//     - list.clear([](element& e) { e.value = 0; }) -> unlinks every element and zeroes its value                                       //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "common.hpp"
+
+//////////////////////////////////////////////////////////////// INTERFACE ////////////////////////////////////////////////////////////////
+
+namespace tr {
+	template <typename T> class intrusive_list;
+
+	// Base of the elements of an intrusive list, holding the links to the neighbouring elements.
+	template <typename T> class intrusive_list_node {
+	  public:
+		// Creates an unlinked node.
+		constexpr intrusive_list_node() = default;
+		// Creates an unlinked node (the links of the copied node are not copied).
+		constexpr intrusive_list_node(const intrusive_list_node&) noexcept;
+
+		// Leaves the links of the node untouched.
+		constexpr intrusive_list_node& operator=(const intrusive_list_node&) noexcept;
+
+	  private:
+		// The previous element in the list.
+		T* m_prev{nullptr};
+		// The next element in the list.
+		T* m_next{nullptr};
+
+		friend class intrusive_list<T>;
+	};
+
+	// Intrusive doubly-linked list.
+	template <typename T> class intrusive_list {
+	  public:
+		// Creates an empty list.
+		constexpr intrusive_list() = default;
+		// Moves the elements of a list into a new list.
+		constexpr intrusive_list(intrusive_list&& r) noexcept;
+
+		// Moves the elements of a list into this one, which must be empty.
+		constexpr intrusive_list& operator=(intrusive_list&& r) noexcept;
+
+		// Gets whether the list is empty.
+		constexpr bool empty() const;
+
+		// Adds an element to the front of the list.
+		constexpr void push_front(T& element);
+		// Removes an element from the list.
+		constexpr void erase(T& element);
+		// Makes an unlinked element take the place of an element in the list.
+		constexpr void replace(T& old_element, T& new_element);
+
+		// Calls a function on every element of the list.
+		template <std::invocable<T&> Fn> constexpr void for_each(Fn fn) const;
+		// Unlinks every element of the list, calling a function on each one after it is unlinked.
+		template <std::invocable<T&> Fn> constexpr void clear(Fn fn);
+
+	  private:
+		// The first element of the list.
+		T* m_head{nullptr};
+
+		// Gets the node of an element.
+		static constexpr intrusive_list_node<T>& node(T& element);
+	};
+} // namespace tr
+
+#include "impl/intrusive_list.hpp" // IWYU pragma: export
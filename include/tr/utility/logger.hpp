@@ -18,6 +18,17 @@
 //     - tr::logger log{tr::make_logger<tr::console_and_file_logger>("my_log", tr::user_directory() / "log" / "log.txt")};               //
 //       -> creates a logger that logs to <USER DIRECTORY>/log/log.txt AND to the console under the name "my_log"                        //
 //                                                                                                                                       //
+// tr::async_file_logger logs to a file asynchronously: logging only pushes the message into a bounded lock-free queue, and a background //
+// thread writes the queued messages to the file in batches. What happens to messages logged while the queue is full is decided by an    //
+// overflow policy. Fatal messages are written out before logging returns, and tr::flush_async_loggers() may be called to write out all  //
+// queued messages before a crash (this is also done automatically by std::terminate):                                                   //
+//     - tr::logger log{tr::make_logger<tr::async_file_logger>("log.txt")}                                                               //
+//       -> creates an asynchronous logger that logs to log.txt, dropping and counting messages when its queue is full                   //
+//     - tr::logger log{tr::make_logger<tr::async_file_logger>("log.txt", tr::log_overflow_policy::block, 4096)}                         //
+//       -> creates an asynchronous logger with a queue of 4096 messages that waits for space in the queue when it is full               //
+//     - backend.flush() -> waits until all messages logged so far are written to the file                                               //
+//     - backend.dropped() -> gets the number of messages dropped so far                                                                 //
+//                                                                                                                                       //
 // A logger may be default-constructed (in which case it will be inactive), constructed with a backend unique pointer, or constructed    //
 // with tr::make_logger, which creates a backend in-place:                                                                               //
 //     - tr::logger log{} -> creates an inactive logger                                                                                  //
@@ -52,6 +63,7 @@
 
 #pragma once
 #include "common.hpp"
+#include "integer.hpp"
 
 ////////////////////////////////////////////////////////////////// LOGGER /////////////////////////////////////////////////////////////////
 
@@ -104,8 +116,8 @@ namespace tr {
 		void log_continue(std::string_view string) override;
 
 	  private:
-		// Path to the log file.
-		std::filesystem::path m_path;
+		// The log file.
+		std::ofstream m_file;
 	};
 	// Joint console and file logger backend.
 	class console_and_file_logger : public console_logger, public file_logger {
@@ -119,6 +131,89 @@ namespace tr {
 		void log_continue(std::string_view string) override;
 	};
 
+	// Policies for handling messages logged into a full asynchronous logger queue.
+	enum class log_overflow_policy {
+		drop,  // The message is silently dropped.
+		block, // The logging thread waits until there is space in the queue.
+		count  // The message is dropped, and the number of dropped messages is logged once there is space in the queue.
+	};
+	// Asynchronous file logger backend.
+	class async_file_logger : public logger_backend {
+	  public:
+		// The default capacity of the message queue.
+		static constexpr usize default_capacity{1024};
+
+		// Creates an asynchronous file logger.
+		async_file_logger(std::filesystem::path&& path, log_overflow_policy policy = log_overflow_policy::count,
+						  usize capacity = default_capacity);
+		// Writes out all remaining messages and destroys the logger.
+		~async_file_logger() override;
+
+		// Queues a message or message beginning.
+		void log(const std::tm& time, severity severity, std::string_view string) override;
+		// Queues a message continuation.
+		void log_continue(std::string_view string) override;
+
+		// Waits until all messages queued so far are written to the file.
+		void flush();
+		// Gets the number of messages that were dropped because the queue was full.
+		usize dropped() const;
+
+	  private:
+		// Queued log message.
+		struct record {
+			// The time the message was logged at.
+			std::tm time;
+			// The severity of the message.
+			tr::severity severity;
+			// Whether the message is a continuation of a previous one.
+			bool continuation;
+			// The message string.
+			std::string string;
+		};
+		// Slot in the message queue.
+		struct slot {
+			// Sequence number used to synchronize producers and the writer.
+			std::atomic<usize> sequence;
+			// The record in the slot.
+			record value;
+		};
+
+		// The log file. Only accessed by the writer thread after construction.
+		std::ofstream m_file;
+		// The overflow policy of the logger.
+		log_overflow_policy m_policy;
+		// The message queue ring buffer.
+		std::unique_ptr<slot[]> m_slots;
+		// Mask used to get the slot of a position in the queue.
+		usize m_mask;
+		// The position the next message will be pushed into.
+		alignas(64) std::atomic<usize> m_push_position{0};
+		// The number of messages written to the file so far.
+		alignas(64) std::atomic<usize> m_written{0};
+		// The number of messages dropped so far.
+		std::atomic<usize> m_dropped{0};
+		// Counter signaled whenever the writer thread has new work.
+		std::atomic<u32> m_signal{0};
+		// The position the writer will pop the next message from. Only accessed by the writer thread.
+		usize m_pop_position{0};
+		// The writer thread.
+		std::jthread m_writer;
+
+		// Pushes a record into the queue according to the overflow policy.
+		void push(record&& value);
+		// Tries to push a record into the queue, failing if it is full.
+		bool try_push(record& value);
+		// Tries to pop a record from the queue, failing if it is empty.
+		bool try_pop(record& value);
+		// Wakes the writer thread.
+		void signal_writer();
+		// Writer thread loop.
+		void writer_loop(std::stop_token stoken);
+	};
+	// Writes out all queued messages of all asynchronous loggers.
+	void flush_async_loggers();
+
 	// Flexible logger class.
 	class logger {
 	  public:
@@ -131,11 +131,11 @@ namespace tr {
 
 	// Static string binary reader.
 	template <usize Capacity> struct binary_reader<static_string<Capacity>> {
-		void operator()(std::istream& is, static_string<Capacity>& out) const;
+		template <binary_source Source> void operator()(Source& is, static_string<Capacity>& out) const;
 	};
 	// Static string binary writer.
 	template <usize Capacity> struct binary_writer<static_string<Capacity>> {
-		void operator()(std::ostream& os, const static_string<Capacity>& in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const static_string<Capacity>& in) const;
 	};
 
 } // namespace tr
@@ -177,11 +177,11 @@ namespace tr {
 
 	// Static vector binary reader.
 	template <binary_constructible Element, usize Capacity> struct binary_reader<static_vector<Element, Capacity>> {
-		void operator()(std::istream& is, static_vector<Element, Capacity>& out) const;
+		template <binary_source Source> void operator()(Source& is, static_vector<Element, Capacity>& out) const;
 	};
 	// Static vector binary writer.
 	template <binary_writable Element, usize Capacity> struct binary_writer<static_vector<Element, Capacity>> {
-		void operator()(std::ostream& os, const static_vector<Element, Capacity>& in) const;
+		template <binary_sink Sink> void operator()(Sink& os, const static_vector<Element, Capacity>& in) const;
 	};
 } // namespace tr
 
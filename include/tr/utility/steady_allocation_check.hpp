@@ -0,0 +1,43 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Provides a check that a steady workload doesn't allocate.                                                                             //
+//                                                                                                                                       //
+// tr::steady_allocation_check is fed values describing the work done during a frame (for example, the sizes of the primitives added     //
+// to a renderer), which are combined into a fingerprint of the frame. When the frame ends, the number of allocations made so far is     //
+// passed in, and the check fails if the fingerprint matches the previous frame's, but the number of allocations grew anyway:            //
+//     - check.add_workload(layer); check.add_workload(count) -> adds the layer and count of some primitives to the fingerprint          //
+//     - check.end_frame(allocations) -> false if the frame repeated the previous one, but allocated                                     //
+//                                                                                                                                       //
+// Operations that may allocate without that being visible in the fingerprint (for example, clearing a cache) can mark the frame as      //
+// one that shouldn't be compared to the one before or after it:                                                                         //
+//     - check.invalidate() -> the current frame isn't checked, and doesn't count as a previous frame for the next one                   //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "common.hpp"
+
+//////////////////////////////////////////////////////////////// INTERFACE ////////////////////////////////////////////////////////////////
+
+namespace tr {
+	// Check that repeating the workload of a frame doesn't allocate.
+	class steady_allocation_check {
+	  public:
+		// Adds a value describing the workload of the current frame to its fingerprint.
+		template <typename T> void add_workload(const T& value);
+		// Marks the current frame as one that isn't compared to its neighbours.
+		void invalidate();
+		// Ends the current frame, returning false if its workload matched the previous frame's, but storage was allocated anyway.
+		bool end_frame(usize allocations);
+
+	  private:
+		// The fingerprint of the workload of the current frame.
+		usize m_workload{0};
+		// Whether the current frame was invalidated.
+		bool m_invalidated{false};
+		// The fingerprint of the workload of the previous frame (or std::nullopt if it was invalidated).
+		std::optional<usize> m_last_workload;
+		// The number of allocations made by the end of the previous frame.
+		usize m_last_allocations{0};
+	};
+} // namespace tr
+
+#include "impl/steady_allocation_check.hpp" // IWYU pragma: export
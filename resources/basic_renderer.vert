@@ -1,13 +1,24 @@
 #version 450
 
-layout(location = 0) uniform mat4 transform;
+struct draw_info {
+	mat4 transform;
+	vec4 tint;
+	vec4 texture_info;
+};
+
+layout(std430, binding = 0) readonly buffer draw_info_buffer
+{
+	draw_info draws[];
+};
 
 layout(location = 0) in vec2 position;
 layout(location = 1) in vec2 uv;
 layout(location = 2) in vec4 color;
+layout(location = 3) in float draw_index;
 
 layout(location = 0) out vec2 output_uv;
 layout(location = 1) out vec4 output_color;
+layout(location = 2) flat out vec3 output_texture_info;
 out gl_PerVertex
 {
 	vec4 gl_Position;
@@ -15,7 +26,9 @@ out gl_PerVertex
 
 void main()
 {
+	draw_info draw = draws[int(draw_index)];
 	output_uv = uv;
-	output_color = color;
-	gl_Position = transform * vec4(position, 0, 1);
+	output_color = color * draw.tint;
+	output_texture_info = draw.texture_info.xyz;
+	gl_Position = draw.transform * vec4(position, 0, 1);
 }
\ No newline at end of file
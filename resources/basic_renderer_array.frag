@@ -0,0 +1,29 @@
+#version 450
+
+layout(location = 1) uniform sampler2D tex;
+layout(location = 2) uniform sampler2DArray tex_array;
+
+layout(location = 0) in vec2 uv;
+layout(location = 1) in vec4 color;
+layout(location = 2) flat in vec3 texture_info;
+
+layout(location = 0) out vec4 output_color;
+
+vec4 sample_texture_array()
+{
+	// The texture only occupies part of the layer, so it is clamped to its own edge to avoid sampling past it.
+	vec2 array_size = vec2(textureSize(tex_array, 0).xy);
+	vec2 texture_size = array_size * texture_info.xy;
+	vec2 array_uv = clamp(uv * texture_size, vec2(0.5), texture_size - 0.5) / array_size;
+	return texture(tex_array, vec3(array_uv, texture_info.z));
+}
+
+void main()
+{
+	if (uv.x == -100) {
+		output_color = color;
+	}
+	else {
+		output_color = color * (texture_info.z < 0 ? texture(tex, uv) : sample_texture_array());
+	}
+}
\ No newline at end of file
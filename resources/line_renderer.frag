@@ -0,0 +1,50 @@
+#version 450
+
+layout(location = 0) in vec2 local_position;
+layout(location = 1) flat in float segment_length;
+layout(location = 2) flat in float half_width;
+layout(location = 3) flat in int start_cap;
+layout(location = 4) flat in int end_cap;
+layout(location = 5) flat in vec4 color;
+layout(location = 6) flat in vec2 start_join;
+layout(location = 7) flat in vec2 end_join;
+
+layout(location = 0) out vec4 output_color;
+
+const int SQUARE_CAP = 1;
+const int ROUND_CAP = 2;
+
+// Gets the signed distance from the edge of a cap, where x is the distance past the end of the segment.
+float cap_distance(int cap, vec2 position)
+{
+	switch (cap) {
+	case SQUARE_CAP:
+		return max(position.x - half_width, abs(position.y) - half_width);
+	case ROUND_CAP:
+		return length(position) - half_width;
+	default: // Butt cap.
+		return max(position.x, abs(position.y) - half_width);
+	}
+}
+
+void main()
+{
+	// Fragments past the bisector of a join are drawn by the neighbouring segment instead.
+	if (dot(local_position, start_join) < 0 || dot(local_position - vec2(segment_length, 0), end_join) > 0) {
+		discard;
+	}
+
+	float distance;
+	if (local_position.x < 0) {
+		distance = cap_distance(start_cap, vec2(-local_position.x, local_position.y));
+	}
+	else if (local_position.x > segment_length) {
+		distance = cap_distance(end_cap, vec2(local_position.x - segment_length, local_position.y));
+	}
+	else {
+		distance = abs(local_position.y) - half_width;
+	}
+
+	const float transition_width = max(fwidth(distance), 1e-6);
+	output_color = vec4(color.rgb, color.a * clamp(0.5 - distance / transition_width, 0, 1));
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#version 450
+
+layout(location = 0) uniform mat4 transform;
+layout(location = 1) uniform float render_scale;
+
+layout(location = 0) in vec2 relative_vertex_position;
+layout(location = 1) in vec2 segment_start;
+layout(location = 2) in vec2 segment_end;
+layout(location = 3) in float segment_width;
+layout(location = 4) in vec4 segment_color;
+layout(location = 5) in float segment_caps;
+layout(location = 6) in vec2 segment_start_join;
+layout(location = 7) in vec2 segment_end_join;
+
+layout(location = 0) out vec2 output_local_position;
+layout(location = 1) flat out float output_length;
+layout(location = 2) flat out float output_half_width;
+layout(location = 3) flat out int output_start_cap;
+layout(location = 4) flat out int output_end_cap;
+layout(location = 5) flat out vec4 output_color;
+layout(location = 6) flat out vec2 output_start_join;
+layout(location = 7) flat out vec2 output_end_join;
+out gl_PerVertex
+{
+	vec4 gl_Position;
+};
+
+const int BUTT_CAP = 0;
+
+void main()
+{
+	const vec2 segment = segment_end - segment_start;
+	const float segment_length = length(segment);
+	const vec2 direction = segment_length > 0 ? segment / segment_length : vec2(1, 0);
+	const vec2 normal = vec2(-direction.y, direction.x);
+	const int start_cap = int(segment_caps) & 3;
+	const int end_cap = int(segment_caps) >> 2;
+	const float half_width = segment_width / 2;
+	const float margin = 1 / render_scale;
+
+	// The bounding box of the segment in its own coordinate space, where the x axis runs along the segment from its start.
+	const float start_extent = (start_cap == BUTT_CAP ? 0 : half_width) + margin;
+	const float end_extent = (end_cap == BUTT_CAP ? 0 : half_width) + margin;
+	const vec2 local_position = vec2(mix(-start_extent, segment_length + end_extent, relative_vertex_position.x),
+									 mix(-half_width - margin, half_width + margin, relative_vertex_position.y));
+
+	output_local_position = local_position;
+	output_length = segment_length;
+	output_half_width = half_width;
+	output_start_cap = start_cap;
+	output_end_cap = end_cap;
+	output_color = segment_color;
+	output_start_join = vec2(dot(segment_start_join, direction), dot(segment_start_join, normal));
+	output_end_join = vec2(dot(segment_end_join, direction), dot(segment_end_join, normal));
+	gl_Position = transform * vec4(segment_start + direction * local_position.x + normal * local_position.y, 0, 1);
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#version 450
+
+layout(location = 1) uniform sampler2D texture0;
+layout(location = 2) uniform sampler2D texture1;
+layout(location = 3) uniform sampler2D texture2;
+layout(location = 4) uniform sampler2D texture3;
+layout(location = 5) uniform sampler2D texture4;
+layout(location = 6) uniform sampler2D texture5;
+layout(location = 7) uniform sampler2D texture6;
+layout(location = 8) uniform sampler2D texture7;
+
+layout(location = 0) in vec2 uv;
+layout(location = 1) in vec4 tint;
+layout(location = 2) flat in int texture_slot;
+
+layout(location = 0) out vec4 output_color;
+
+void main()
+{
+	// The texture slot can differ between neighbouring sprites, so the derivatives are taken outside of the branch.
+	const vec2 uv_dx = dFdx(uv);
+	const vec2 uv_dy = dFdy(uv);
+
+	switch (texture_slot) {
+	case 0:
+		output_color = textureGrad(texture0, uv, uv_dx, uv_dy) * tint;
+		break;
+	case 1:
+		output_color = textureGrad(texture1, uv, uv_dx, uv_dy) * tint;
+		break;
+	case 2:
+		output_color = textureGrad(texture2, uv, uv_dx, uv_dy) * tint;
+		break;
+	case 3:
+		output_color = textureGrad(texture3, uv, uv_dx, uv_dy) * tint;
+		break;
+	case 4:
+		output_color = textureGrad(texture4, uv, uv_dx, uv_dy) * tint;
+		break;
+	case 5:
+		output_color = textureGrad(texture5, uv, uv_dx, uv_dy) * tint;
+		break;
+	case 6:
+		output_color = textureGrad(texture6, uv, uv_dx, uv_dy) * tint;
+		break;
+	case 7:
+		output_color = textureGrad(texture7, uv, uv_dx, uv_dy) * tint;
+		break;
+	default:
+		output_color = tint;
+		break;
+	}
+}
\ No newline at end of file
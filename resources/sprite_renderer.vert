@@ -0,0 +1,31 @@
+#version 450
+
+layout(location = 0) uniform mat4 transform;
+
+layout(location = 0) in vec2 relative_vertex_position;
+layout(location = 1) in vec2 sprite_position;
+layout(location = 2) in vec2 sprite_size;
+layout(location = 3) in vec4 sprite_uvs;
+layout(location = 4) in vec4 sprite_tint;
+layout(location = 5) in float sprite_rotation;
+layout(location = 6) in float sprite_texture_slot;
+
+layout(location = 0) out vec2 output_uv;
+layout(location = 1) out vec4 output_tint;
+layout(location = 2) flat out int output_texture_slot;
+out gl_PerVertex
+{
+	vec4 gl_Position;
+};
+
+void main()
+{
+	const float angle = sprite_rotation * 6.28318530718;
+	const mat2 rotation = mat2(cos(angle), sin(angle), -sin(angle), cos(angle));
+	const vec2 offset_from_center = (relative_vertex_position - 0.5) * sprite_size;
+
+	output_uv = mix(sprite_uvs.xy, sprite_uvs.zw, relative_vertex_position);
+	output_tint = sprite_tint;
+	output_texture_slot = int(sprite_texture_slot);
+	gl_Position = transform * vec4(sprite_position + rotation * offset_from_center, 0, 1);
+}
\ No newline at end of file
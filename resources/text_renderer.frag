@@ -0,0 +1,15 @@
+#version 450
+
+layout(location = 0) uniform sampler2D atlas;
+
+layout(location = 0) in vec2 atlas_position;
+layout(location = 1) flat in vec4 color;
+
+layout(location = 0) out vec4 output_color;
+
+void main()
+{
+	// Glyphs are cached as white, so only the coverage stored in the alpha channel is used.
+	const float coverage = texture(atlas, atlas_position / vec2(textureSize(atlas, 0))).a;
+	output_color = vec4(color.rgb, color.a * coverage);
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#version 450
+
+layout(location = 0) uniform mat4 transform;
+
+layout(location = 0) in vec2 relative_vertex_position;
+layout(location = 1) in vec2 glyph_position;
+layout(location = 2) in vec4 glyph_atlas_rect;
+layout(location = 3) in vec4 glyph_color;
+
+layout(location = 0) out vec2 output_atlas_position;
+layout(location = 1) flat out vec4 output_color;
+out gl_PerVertex
+{
+	vec4 gl_Position;
+};
+
+void main()
+{
+	const vec2 offset = relative_vertex_position * glyph_atlas_rect.zw;
+
+	output_atlas_position = glyph_atlas_rect.xy + offset;
+	output_color = glyph_color;
+	gl_Position = transform * vec4(glyph_position + offset, 0, 1);
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#version 450
+
+layout(location = 0) uniform sampler2D tileset;
+
+layout(location = 0) in vec2 uv;
+
+layout(location = 0) out vec4 output_color;
+
+void main()
+{
+	output_color = texture(tileset, uv);
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#version 450
+
+layout(location = 0) uniform mat4 transform;
+layout(location = 1) uniform vec2 tile_size;
+layout(location = 2) uniform int chunk_size;
+layout(location = 3) uniform ivec2 tileset_size;
+layout(location = 4) uniform vec2 chunk_position;
+
+layout(location = 0) in vec2 relative_vertex_position;
+layout(location = 1) in float tile;
+
+layout(location = 0) out vec2 output_uv;
+out gl_PerVertex
+{
+	vec4 gl_Position;
+};
+
+const int EMPTY_TILE = 65535;
+
+void main()
+{
+	const int tile_index = int(tile);
+	if (tile_index == EMPTY_TILE) {
+		// All vertices of empty tiles are collapsed into a single point outside of the clip volume.
+		output_uv = vec2(0);
+		gl_Position = vec4(2, 2, 2, 1);
+		return;
+	}
+
+	const vec2 tile_in_chunk = vec2(gl_InstanceID % chunk_size, gl_InstanceID / chunk_size);
+	const vec2 tile_in_tileset = vec2(tile_index % tileset_size.x, tile_index / tileset_size.x);
+
+	output_uv = (tile_in_tileset + relative_vertex_position) / vec2(tileset_size);
+	gl_Position = transform * vec4(chunk_position + (tile_in_chunk + relative_vertex_position) * tile_size, 0, 1);
+}
\ No newline at end of file
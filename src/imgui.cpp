@@ -58,5 +58,8 @@ void tr::ImGui::NewFrame()
 void tr::ImGui::Draw(graphics_context& context)
 {
 	(void)context.should_setup_renderer(renderer_id::imgui_renderer);
+	// ImGui draws with raw OpenGL calls, so out-of-date mipmaps aren't regenerated for it by the context's drawing functions.
+	context.generate_dirty_mipmaps();
 	ImGui_ImplOpenGL3_RenderDrawData(::ImGui::GetDrawData());
+	context.invalidate_shadow_state();
 }
\ No newline at end of file
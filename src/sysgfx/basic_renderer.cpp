@@ -1,6 +1,6 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                                                                                                                       //
-// Implements the renderer from basic_renderer.hpp.                                                                                      //
+// Implements the renderer and recorder from basic_renderer.hpp.                                                                         //
 //                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -10,6 +10,7 @@
 #include "../../include/tr/sysgfx/texture.hpp"
 #include "../../include/tr/utility/draw_geometry.hpp"
 #include "../../include/tr/utility/hash_map.hpp"
+#include "clip_outcode.hpp"
 
 // Untextured UV sentinel.
 constexpr glm::vec2 untextured_uv{-100, -100};
@@ -22,30 +23,256 @@ namespace tr {
 #include <generated/basic_renderer_vert.hpp>
 // Fragment shader source code.
 #include <generated/basic_renderer_frag.hpp>
+// Fragment shader source code used when batching with texture arrays.
+#include <generated/basic_renderer_array_frag.hpp>
+
+		// Vertex bindings of the renderer in the separate layout: positions, UVs, tints, and an instanced index into the per-draw
+		// information.
+		constexpr std::array<vertex_binding, 4> separate_vertex_bindings{{
+			{not_instanced, as_vertex_attribute_list<glm::vec2>},
+			{not_instanced, as_vertex_attribute_list<glm::vec2>},
+			{not_instanced, as_vertex_attribute_list<rgba8>},
+			{1, as_vertex_attribute_list<u32>},
+		}};
+		// Vertex bindings of the renderer in the interleaved layout: vertices and an instanced index into the per-draw information.
+		// The attribute locations match the separate layout, so both layouts share the same shaders.
+		constexpr std::array<vertex_binding, 2> interleaved_vertex_bindings{{
+			{not_instanced, as_vertex_attribute_list<basic_renderer_vertex>},
+			{1, as_vertex_attribute_list<u32>},
+		}};
+
+		// Gets a writable range over the positions of a run of vertices.
+		basic_renderer_attribute_range<glm::vec2> positions_of(std::span<basic_renderer_vertex> vertices)
+		{
+			return std::views::transform(vertices, &basic_renderer_vertex::position);
+		}
+
+		// Gets a writable range over the UVs of a run of vertices.
+		basic_renderer_attribute_range<glm::vec2> uvs_of(std::span<basic_renderer_vertex> vertices)
+		{
+			return std::views::transform(vertices, &basic_renderer_vertex::uv);
+		}
+
+		// Gets a writable range over the tints of a run of vertices.
+		basic_renderer_attribute_range<rgba8> tints_of(std::span<basic_renderer_vertex> vertices)
+		{
+			return std::views::transform(vertices, &basic_renderer_vertex::tint);
+		}
+
+		// Resizes a vector, counting an allocation if it has to grow its capacity to do so.
+		template <typename T> void resize_counted(std::vector<T>& vec, usize size, const std::type_identity_t<T>& value, usize& allocations)
+		{
+			if (size > vec.capacity()) {
+				++allocations;
+			}
+			vec.resize(size, value);
+		}
+
+		// Counts an allocation if a vector has to grow its capacity to fit another element.
+		template <typename T> void count_push(const std::vector<T>& vec, usize& allocations)
+		{
+			if (vec.size() == vec.capacity()) {
+				++allocations;
+			}
+		}
+
+		// Inserts or assigns an element of a hash map, counting an allocation if the map has to rehash to fit a new key.
+		template <typename Map>
+		void insert_or_assign_counted(Map& map, const typename Map::key_type& key, typename Map::mapped_type value, usize& allocations)
+		{
+			if (map.size() >= map.max_load() && !map.contains(key)) {
+				++allocations;
+			}
+			map.insert_or_assign(key, std::move(value));
+		}
+
+		// Gets an element of a hash map, default-constructing it if needed and counting an allocation if the map has to rehash to fit it.
+		template <typename Map> typename Map::mapped_type& get_counted(Map& map, const typename Map::key_type& key, usize& allocations)
+		{
+			if (map.size() >= map.max_load() && !map.contains(key)) {
+				++allocations;
+			}
+			return map[key];
+		}
+
+		// The value the vertices of untextured primitives are initialized to.
+		constexpr basic_renderer_vertex untextured_vertex{{}, untextured_uv, {}};
+
+		// Storage appended to the end of a mesh.
+		struct appended_storage {
+			// The appended vertices.
+			std::span<basic_renderer_vertex> vertices;
+			// The appended indices.
+			std::ranges::subrange<std::vector<u32>::iterator> indices;
+			// The index of the first appended vertex.
+			u32 base_index;
+		};
+
+		// Appends storage for vertices and indices to a mesh (either a renderer mesh or a recorded one).
+		template <typename Mesh>
+		appended_storage append_storage(Mesh& mesh, usize vertices, usize indices, const basic_renderer_vertex& value, usize& allocations)
+		{
+			const u32 base_index{u32(mesh.vertices.size())};
+			resize_counted(mesh.vertices, mesh.vertices.size() + vertices, value, allocations);
+			resize_counted(mesh.indices, mesh.indices.size() + indices, 0, allocations);
+			return {std::span{mesh.vertices}.last(vertices), {mesh.indices.end() - indices, mesh.indices.end()}, base_index};
+		}
+
+		// Appends a color fan to a mesh.
+		template <typename Mesh> simple_color_mesh_ref append_color_fan(Mesh& mesh, usize vertices, usize& allocations)
+		{
+			const appended_storage storage{append_storage(mesh, vertices, polygon_indices(vertices), untextured_vertex, allocations)};
+			fill_convex_polygon_indices(storage.indices.begin(), vertices, storage.base_index);
+			return {positions_of(storage.vertices), tints_of(storage.vertices)};
+		}
+
+		// Appends a color polygon outline to a mesh.
+		template <typename Mesh> simple_color_mesh_ref append_color_outline(Mesh& mesh, usize polygon_vertices, usize& allocations)
+		{
+			const usize vertices{polygon_vertices * 2};
+			const usize indices{polygon_outline_indices(polygon_vertices)};
+			const appended_storage storage{append_storage(mesh, vertices, indices, untextured_vertex, allocations)};
+			fill_convex_polygon_outline_indices(storage.indices.begin(), polygon_vertices, storage.base_index);
+			return {positions_of(storage.vertices), tints_of(storage.vertices)};
+		}
+
+		// Appends a color mesh (of triangles or lines, depending on the mesh) to a mesh.
+		template <typename Mesh> color_mesh_ref append_color_mesh(Mesh& mesh, usize vertices, usize indices, usize& allocations)
+		{
+			const appended_storage storage{append_storage(mesh, vertices, indices, untextured_vertex, allocations)};
+			return {positions_of(storage.vertices), tints_of(storage.vertices), storage.indices, storage.base_index};
+		}
+
+		// Appends a textured fan to a mesh.
+		template <typename Mesh> simple_textured_mesh_ref append_textured_fan(Mesh& mesh, usize vertices, usize& allocations)
+		{
+			const appended_storage storage{append_storage(mesh, vertices, polygon_indices(vertices), {}, allocations)};
+			fill_convex_polygon_indices(storage.indices.begin(), vertices, storage.base_index);
+			return {positions_of(storage.vertices), uvs_of(storage.vertices), tints_of(storage.vertices)};
+		}
+
+		// Appends a textured mesh to a mesh.
+		template <typename Mesh> textured_mesh_ref append_textured_mesh(Mesh& mesh, usize vertices, usize indices, usize& allocations)
+		{
+			const appended_storage storage{append_storage(mesh, vertices, indices, {}, allocations)};
+			return {positions_of(storage.vertices), uvs_of(storage.vertices), tints_of(storage.vertices), storage.indices,
+					storage.base_index};
+		}
+
+		// Appends a number of color lines to a mesh.
+		template <typename Mesh> simple_color_mesh_ref append_lines(Mesh& mesh, usize lines, usize& allocations)
+		{
+			const appended_storage storage{append_storage(mesh, lines * 2, lines * 2, untextured_vertex, allocations)};
+			std::iota(storage.indices.begin(), storage.indices.end(), storage.base_index);
+			return {positions_of(storage.vertices), tints_of(storage.vertices)};
+		}
+
+		// Appends a color line strip to a mesh.
+		template <typename Mesh> simple_color_mesh_ref append_line_strip(Mesh& mesh, usize vertices, usize& allocations)
+		{
+			const appended_storage storage{append_storage(mesh, vertices, line_strip_indices(vertices), untextured_vertex, allocations)};
+			fill_line_strip_indices(storage.indices.begin(), vertices, storage.base_index);
+			return {positions_of(storage.vertices), tints_of(storage.vertices)};
+		}
+
+		// Appends a color line loop to a mesh.
+		template <typename Mesh> simple_color_mesh_ref append_line_loop(Mesh& mesh, usize vertices, usize& allocations)
+		{
+			const appended_storage storage{append_storage(mesh, vertices, line_loop_indices(vertices), untextured_vertex, allocations)};
+			fill_line_loop_indices(storage.indices.begin(), vertices, storage.base_index);
+			return {positions_of(storage.vertices), tints_of(storage.vertices)};
+		}
+
+		// Uploads the indices of a retained mesh, narrowing them to 16 bits if the mesh is small enough.
+		static_index_buffer make_static_index_buffer(graphics_context& context, std::span<const u32> indices, usize vertices,
+													 usize& allocations)
+		{
+			if (vertices > UINT16_MAX) {
+				return static_index_buffer{context, indices};
+			}
+
+			if (!indices.empty()) {
+				++allocations;
+			}
+			std::vector<u16> narrowed(indices.size());
+			std::ranges::transform(indices, narrowed.begin(), [](u32 index) { return u16(index); });
+			return static_index_buffer{context, std::span<const u16>{narrowed}};
+		}
 	} // namespace
 } // namespace tr
 
-tr::basic_renderer::basic_renderer(graphics_context& context)
+tr::basic_renderer::basic_renderer(graphics_context& context, index_format max_index_format, tr::vertex_layout layout,
+									tr::texture_batching batching)
 	: m_id{context.allocate_renderer_id()}
-	, m_pipeline{context, vertex_shader{context, basic_renderer_vert}, fragment_shader{context, basic_renderer_frag}}
-	, m_vbuffer_positions{context}
-	, m_vbuffer_uvs{context}
-	, m_vbuffer_tints{context}
-	, m_ibuffer{context}
+	, m_max_mesh_vertices{max_index_format == index_format::u32 ? UINT32_MAX : UINT16_MAX}
+	, m_vertex_layout{layout}
+	, m_texture_batching{batching}
+	, m_pipeline{context, vertex_shader{context, basic_renderer_vert},
+				 fragment_shader{context, batching == tr::texture_batching::texture_arrays ? basic_renderer_array_frag
+																						   : basic_renderer_frag}}
+	, m_vertex_format{context, layout == tr::vertex_layout::interleaved ? std::span<const vertex_binding>{interleaved_vertex_bindings}
+																		 : std::span<const vertex_binding>{separate_vertex_bindings}}
+	, m_stream_buffer{context}
 {
 	m_pipeline.set_label("(tr) Basic Renderer Pipeline");
 	m_pipeline.vertex_shader().set_label("(tr) Basic Renderer Vertex Shader");
 	m_pipeline.fragment_shader().set_label("(tr) Basic Renderer Fragment Shader");
-	m_vbuffer_positions.set_label("(tr) Basic Renderer Vertex Position Buffer");
-	m_vbuffer_uvs.set_label("(tr) Basic Renderer Vertex UV Buffer");
-	m_vbuffer_tints.set_label("(tr) Basic Renderer Vertex Tint Buffer");
-	m_ibuffer.set_label("(tr) Basic Renderer Index Buffer");
+	m_vertex_format.set_label("(tr) Basic Renderer Vertex Format");
+	m_stream_buffer.set_label("(tr) Basic Renderer Stream Buffer");
+
+	// Both samplers need to be assigned distinct texture units before drawing, even if one of them ends up unused.
+	if (batching == tr::texture_batching::texture_arrays) {
+		m_pipeline.fragment_shader().set_uniform(1, texture_ref{});
+		m_pipeline.fragment_shader().set_uniform(2, texture_ref{});
+	}
+}
+
+//
+
+tr::graphics_context& tr::basic_renderer::context() const
+{
+	return m_pipeline.context();
+}
+
+tr::vertex_layout tr::basic_renderer::vertex_layout() const
+{
+	return m_vertex_layout;
+}
 
-	m_pipeline.vertex_shader().set_uniform(0, glm::mat4{1.0f});
+tr::texture_batching tr::basic_renderer::texture_batching() const
+{
+	return m_texture_batching;
+}
+
+tr::usize tr::basic_renderer::allocations() const
+{
+	return m_allocations;
+}
+
+tr::culling tr::basic_renderer::culling() const
+{
+	return m_culling;
+}
+
+tr::usize tr::basic_renderer::culled_meshes() const
+{
+	return m_culled_meshes;
+}
+
+tr::usize tr::basic_renderer::culled_primitives() const
+{
+	return m_culled_primitives;
 }
 
 //
 
+void tr::basic_renderer::set_culling(tr::culling culling)
+{
+	TR_ASSERT(!m_locked, "Tried to set culling of locked basic renderer.");
+
+	m_culling = culling;
+}
+
 void tr::basic_renderer::set_default_transform(const glm::mat4& mat)
 {
 	TR_ASSERT(!m_locked, "Tried to set default transform of locked basic renderer.");
@@ -57,21 +284,30 @@ void tr::basic_renderer::set_default_layer_texture(int layer, texture_ref textur
 {
 	TR_ASSERT(!m_locked, "Tried to set default layer texture of locked basic renderer.");
 
-	m_layer_defaults[layer].texture = std::move(texture);
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.add_workload(layer);
+#endif
+	get_counted(m_layer_defaults, layer, m_allocations).texture = std::move(texture);
 }
 
 void tr::basic_renderer::set_default_layer_transform(int layer, const glm::mat4& mat)
 {
 	TR_ASSERT(!m_locked, "Tried to set default layer transform of locked basic renderer.");
 
-	m_layer_defaults[layer].transform = mat;
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.add_workload(layer);
+#endif
+	get_counted(m_layer_defaults, layer, m_allocations).transform = mat;
 }
 
 void tr::basic_renderer::set_default_layer_blend_mode(int layer, const blend_mode& blend_mode)
 {
 	TR_ASSERT(!m_locked, "Tried to set default layer blending mode of locked basic renderer.");
 
-	m_layer_defaults[layer].blend_mode = blend_mode;
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.add_workload(layer);
+#endif
+	get_counted(m_layer_defaults, layer, m_allocations).blend_mode = blend_mode;
 }
 
 //
@@ -92,24 +328,7 @@ tr::simple_color_mesh_ref tr::basic_renderer::new_color_fan(int layer, usize ver
 {
 	TR_ASSERT(!m_locked, "Tried to allocate a new color fan on a locked basic renderer.");
 
-	mesh& mesh{find_mesh(layer, primitive::tris, std::nullopt, mat, blend_mode, vertices)};
-	const u16 base_index{u16(mesh.positions.size())};
-	const usize indices{polygon_indices(vertices)};
-
-	mesh.positions.resize(mesh.positions.size() + vertices);
-	mesh.uvs.resize(mesh.uvs.size() + vertices);
-	mesh.tints.resize(mesh.tints.size() + vertices);
-	mesh.indices.resize(mesh.indices.size() + indices);
-
-	const std::ranges::subrange positions{mesh.positions.end() - vertices, mesh.positions.end()};
-	const std::ranges::subrange uvs{mesh.uvs.end() - vertices, mesh.uvs.end()};
-	const std::ranges::subrange colors{mesh.tints.end() - vertices, mesh.tints.end()};
-	const std::ranges::subrange index_range{mesh.indices.end() - indices, mesh.indices.end()};
-
-	std::ranges::fill(uvs, untextured_uv);
-	fill_convex_polygon_indices(index_range.begin(), vertices, base_index);
-
-	return {positions, colors};
+	return append_color_fan(find_mesh(layer, primitive::tris, std::nullopt, mat, blend_mode, vertices), vertices, m_allocations);
 }
 
 tr::simple_color_mesh_ref tr::basic_renderer::new_color_outline(int layer, usize vertices)
@@ -129,25 +348,8 @@ tr::simple_color_mesh_ref tr::basic_renderer::new_color_outline(int layer, usize
 {
 	TR_ASSERT(!m_locked, "Tried to allocate a new color outline on a locked basic renderer.");
 
-	const usize vertices{polygon_vertices * 2};
-	mesh& mesh{find_mesh(layer, primitive::tris, std::nullopt, mat, blend_mode, vertices)};
-	const u16 base_index{u16(mesh.positions.size())};
-	const usize indices{polygon_outline_indices(polygon_vertices)};
-
-	mesh.positions.resize(mesh.positions.size() + vertices);
-	mesh.uvs.resize(mesh.uvs.size() + vertices);
-	mesh.tints.resize(mesh.tints.size() + vertices);
-	mesh.indices.resize(mesh.indices.size() + indices);
-
-	const std::ranges::subrange positions{mesh.positions.end() - vertices, mesh.positions.end()};
-	const std::ranges::subrange uvs{mesh.uvs.end() - vertices, mesh.uvs.end()};
-	const std::ranges::subrange colors{mesh.tints.end() - vertices, mesh.tints.end()};
-	const std::ranges::subrange index_range{mesh.indices.end() - indices, mesh.indices.end()};
-
-	std::ranges::fill(uvs, untextured_uv);
-	fill_convex_polygon_outline_indices(index_range.begin(), polygon_vertices, base_index);
-
-	return {positions, colors};
+	mesh& mesh{find_mesh(layer, primitive::tris, std::nullopt, mat, blend_mode, polygon_vertices * 2)};
+	return append_color_outline(mesh, polygon_vertices, m_allocations);
 }
 
 tr::color_mesh_ref tr::basic_renderer::new_color_mesh(int layer, usize vertices, usize indices)
@@ -168,21 +370,7 @@ tr::color_mesh_ref tr::basic_renderer::new_color_mesh(int layer, usize vertices,
 	TR_ASSERT(!m_locked, "Tried to allocate a new color mesh on a locked basic renderer.");
 
 	mesh& mesh{find_mesh(layer, primitive::tris, std::nullopt, mat, blend_mode, vertices)};
-	const u16 base_index{static_cast<u16>(mesh.positions.size())};
-
-	mesh.positions.resize(mesh.positions.size() + vertices);
-	mesh.uvs.resize(mesh.uvs.size() + vertices);
-	mesh.tints.resize(mesh.tints.size() + vertices);
-	mesh.indices.resize(mesh.indices.size() + indices);
-
-	const std::ranges::subrange positions{mesh.positions.end() - vertices, mesh.positions.end()};
-	const std::ranges::subrange uvs{mesh.uvs.end() - vertices, mesh.uvs.end()};
-	const std::ranges::subrange colors{mesh.tints.end() - vertices, mesh.tints.end()};
-	const std::ranges::subrange index_range{mesh.indices.end() - indices, mesh.indices.end()};
-
-	std::ranges::fill(uvs, untextured_uv);
-
-	return {positions, colors, index_range, base_index};
+	return append_color_mesh(mesh, vertices, indices, m_allocations);
 }
 
 tr::simple_textured_mesh_ref tr::basic_renderer::new_textured_fan(int layer, usize vertices)
@@ -216,22 +404,7 @@ tr::simple_textured_mesh_ref tr::basic_renderer::new_textured_fan(int layer, usi
 	TR_ASSERT(!texture_ref.empty(), "Cannot pass std::nullopt as texture for textured fan.");
 
 	mesh& mesh{find_mesh(layer, primitive::tris, std::move(texture_ref), mat, blend_mode, vertices)};
-	const u16 base_index{static_cast<u16>(mesh.positions.size())};
-	const usize indices{polygon_indices(vertices)};
-
-	mesh.positions.resize(mesh.positions.size() + vertices);
-	mesh.uvs.resize(mesh.uvs.size() + vertices);
-	mesh.tints.resize(mesh.tints.size() + vertices);
-	mesh.indices.resize(mesh.indices.size() + indices);
-
-	const std::ranges::subrange positions{mesh.positions.end() - vertices, mesh.positions.end()};
-	const std::ranges::subrange uvs{mesh.uvs.end() - vertices, mesh.uvs.end()};
-	const std::ranges::subrange tints{mesh.tints.end() - vertices, mesh.tints.end()};
-	const std::ranges::subrange index_range{mesh.indices.end() - indices, mesh.indices.end()};
-
-	fill_convex_polygon_indices(index_range.begin(), vertices, base_index);
-
-	return {positions, uvs, tints};
+	return append_textured_fan(mesh, vertices, m_allocations);
 }
 
 tr::textured_mesh_ref tr::basic_renderer::new_textured_mesh(int layer, usize vertices, usize indices)
@@ -265,19 +438,7 @@ tr::textured_mesh_ref tr::basic_renderer::new_textured_mesh(int layer, usize ver
 	TR_ASSERT(!texture_ref.empty(), "Cannot pass std::nullopt as texture for textured mesh.");
 
 	mesh& mesh{find_mesh(layer, primitive::tris, std::move(texture_ref), mat, blend_mode, vertices)};
-	const u16 base_index{static_cast<u16>(mesh.positions.size())};
-
-	mesh.positions.resize(mesh.positions.size() + vertices);
-	mesh.uvs.resize(mesh.uvs.size() + vertices);
-	mesh.tints.resize(mesh.tints.size() + vertices);
-	mesh.indices.resize(mesh.indices.size() + indices);
-
-	const std::ranges::subrange positions{mesh.positions.end() - vertices, mesh.positions.end()};
-	const std::ranges::subrange uvs{mesh.uvs.end() - vertices, mesh.uvs.end()};
-	const std::ranges::subrange tints{mesh.tints.end() - vertices, mesh.tints.end()};
-	const std::ranges::subrange index_range{mesh.indices.end() - indices, mesh.indices.end()};
-
-	return {positions, uvs, tints, index_range, base_index};
+	return append_textured_mesh(mesh, vertices, indices, m_allocations);
 }
 
 //
@@ -298,24 +459,7 @@ tr::simple_color_mesh_ref tr::basic_renderer::new_lines(int layer, usize lines,
 {
 	TR_ASSERT(!m_locked, "Tried to allocate a new lines on a locked basic renderer.");
 
-	const usize vertices{lines * 2};
-	mesh& mesh{find_mesh(layer, primitive::lines, std::nullopt, mat, blend_mode, vertices)};
-	const u16 base_index{static_cast<u16>(mesh.positions.size())};
-
-	mesh.positions.resize(mesh.positions.size() + vertices);
-	mesh.uvs.resize(mesh.uvs.size() + vertices);
-	mesh.tints.resize(mesh.tints.size() + vertices);
-	mesh.indices.resize(mesh.indices.size() + vertices);
-
-	const std::ranges::subrange positions{mesh.positions.end() - vertices, mesh.positions.end()};
-	const std::ranges::subrange uvs{mesh.uvs.end() - vertices, mesh.uvs.end()};
-	const std::ranges::subrange colors{mesh.tints.end() - vertices, mesh.tints.end()};
-	const std::ranges::subrange index_range{mesh.indices.end() - vertices, mesh.indices.end()};
-
-	std::ranges::fill(uvs, untextured_uv);
-	std::iota(index_range.begin(), index_range.end(), base_index);
-
-	return {positions, colors};
+	return append_lines(find_mesh(layer, primitive::lines, std::nullopt, mat, blend_mode, lines * 2), lines, m_allocations);
 }
 
 tr::simple_color_mesh_ref tr::basic_renderer::new_line_strip(int layer, usize vertices)
@@ -334,24 +478,7 @@ tr::simple_color_mesh_ref tr::basic_renderer::new_line_strip(int layer, usize ve
 {
 	TR_ASSERT(!m_locked, "Tried to allocate a new line strip on a locked basic renderer.");
 
-	mesh& mesh{find_mesh(layer, primitive::lines, std::nullopt, mat, blend_mode, vertices)};
-	const u16 base_index{static_cast<u16>(mesh.positions.size())};
-	const usize indices{line_strip_indices(vertices)};
-
-	mesh.positions.resize(mesh.positions.size() + vertices);
-	mesh.uvs.resize(mesh.uvs.size() + vertices);
-	mesh.tints.resize(mesh.tints.size() + vertices);
-	mesh.indices.resize(mesh.indices.size() + indices);
-
-	const std::ranges::subrange positions{mesh.positions.end() - vertices, mesh.positions.end()};
-	const std::ranges::subrange uvs{mesh.uvs.end() - vertices, mesh.uvs.end()};
-	const std::ranges::subrange colors{mesh.tints.end() - vertices, mesh.tints.end()};
-	const std::ranges::subrange index_range{mesh.indices.end() - indices, mesh.indices.end()};
-
-	std::ranges::fill(uvs, untextured_uv);
-	fill_line_strip_indices(index_range.begin(), vertices, base_index);
-
-	return {positions, colors};
+	return append_line_strip(find_mesh(layer, primitive::lines, std::nullopt, mat, blend_mode, vertices), vertices, m_allocations);
 }
 
 tr::simple_color_mesh_ref tr::basic_renderer::new_line_loop(int layer, usize vertices)
@@ -370,24 +497,7 @@ tr::simple_color_mesh_ref tr::basic_renderer::new_line_loop(int layer, usize ver
 {
 	TR_ASSERT(!m_locked, "Tried to allocate a new line loop on a locked basic renderer.");
 
-	mesh& mesh{find_mesh(layer, primitive::lines, std::nullopt, mat, blend_mode, vertices)};
-	const u16 base_index{static_cast<u16>(mesh.positions.size())};
-	const usize indices{line_loop_indices(vertices)};
-
-	mesh.positions.resize(mesh.positions.size() + vertices);
-	mesh.uvs.resize(mesh.uvs.size() + vertices);
-	mesh.tints.resize(mesh.tints.size() + vertices);
-	mesh.indices.resize(mesh.indices.size() + indices);
-
-	const std::ranges::subrange positions{mesh.positions.end() - vertices, mesh.positions.end()};
-	const std::ranges::subrange uvs{mesh.uvs.end() - vertices, mesh.uvs.end()};
-	const std::ranges::subrange colors{mesh.tints.end() - vertices, mesh.tints.end()};
-	const std::ranges::subrange index_range{mesh.indices.end() - indices, mesh.indices.end()};
-
-	std::ranges::fill(uvs, untextured_uv);
-	fill_line_loop_indices(index_range.begin(), vertices, base_index);
-
-	return {positions, colors};
+	return append_line_loop(find_mesh(layer, primitive::lines, std::nullopt, mat, blend_mode, vertices), vertices, m_allocations);
 }
 
 tr::color_mesh_ref tr::basic_renderer::new_line_mesh(int layer, usize vertices, usize indices)
@@ -408,35 +518,116 @@ tr::color_mesh_ref tr::basic_renderer::new_line_mesh(int layer, usize vertices,
 	TR_ASSERT(!m_locked, "Tried to allocate a new line mesh on a locked basic renderer.");
 
 	mesh& mesh{find_mesh(layer, primitive::lines, std::nullopt, mat, blend_mode, vertices)};
-	const u16 base_index{static_cast<u16>(mesh.positions.size())};
+	return append_color_mesh(mesh, vertices, indices, m_allocations);
+}
+
+//
+
+tr::basic_renderer::static_mesh_id tr::basic_renderer::new_static_color_mesh(int layer, primitive type,
+																			  std::span<const glm::vec2> positions,
+																			  std::span<const tr::rgba8> colors, std::span<const u32> indices)
+{
+	const opt_ref<const layer_defaults> defaults{try_get(m_layer_defaults, layer)};
+	if (defaults.has_ref()) {
+		const glm::mat4& transform{defaults->transform.has_value() ? *defaults->transform : m_default_transform};
+		return new_static_color_mesh(layer, type, positions, colors, indices, transform, defaults->blend_mode);
+	}
+	else {
+		return new_static_color_mesh(layer, type, positions, colors, indices, m_default_transform, alpha_blending);
+	}
+}
+
+tr::basic_renderer::static_mesh_id tr::basic_renderer::new_static_color_mesh(int layer, primitive type,
+																			  std::span<const glm::vec2> positions,
+																			  std::span<const tr::rgba8> colors, std::span<const u32> indices,
+																			  const glm::mat4& mat, const blend_mode& blend_mode)
+{
+	TR_ASSERT(!m_locked, "Tried to register a new static color mesh on a locked basic renderer.");
+
+	if (!positions.empty()) {
+		++m_allocations;
+	}
+	const std::vector<glm::vec2> uvs(positions.size(), untextured_uv);
+	return add_static_mesh(layer, type, std::nullopt, mat, blend_mode, positions, uvs, colors, indices);
+}
+
+tr::basic_renderer::static_mesh_id tr::basic_renderer::new_static_textured_mesh(int layer, primitive type,
+																				 std::span<const glm::vec2> positions,
+																				 std::span<const glm::vec2> uvs,
+																				 std::span<const tr::rgba8> tints,
+																				 std::span<const u32> indices, texture_ref texture_ref)
+{
+	const opt_ref<const layer_defaults> defaults{try_get(m_layer_defaults, layer)};
+	if (defaults.has_ref()) {
+		const glm::mat4& transform{defaults->transform.has_value() ? *defaults->transform : m_default_transform};
+		return new_static_textured_mesh(layer, type, positions, uvs, tints, indices, std::move(texture_ref), transform,
+										defaults->blend_mode);
+	}
+	else {
+		return new_static_textured_mesh(layer, type, positions, uvs, tints, indices, std::move(texture_ref), m_default_transform,
+										alpha_blending);
+	}
+}
 
-	mesh.positions.resize(mesh.positions.size() + vertices);
-	mesh.uvs.resize(mesh.uvs.size() + vertices);
-	mesh.tints.resize(mesh.tints.size() + vertices);
-	mesh.indices.resize(mesh.indices.size() + indices);
+tr::basic_renderer::static_mesh_id tr::basic_renderer::new_static_textured_mesh(
+	int layer, primitive type, std::span<const glm::vec2> positions, std::span<const glm::vec2> uvs, std::span<const tr::rgba8> tints,
+	std::span<const u32> indices, texture_ref texture_ref, const glm::mat4& mat, const blend_mode& blend_mode)
+{
+	TR_ASSERT(!m_locked, "Tried to register a new static textured mesh on a locked basic renderer.");
 
-	const std::ranges::subrange positions{mesh.positions.end() - vertices, mesh.positions.end()};
-	const std::ranges::subrange uvs{mesh.uvs.end() - vertices, mesh.uvs.end()};
-	const std::ranges::subrange colors{mesh.tints.end() - vertices, mesh.tints.end()};
-	const std::ranges::subrange index_range{mesh.indices.end() - indices, mesh.indices.end()};
+	return add_static_mesh(layer, type, std::move(texture_ref), mat, blend_mode, positions, uvs, tints, indices);
+}
 
-	std::ranges::fill(uvs, untextured_uv);
+void tr::basic_renderer::set_static_mesh_transform(static_mesh_id id, const glm::mat4& mat)
+{
+	get_static_mesh(id).mat = mat;
+}
 
-	return {positions, colors, index_range, base_index};
+void tr::basic_renderer::set_static_mesh_tint(static_mesh_id id, tr::rgba8 tint)
+{
+	get_static_mesh(id).tint = tint;
+}
+
+void tr::basic_renderer::set_static_mesh_visible(static_mesh_id id, bool visible)
+{
+	get_static_mesh(id).visible = visible;
+}
+
+void tr::basic_renderer::free_static_mesh(static_mesh_id id)
+{
+	TR_ASSERT(!m_locked, "Tried to free a static mesh of a locked basic renderer.");
+	TR_ASSERT(usize(id) < m_static_meshes.size() && m_static_meshes[usize(id)].has_value(),
+			  "Tried to free nonexistent static mesh {} of basic renderer.", usize(id));
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.invalidate();
+#endif
+
+	m_static_meshes[usize(id)].reset();
+	count_push(m_free_static_mesh_ids, m_allocations);
+	m_free_static_mesh_ids.push_back(id);
+	m_static_mesh_order.erase(std::ranges::find(m_static_mesh_order, id));
 }
 
 //
 
 tr::basic_renderer::drawer tr::basic_renderer::create_drawer(int min_layer, int max_layer)
 {
+	sort_mesh_order();
+
+	const auto layer_of{[&](usize slot) { return m_meshes[slot].layer; }};
+	const auto static_layer_of{[&](static_mesh_id id) { return m_static_meshes[usize(id)]->layer; }};
 	return drawer{*this,
-				  {std::ranges::lower_bound(m_meshes, min_layer, std::less{}, &mesh::layer),
-				   std::ranges::upper_bound(m_meshes, max_layer, std::less{}, &mesh::layer)}};
+				  {std::ranges::lower_bound(m_mesh_order, min_layer, std::less{}, layer_of),
+				   std::ranges::upper_bound(m_mesh_order, max_layer, std::less{}, layer_of)},
+				  {std::ranges::lower_bound(m_static_mesh_order, min_layer, std::less{}, static_layer_of),
+				   std::ranges::upper_bound(m_static_mesh_order, max_layer, std::less{}, static_layer_of)}};
 }
 
 tr::basic_renderer::drawer tr::basic_renderer::create_drawer()
 {
-	return drawer{*this, m_meshes};
+	sort_mesh_order();
+
+	return drawer{*this, m_mesh_order, m_static_mesh_order};
 }
 
 void tr::basic_renderer::draw(const render_target& target)
@@ -444,33 +635,638 @@ void tr::basic_renderer::draw(const render_target& target)
 	create_drawer().draw(target);
 }
 
+void tr::basic_renderer::merge(recorder& recorder)
+{
+	TR_ASSERT(!m_locked, "Tried to merge a recorder into a locked basic renderer.");
+	TR_ASSERT(recorder.m_renderer.as_ptr() == this, "Tried to merge a recorder into a different basic renderer than its own.");
+
+	for (const recorder::recorded_mesh& recorded : std::span{recorder.m_meshes}.first(recorder.m_used_meshes)) {
+		const mesh_key& key{recorded.key};
+		texture_ref texture_ref;
+		if (key.texture != nullptr) {
+			texture_ref = *key.texture;
+		}
+
+		mesh& mesh{find_mesh(key.layer, key.type, std::move(texture_ref), key.mat, key.blend_mode, recorded.vertices.size())};
+		const u32 base_index{static_cast<u32>(mesh.vertices.size())};
+		const usize first_index{mesh.indices.size()};
+
+		resize_counted(mesh.vertices, mesh.vertices.size() + recorded.vertices.size(), {}, m_allocations);
+		resize_counted(mesh.indices, mesh.indices.size() + recorded.indices.size(), 0, m_allocations);
+
+		std::ranges::copy(recorded.vertices, mesh.vertices.begin() + base_index);
+		std::ranges::transform(recorded.indices, mesh.indices.begin() + first_index, [=](u32 index) { return index + base_index; });
+	}
+	recorder.clear();
+}
+
 //
 
+tr::usize tr::basic_renderer::mesh_key_hash::operator()(const mesh_key& key) const
+{
+	usize hash{boost::hash<int>{}(key.layer)};
+	boost::hash_combine(hash, key.type);
+	boost::hash_combine(hash, key.texture);
+	boost::hash_range(hash, &key.mat[0][0], &key.mat[0][0] + 16);
+	boost::hash_combine(hash, key.blend_mode.rgb_src);
+	boost::hash_combine(hash, key.blend_mode.rgb_fn);
+	boost::hash_combine(hash, key.blend_mode.rgb_dst);
+	boost::hash_combine(hash, key.blend_mode.alpha_src);
+	boost::hash_combine(hash, key.blend_mode.alpha_fn);
+	boost::hash_combine(hash, key.blend_mode.alpha_dst);
+	return hash;
+}
+
+const glm::mat4& tr::basic_renderer::layer_transform(int layer) const
+{
+	const opt_ref<const layer_defaults> defaults{try_get(m_layer_defaults, layer)};
+	return defaults.has_ref() && defaults->transform.has_value() ? *defaults->transform : m_default_transform;
+}
+
+const tr::blend_mode& tr::basic_renderer::layer_blend_mode(int layer) const
+{
+	const opt_ref<const layer_defaults> defaults{try_get(m_layer_defaults, layer)};
+	return defaults.has_ref() ? defaults->blend_mode : alpha_blending;
+}
+
+const tr::texture* tr::basic_renderer::layer_texture(int layer) const
+{
+	const opt_ref<const layer_defaults> defaults{try_get(m_layer_defaults, layer)};
+	return defaults.has_ref() && !defaults->texture.empty() ? &*defaults->texture : nullptr;
+}
+
 tr::basic_renderer::mesh& tr::basic_renderer::find_mesh(int layer, primitive type, texture_ref texture_ref, const glm::mat4& mat,
 														const blend_mode& blend_mode, usize space_needed)
 {
-	auto range{std::ranges::equal_range(m_meshes, layer, std::less{}, &mesh::layer)};
-	std::vector<mesh>::iterator mesh_it;
+	// The untextured entry of a batch points to the mesh untextured primitives are added to, which may be textured.
+	// Textured primitives can claim that mesh if it doesn't have a texture yet.
+	const auto has_space{[=](const mesh& mesh) { return mesh.vertices.size() + space_needed <= m_max_mesh_vertices; }};
+	const mesh_key untextured_key{layer, type, nullptr, mat, blend_mode};
+	const auto untextured_it{m_mesh_lookup.find(untextured_key)};
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.add_workload(mesh_key_hash{}({layer, type, texture_ref.empty() ? nullptr : &*texture_ref, mat, blend_mode}));
+	m_allocation_check.add_workload(texture_ref.empty() ? 0 : texture_ref->version().value_or(0));
+	m_allocation_check.add_workload(space_needed);
+#endif
+
 	if (texture_ref.empty()) {
-		auto find_suitable{[&](const mesh& mesh) {
-			return mesh.type == type && mesh.mat == mat && mesh.blend_mode == blend_mode &&
-				   mesh.positions.size() + space_needed <= UINT16_MAX;
-		}};
-		mesh_it = std::ranges::find_if(range, find_suitable);
+		if (untextured_it != m_mesh_lookup.end() && has_space(m_meshes[untextured_it->second])) {
+			return m_meshes[untextured_it->second];
+		}
+#ifdef TR_ENABLE_ASSERTS
+		// A second mesh with the same parameters doesn't have a slot of its own to come back to in the next frame.
+		if (untextured_it != m_mesh_lookup.end()) {
+			m_allocation_check.invalidate();
+		}
+#endif
+		const usize slot{allocate_mesh(layer, type, std::nullopt, mat, blend_mode, space_needed)};
+		insert_or_assign_counted(m_mesh_lookup, untextured_key, slot, m_allocations);
+		return m_meshes[slot];
+	}
+
+	const mesh_key key{layer, type, &*texture_ref, mat, blend_mode};
+	const auto it{m_mesh_lookup.find(key)};
+	if (it != m_mesh_lookup.end() && m_meshes[it->second].texture == texture_ref && has_space(m_meshes[it->second])) {
+		return m_meshes[it->second];
+	}
+	else if (untextured_it != m_mesh_lookup.end() && m_meshes[untextured_it->second].texture.empty() &&
+			 has_space(m_meshes[untextured_it->second])) {
+		// The mesh may have lost its texture by it being destroyed, in which case its old textured entry has to go.
+		const usize slot{untextured_it->second};
+		mesh& mesh{m_meshes[slot]};
+		if (mesh.lookup_texture != nullptr) {
+			const auto old_it{m_mesh_lookup.find({layer, type, mesh.lookup_texture, mat, blend_mode})};
+			if (old_it != m_mesh_lookup.end() && old_it->second == slot) {
+				m_mesh_lookup.erase(old_it);
+			}
+		}
+		mesh.texture = std::move(texture_ref);
+		mesh.lookup_texture = key.texture;
+		insert_or_assign_counted(m_mesh_lookup, key, slot, m_allocations);
+		return mesh;
 	}
 	else {
-		auto find_suitable{[&](const mesh& mesh) {
-			return mesh.type == type && (mesh.texture.empty() || mesh.texture == texture_ref) && mesh.mat == mat &&
-				   mesh.blend_mode == blend_mode && mesh.positions.size() + space_needed <= UINT16_MAX;
-		}};
-		mesh_it = std::ranges::find_if(range, find_suitable);
-		if (mesh_it != range.end() && mesh_it->texture.empty()) {
-			mesh_it->texture = std::move(texture_ref);
+#ifdef TR_ENABLE_ASSERTS
+		if (it != m_mesh_lookup.end()) {
+			m_allocation_check.invalidate();
+		}
+#endif
+		const bool no_untextured_mesh{untextured_it == m_mesh_lookup.end()};
+		const usize slot{allocate_mesh(layer, type, std::move(texture_ref), mat, blend_mode, space_needed)};
+		m_meshes[slot].lookup_texture = key.texture;
+		insert_or_assign_counted(m_mesh_lookup, key, slot, m_allocations);
+		if (no_untextured_mesh) {
+			insert_or_assign_counted(m_mesh_lookup, untextured_key, slot, m_allocations);
+		}
+		return m_meshes[slot];
+	}
+}
+
+tr::usize tr::basic_renderer::allocate_mesh(int layer, primitive type, texture_ref texture_ref, const glm::mat4& mat,
+											const blend_mode& blend_mode, usize space_needed)
+{
+	usize slot;
+	if (!m_free_slots.empty()) {
+		// A mesh with the same parameters as one freed by the latest drawers gets its slot back, as it's likely to be filled the same way.
+		// Otherwise, as free slots are sorted by capacity, the smallest one that fits is taken, or the largest one if none do.
+		const auto capacity_of{[&](usize free_slot) { return m_meshes[free_slot].vertices.capacity(); }};
+		const mesh_key key{layer, type, texture_ref.empty() ? nullptr : &*texture_ref, mat, blend_mode};
+		std::vector<usize>::iterator it;
+		if (const auto lookup_it{m_free_slot_lookup.find(key)}; lookup_it != m_free_slot_lookup.end()) {
+			const auto [first, last]{std::ranges::equal_range(m_free_slots, capacity_of(lookup_it->second), std::less{}, capacity_of)};
+			it = std::ranges::find(first, last, lookup_it->second);
+		}
+		else {
+			it = std::ranges::lower_bound(m_free_slots, space_needed, std::less{}, capacity_of);
+			if (it == m_free_slots.end()) {
+				--it;
+			}
+		}
+		slot = *it;
+		m_free_slots.erase(it);
+
+		mesh& mesh{m_meshes[slot]};
+		for (const mesh_key& k : {mesh_key{mesh.layer, mesh.type, nullptr, mesh.mat, mesh.blend_mode},
+								  mesh_key{mesh.layer, mesh.type, mesh.lookup_texture, mesh.mat, mesh.blend_mode}}) {
+			const auto lookup_it{m_free_slot_lookup.find(k)};
+			if (lookup_it != m_free_slot_lookup.end() && lookup_it->second == slot) {
+				m_free_slot_lookup.erase(lookup_it);
+			}
+		}
+		mesh.layer = layer;
+		mesh.type = type;
+		mesh.texture = std::move(texture_ref);
+		mesh.mat = mat;
+		mesh.blend_mode = blend_mode;
+		mesh.lookup_texture = nullptr;
+	}
+	else {
+		slot = m_meshes.size();
+		count_push(m_meshes, m_allocations);
+		m_meshes.emplace_back(layer, type, std::move(texture_ref), mat, blend_mode);
+	}
+
+	if (!m_mesh_order.empty() && m_meshes[m_mesh_order.back()].layer > layer) {
+		m_mesh_order_sorted = false;
+	}
+	count_push(m_mesh_order, m_allocations);
+	m_mesh_order.push_back(slot);
+	return slot;
+}
+
+void tr::basic_renderer::sort_mesh_order()
+{
+	if (!m_mesh_order_sorted) {
+		// std::stable_sort allocates a temporary buffer, so the creation order is instead made part of the sort key in persistent
+		// scratch storage.
+		if (m_mesh_order.size() > m_sort_scratch.capacity()) {
+			++m_allocations;
+		}
+		m_sort_scratch.clear();
+		for (usize i = 0; i < m_mesh_order.size(); ++i) {
+			m_sort_scratch.emplace_back(m_meshes[m_mesh_order[i]].layer, i, m_mesh_order[i]);
+		}
+		std::ranges::sort(m_sort_scratch);
+		std::ranges::copy(m_sort_scratch | std::views::elements<2>, m_mesh_order.begin());
+		m_mesh_order_sorted = true;
+	}
+}
+
+void tr::basic_renderer::free_meshes(std::ranges::subrange<std::vector<usize>::iterator> range)
+{
+	// When every mesh is freed, the lookups are cleared instead of having their entries erased one by one, which could eventually make
+	// them rehash even if the same meshes are used every frame. The free slot lookup is also rebuilt to only hold the freed meshes.
+	const bool freeing_all{range.size() == m_mesh_order.size()};
+	if (freeing_all) {
+		m_free_slot_lookup.clear();
+	}
+
+	for (usize slot : range) {
+		// The textured entry is rebuilt from the texture it was keyed on, as the texture may have been destroyed since. The keys of the
+		// entries that pointed to the mesh are remembered so that the next mesh allocated with the same parameters gets the slot back.
+		mesh& mesh{m_meshes[slot]};
+		const mesh_key untextured_key{mesh.layer, mesh.type, nullptr, mesh.mat, mesh.blend_mode};
+		const mesh_key key{mesh.layer, mesh.type, mesh.lookup_texture, mesh.mat, mesh.blend_mode};
+		for (const mesh_key& k : {untextured_key, key}) {
+			const auto it{m_mesh_lookup.find(k)};
+			if (it != m_mesh_lookup.end() && it->second == slot) {
+				if (!freeing_all) {
+					m_mesh_lookup.erase(it);
+				}
+				insert_or_assign_counted(m_free_slot_lookup, k, slot, m_allocations);
+			}
+		}
+
+		mesh.texture = std::nullopt;
+		mesh.vertices.clear();
+		mesh.indices.clear();
+		const auto capacity_of{[&](usize free_slot) { return m_meshes[free_slot].vertices.capacity(); }};
+		count_push(m_free_slots, m_allocations);
+		m_free_slots.insert(std::ranges::upper_bound(m_free_slots, mesh.vertices.capacity(), std::less{}, capacity_of), slot);
+	}
+	if (freeing_all) {
+		m_mesh_lookup.clear();
+	}
+	m_mesh_order.erase(range.begin(), range.end());
+}
+
+void tr::basic_renderer::cull_meshes(std::ranges::subrange<std::vector<usize>::iterator> range)
+{
+	m_culled_meshes = 0;
+	m_culled_primitives = 0;
+	if (m_culling == tr::culling::disabled) {
+		return;
+	}
+
+	// Culled geometry is only removed from the indices of a mesh, while a fully culled mesh is emptied and gets an empty draw.
+	for (usize slot : range) {
+		mesh& mesh{m_meshes[slot]};
+		const usize primitive_size{mesh.type == primitive::lines ? 2_uz : 3_uz};
+		if (mesh.vertices.empty()) {
+			continue;
+		}
+
+		if (m_culling == tr::culling::meshes) {
+			glm::vec2 min{mesh.vertices.front().position};
+			glm::vec2 max{min};
+			for (const basic_renderer_vertex& vertex : mesh.vertices) {
+				min = glm::min(min, vertex.position);
+				max = glm::max(max, vertex.position);
+			}
+			const u8 outcode{u8(clip_outcode(mesh.mat, min) & clip_outcode(mesh.mat, {max.x, min.y}) & clip_outcode(mesh.mat, max) &
+								clip_outcode(mesh.mat, {min.x, max.y}))};
+			if (outcode == 0) {
+				continue;
+			}
+		}
+		else {
+			resize_counted(m_outcode_scratch, mesh.vertices.size(), 0, m_allocations);
+			u8 mesh_outcode{0b1111};
+			for (usize i = 0; i < mesh.vertices.size(); ++i) {
+				m_outcode_scratch[i] = clip_outcode(mesh.mat, mesh.vertices[i].position);
+				mesh_outcode &= m_outcode_scratch[i];
+			}
+
+			if (mesh_outcode == 0) {
+				usize kept{0};
+				for (usize i = 0; i + primitive_size <= mesh.indices.size(); i += primitive_size) {
+					u8 outcode{0b1111};
+					for (usize j = i; j < i + primitive_size; ++j) {
+						outcode &= m_outcode_scratch[mesh.indices[j]];
+					}
+					if (outcode == 0) {
+						std::copy_n(mesh.indices.begin() + i, primitive_size, mesh.indices.begin() + kept);
+						kept += primitive_size;
+					}
+				}
+				m_culled_primitives += (mesh.indices.size() - kept) / primitive_size;
+				mesh.indices.resize(kept);
+				if (!mesh.indices.empty()) {
+					continue;
+				}
+			}
+		}
+
+		++m_culled_meshes;
+		m_culled_primitives += mesh.indices.size() / primitive_size;
+		mesh.vertices.clear();
+		mesh.indices.clear();
+	}
+}
+
+void tr::basic_renderer::release_batched_texture(const batched_texture& batched)
+{
+	if (batched.array.has_value()) {
+		m_texture_arrays[*batched.array].layers[batched.layer] = nullptr;
+	}
+}
+
+void tr::basic_renderer::batch_textures(std::ranges::subrange<std::vector<usize>::iterator> range)
+{
+	const u64 draw{++m_batch_draws};
+	for (usize slot : range) {
+		const texture_ref& texture_ref{m_meshes[slot].texture};
+		if (m_meshes[slot].indices.empty() || texture_ref.empty()) {
+			continue;
+		}
+		const texture& texture{*texture_ref};
+
+		// Textures that weren't modified since they were last gathered keep their layer and don't have to be checked or copied again.
+		if (const auto it{m_batched_textures.find(&texture)}; it != m_batched_textures.end()) {
+			batched_texture& batched{it->second};
+			if (batched.last_draw == draw || (batched.version.has_value() && batched.version == texture.version())) {
+				batched.last_draw = draw;
+				continue;
+			}
+			release_batched_texture(batched);
+			m_batched_textures.erase(it);
+		}
+
+		const glm::ivec2 size{texture.size()};
+		if (texture.empty() || size.x > max_batched_texture_size || size.y > max_batched_texture_size) {
+			continue;
 		}
+		if (!texture_array::layerable(texture)) {
+			const batched_texture rejected{texture.version(), std::nullopt, 0, {}, draw};
+			insert_or_assign_counted(m_batched_textures, &texture, rejected, m_allocations);
+			continue;
+		}
+
+		// Layers are free if they're unoccupied or their texture wasn't used in this draw, in which case it gets evicted.
+		const glm::ivec2 layer_size{int(std::bit_ceil(u32(size.x))), int(std::bit_ceil(u32(size.y)))};
+		const auto reusable{[&](const tr::texture* owner) { return owner == nullptr || m_batched_textures.at(owner).last_draw != draw; }};
+		usize array{0};
+		int layer{0};
+		for (; array < m_texture_arrays.size(); ++array) {
+			const texture_array_batch& batch{m_texture_arrays[array]};
+			if (batch.array.size() != layer_size) {
+				continue;
+			}
+			const auto it{std::ranges::find_if(batch.layers, reusable)};
+			if (it != batch.layers.end() && batch.array.compatible(texture)) {
+				layer = int(it - batch.layers.begin());
+				break;
+			}
+		}
+		if (array == m_texture_arrays.size()) {
+			const usize layer_bytes{usize(layer_size.x) * usize(layer_size.y) * 4};
+			const int layers{int(std::clamp(texture_array_bytes / layer_bytes, 1_uz, usize(max_texture_array_layers)))};
+			count_push(m_texture_arrays, m_allocations);
+			m_texture_arrays.emplace_back(texture_array{texture, layer_size, layers}, std::vector<const tr::texture*>{});
+			texture_array_batch& batch{m_texture_arrays.back()};
+			resize_counted(batch.layers, usize(layers), nullptr, m_allocations);
+			batch.array.set_label("(tr) Basic Renderer Texture Array");
+		}
+
+		texture_array_batch& batch{m_texture_arrays[array]};
+		if (batch.layers[layer] != nullptr) {
+			m_batched_textures.erase(batch.layers[layer]);
+		}
+		batch.layers[layer] = &texture;
+		batch.array.copy_to_layer(layer, {}, texture, {{}, size});
+		const batched_texture batched{texture.version(), array, layer, glm::vec2{size} / glm::vec2{layer_size}, draw};
+		insert_or_assign_counted(m_batched_textures, &texture, batched, m_allocations);
+	}
+
+	// Textures that can't be gathered don't hold onto a layer, so they're only remembered while they're being used.
+	boost::unordered::erase_if(m_batched_textures, [&](const auto& entry) {
+		return !entry.second.array.has_value() && entry.second.last_draw != draw;
+	});
+}
+
+tr::basic_renderer::static_mesh_id tr::basic_renderer::add_static_mesh(int layer, primitive type, texture_ref texture_ref,
+																		const glm::mat4& mat, const blend_mode& blend_mode,
+																		std::span<const glm::vec2> positions, std::span<const glm::vec2> uvs,
+																		std::span<const tr::rgba8> tints, std::span<const u32> indices)
+{
+	TR_ASSERT(positions.size() == uvs.size() && positions.size() == tints.size(),
+			  "Tried to register a static mesh with mismatched vertex data sizes ({} positions, {} UVs, {} tints).", positions.size(),
+			  uvs.size(), tints.size());
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.invalidate();
+#endif
+
+	graphics_context& context{this->context()};
+	static_mesh mesh{
+		layer,
+		type,
+		std::move(texture_ref),
+		mat,
+		blend_mode,
+		{255, 255, 255, 255},
+		true,
+		make_static_vertex_buffers(context, positions, uvs, tints),
+		make_static_index_buffer(context, indices, positions.size(), m_allocations),
+		indices.size(),
+	};
+
+	static_mesh_id id;
+	if (!m_free_static_mesh_ids.empty()) {
+		id = m_free_static_mesh_ids.back();
+		m_free_static_mesh_ids.pop_back();
+		m_static_meshes[usize(id)].emplace(std::move(mesh));
+	}
+	else {
+		id = static_mesh_id(m_static_meshes.size());
+		count_push(m_static_meshes, m_allocations);
+		m_static_meshes.emplace_back(std::move(mesh));
+	}
+
+	const auto layer_of{[&](static_mesh_id id) { return m_static_meshes[usize(id)]->layer; }};
+	count_push(m_static_mesh_order, m_allocations);
+	m_static_mesh_order.insert(std::ranges::upper_bound(m_static_mesh_order, layer, std::less{}, layer_of), id);
+	return id;
+}
+
+std::variant<tr::basic_renderer::static_attribute_buffers, tr::static_vertex_buffer<tr::basic_renderer_vertex>> tr::basic_renderer::
+	make_static_vertex_buffers(graphics_context& context, std::span<const glm::vec2> positions, std::span<const glm::vec2> uvs,
+							   std::span<const tr::rgba8> tints)
+{
+	if (m_vertex_layout == tr::vertex_layout::separate) {
+		return static_attribute_buffers{
+			static_vertex_buffer<glm::vec2>{context, positions},
+			static_vertex_buffer<glm::vec2>{context, uvs},
+			static_vertex_buffer<tr::rgba8>{context, tints},
+		};
+	}
+
+	if (!positions.empty()) {
+		++m_allocations;
+	}
+	std::vector<basic_renderer_vertex> vertices(positions.size());
+	for (usize i = 0; i < vertices.size(); ++i) {
+		vertices[i] = {positions[i], uvs[i], tints[i]};
+	}
+	return static_vertex_buffer<basic_renderer_vertex>{context, vertices};
+}
+
+tr::basic_renderer::static_mesh& tr::basic_renderer::get_static_mesh(static_mesh_id id)
+{
+	TR_ASSERT(usize(id) < m_static_meshes.size() && m_static_meshes[usize(id)].has_value(),
+			  "Tried to access nonexistent static mesh {} of basic renderer.", usize(id));
+
+	return *m_static_meshes[usize(id)];
+}
+
+///////////////////////////////////////////////////////////////// RECORDER ////////////////////////////////////////////////////////////////
+
+tr::basic_renderer::recorder::recorder(const basic_renderer& renderer)
+	: m_renderer{renderer}
+{
+}
+
+//
+
+tr::usize tr::basic_renderer::recorder::allocations() const
+{
+	return m_allocations;
+}
+
+//
+
+tr::simple_color_mesh_ref tr::basic_renderer::recorder::new_color_fan(int layer, usize vertices)
+{
+	return new_color_fan(layer, vertices, m_renderer->layer_transform(layer), m_renderer->layer_blend_mode(layer));
+}
+
+tr::simple_color_mesh_ref tr::basic_renderer::recorder::new_color_fan(int layer, usize vertices, const glm::mat4& mat,
+																	  const blend_mode& blend_mode)
+{
+	return append_color_fan(find_mesh({layer, primitive::tris, nullptr, mat, blend_mode}, vertices), vertices, m_allocations);
+}
+
+tr::simple_color_mesh_ref tr::basic_renderer::recorder::new_color_outline(int layer, usize vertices)
+{
+	return new_color_outline(layer, vertices, m_renderer->layer_transform(layer), m_renderer->layer_blend_mode(layer));
+}
+
+tr::simple_color_mesh_ref tr::basic_renderer::recorder::new_color_outline(int layer, usize polygon_vertices, const glm::mat4& mat,
+																		  const blend_mode& blend_mode)
+{
+	recorded_mesh& mesh{find_mesh({layer, primitive::tris, nullptr, mat, blend_mode}, polygon_vertices * 2)};
+	return append_color_outline(mesh, polygon_vertices, m_allocations);
+}
+
+tr::color_mesh_ref tr::basic_renderer::recorder::new_color_mesh(int layer, usize vertices, usize indices)
+{
+	return new_color_mesh(layer, vertices, indices, m_renderer->layer_transform(layer), m_renderer->layer_blend_mode(layer));
+}
+
+tr::color_mesh_ref tr::basic_renderer::recorder::new_color_mesh(int layer, usize vertices, usize indices, const glm::mat4& mat,
+																const blend_mode& blend_mode)
+{
+	recorded_mesh& mesh{find_mesh({layer, primitive::tris, nullptr, mat, blend_mode}, vertices)};
+	return append_color_mesh(mesh, vertices, indices, m_allocations);
+}
+
+tr::simple_textured_mesh_ref tr::basic_renderer::recorder::new_textured_fan(int layer, usize vertices)
+{
+	const texture* default_texture{m_renderer->layer_texture(layer)};
+	TR_ASSERT(default_texture != nullptr, "Tried to record a textured fan on a layer without a default texture.");
+
+	return new_textured_fan(layer, vertices, *default_texture, m_renderer->layer_transform(layer), m_renderer->layer_blend_mode(layer));
+}
+
+tr::simple_textured_mesh_ref tr::basic_renderer::recorder::new_textured_fan(int layer, usize vertices, const texture& texture)
+{
+	return new_textured_fan(layer, vertices, texture, m_renderer->layer_transform(layer), m_renderer->layer_blend_mode(layer));
+}
+
+tr::simple_textured_mesh_ref tr::basic_renderer::recorder::new_textured_fan(int layer, usize vertices, const texture& texture,
+																			const glm::mat4& mat, const blend_mode& blend_mode)
+{
+	return append_textured_fan(find_mesh({layer, primitive::tris, &texture, mat, blend_mode}, vertices), vertices, m_allocations);
+}
+
+tr::textured_mesh_ref tr::basic_renderer::recorder::new_textured_mesh(int layer, usize vertices, usize indices)
+{
+	const texture* default_texture{m_renderer->layer_texture(layer)};
+	TR_ASSERT(default_texture != nullptr, "Tried to record a textured mesh on a layer without a default texture.");
+
+	return new_textured_mesh(layer, vertices, indices, *default_texture, m_renderer->layer_transform(layer),
+							 m_renderer->layer_blend_mode(layer));
+}
+
+tr::textured_mesh_ref tr::basic_renderer::recorder::new_textured_mesh(int layer, usize vertices, usize indices, const texture& texture)
+{
+	return new_textured_mesh(layer, vertices, indices, texture, m_renderer->layer_transform(layer), m_renderer->layer_blend_mode(layer));
+}
+
+tr::textured_mesh_ref tr::basic_renderer::recorder::new_textured_mesh(int layer, usize vertices, usize indices, const texture& texture,
+																	  const glm::mat4& mat, const blend_mode& blend_mode)
+{
+	recorded_mesh& mesh{find_mesh({layer, primitive::tris, &texture, mat, blend_mode}, vertices)};
+	return append_textured_mesh(mesh, vertices, indices, m_allocations);
+}
+
+//
+
+tr::simple_color_mesh_ref tr::basic_renderer::recorder::new_lines(int layer, usize lines)
+{
+	return new_lines(layer, lines, m_renderer->layer_transform(layer), m_renderer->layer_blend_mode(layer));
+}
+
+tr::simple_color_mesh_ref tr::basic_renderer::recorder::new_lines(int layer, usize lines, const glm::mat4& mat,
+																  const blend_mode& blend_mode)
+{
+	return append_lines(find_mesh({layer, primitive::lines, nullptr, mat, blend_mode}, lines * 2), lines, m_allocations);
+}
+
+tr::simple_color_mesh_ref tr::basic_renderer::recorder::new_line_strip(int layer, usize vertices)
+{
+	return new_line_strip(layer, vertices, m_renderer->layer_transform(layer), m_renderer->layer_blend_mode(layer));
+}
+
+tr::simple_color_mesh_ref tr::basic_renderer::recorder::new_line_strip(int layer, usize vertices, const glm::mat4& mat,
+																	   const blend_mode& blend_mode)
+{
+	return append_line_strip(find_mesh({layer, primitive::lines, nullptr, mat, blend_mode}, vertices), vertices, m_allocations);
+}
+
+tr::simple_color_mesh_ref tr::basic_renderer::recorder::new_line_loop(int layer, usize vertices)
+{
+	return new_line_loop(layer, vertices, m_renderer->layer_transform(layer), m_renderer->layer_blend_mode(layer));
+}
+
+tr::simple_color_mesh_ref tr::basic_renderer::recorder::new_line_loop(int layer, usize vertices, const glm::mat4& mat,
+																	  const blend_mode& blend_mode)
+{
+	return append_line_loop(find_mesh({layer, primitive::lines, nullptr, mat, blend_mode}, vertices), vertices, m_allocations);
+}
+
+tr::color_mesh_ref tr::basic_renderer::recorder::new_line_mesh(int layer, usize vertices, usize indices)
+{
+	return new_line_mesh(layer, vertices, indices, m_renderer->layer_transform(layer), m_renderer->layer_blend_mode(layer));
+}
+
+tr::color_mesh_ref tr::basic_renderer::recorder::new_line_mesh(int layer, usize vertices, usize indices, const glm::mat4& mat,
+															   const blend_mode& blend_mode)
+{
+	recorded_mesh& mesh{find_mesh({layer, primitive::lines, nullptr, mat, blend_mode}, vertices)};
+	return append_color_mesh(mesh, vertices, indices, m_allocations);
+}
+
+//
+
+void tr::basic_renderer::recorder::clear()
+{
+	for (recorded_mesh& mesh : std::span{m_meshes}.first(m_used_meshes)) {
+#ifdef TR_ENABLE_ASSERTS
+		m_allocation_check.add_workload(mesh.vertices.size());
+		m_allocation_check.add_workload(mesh.indices.size());
+#endif
+		mesh.vertices.clear();
+		mesh.indices.clear();
+	}
+	m_used_meshes = 0;
+	m_mesh_lookup.clear();
+
+#ifdef TR_ENABLE_ASSERTS
+	const bool steady{m_allocation_check.end_frame(m_allocations)};
+	TR_ASSERT(steady, "A basic renderer recorder allocated storage while recording the same workload as before it was last cleared.");
+#endif
+}
+
+//
+
+tr::basic_renderer::recorder::recorded_mesh& tr::basic_renderer::recorder::find_mesh(const mesh_key& key, usize space_needed)
+{
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.add_workload(mesh_key_hash{}(key));
+	m_allocation_check.add_workload(space_needed);
+#endif
+
+	const auto it{m_mesh_lookup.find(key)};
+	if (it != m_mesh_lookup.end() && m_meshes[it->second].vertices.size() + space_needed <= m_renderer->m_max_mesh_vertices) {
+		return m_meshes[it->second];
 	}
 
-	if (mesh_it == range.end()) {
-		mesh_it = m_meshes.emplace(range.end(), layer, type, std::move(texture_ref), mat, blend_mode);
+	if (m_used_meshes == m_meshes.size()) {
+		count_push(m_meshes, m_allocations);
+		m_meshes.emplace_back();
 	}
-	return *mesh_it;
+	recorded_mesh& mesh{m_meshes[m_used_meshes]};
+	mesh.key = key;
+	insert_or_assign_counted(m_mesh_lookup, key, m_used_meshes++, m_allocations);
+	return mesh;
 }
\ No newline at end of file
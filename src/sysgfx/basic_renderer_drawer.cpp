@@ -8,41 +8,142 @@
 
 ////////////////////////////////////////////////////////////////// DRAWER /////////////////////////////////////////////////////////////////
 
-tr::basic_renderer::drawer::drawer(basic_renderer& renderer, std::ranges::subrange<std::vector<mesh>::iterator> range)
+tr::basic_renderer::drawer::drawer(basic_renderer& renderer, std::ranges::subrange<std::vector<usize>::iterator> range,
+								   std::ranges::subrange<std::vector<static_mesh_id>::iterator> static_range)
 	: m_renderer{renderer}
 	, m_range{range}
+	, m_static_range{static_range}
+	, m_index_formats{std::move(renderer.m_index_formats)}
 {
 #ifdef TR_ENABLE_ASSERTS
 	TR_ASSERT(!m_renderer->m_locked, "Tried to create multiple simultaneous basic renderer drawers.");
 	m_renderer->m_locked = true;
+	// How much the storage of the meshes grew depends on their final sizes, which the primitives added to them don't fully describe.
+	for (usize slot : m_range) {
+		m_renderer->m_allocation_check.add_workload(m_renderer->m_meshes[slot].vertices.size());
+		m_renderer->m_allocation_check.add_workload(m_renderer->m_meshes[slot].indices.size());
+	}
+	m_renderer->m_allocation_check.add_workload(m_renderer->m_culling);
 #endif
 
-	const usize vertices{fold_left(range, 0_uz, [](usize s, const mesh& m) { return s + m.positions.size(); })};
-	const usize indices{fold_left(range, 0_uz, [](usize s, const mesh& m) { return s + m.indices.size(); })};
+	m_renderer->cull_meshes(m_range);
+	if (m_range.empty() && m_static_range.empty()) {
+		return;
+	}
 
-	m_renderer->m_vbuffer_positions.resize(vertices);
-	m_renderer->m_vbuffer_uvs.resize(vertices);
-	m_renderer->m_vbuffer_tints.resize(vertices);
-	m_renderer->m_ibuffer.resize(indices);
+	// Meshes small enough for 16-bit indices are uploaded with them, the rest fall back to 32-bit indices.
+	const std::vector<mesh>& meshes{m_renderer->m_meshes};
+	usize vertices{0};
+	usize u32_indices{0};
+	usize u16_indices{0};
+	m_index_formats.clear();
+	if (m_range.size() > m_index_formats.capacity()) {
+		++m_renderer->m_allocations;
+		m_index_formats.reserve(m_range.size());
+	}
+	for (usize slot : range) {
+		m_index_formats.push_back(index_format_of(meshes[slot]));
+		vertices += meshes[slot].vertices.size();
+		if (m_index_formats.back() == index_format::u32) {
+			u32_indices += meshes[slot].indices.size();
+		}
+		else {
+			u16_indices += meshes[slot].indices.size();
+		}
+	}
+	if (m_renderer->m_texture_batching == tr::texture_batching::texture_arrays) {
+		m_renderer->batch_textures(m_range);
+	}
+	// Every mesh gets a draw, followed by every retained mesh.
+	const usize draws{m_range.size() + m_static_range.size()};
+
+	// The per-draw information is placed first to satisfy the storage buffer offset alignment, after which the blocks are laid out so
+	// that only the 32-bit index block may need padding.
+	const usize storage_buffer_alignment{m_renderer->context().storage_buffer_offset_alignment()};
+	const bool interleaved{m_renderer->m_vertex_layout == tr::vertex_layout::interleaved};
+	stream_buffer& stream{m_renderer->m_stream_buffer};
+	stream.begin_region(draws * (sizeof(draw_info) + sizeof(indexed_draw_command) + sizeof(u32)) +
+						vertices * sizeof(basic_renderer_vertex) + u32_indices * sizeof(u32) + u16_indices * sizeof(u16) +
+						storage_buffer_alignment + alignof(u32));
+	m_offsets.draw_infos = stream.allocate(draws * sizeof(draw_info), storage_buffer_alignment);
+	if (interleaved) {
+		m_offsets.vertices = stream.allocate<basic_renderer_vertex>(vertices);
+	}
+	else {
+		m_offsets.positions = stream.allocate<glm::vec2>(vertices);
+		m_offsets.uvs = stream.allocate<glm::vec2>(vertices);
+		m_offsets.tints = stream.allocate<rgba8>(vertices);
+	}
+	m_offsets.commands = stream.allocate<indexed_draw_command>(draws);
+	m_offsets.draw_indices = stream.allocate<u32>(draws);
+	m_offsets.u32_indices = stream.allocate<u32>(u32_indices);
+	m_offsets.u16_indices = stream.allocate<u16>(u16_indices);
+
+	const std::span<draw_info> draw_infos{stream.mapped<draw_info>(m_offsets.draw_infos, draws)};
+	const std::span<basic_renderer_vertex> interleaved_vertices{
+		interleaved ? stream.mapped<basic_renderer_vertex>(m_offsets.vertices, vertices) : std::span<basic_renderer_vertex>{}};
+	const std::span<glm::vec2> positions{!interleaved ? stream.mapped<glm::vec2>(m_offsets.positions, vertices) : std::span<glm::vec2>{}};
+	const std::span<glm::vec2> uvs{!interleaved ? stream.mapped<glm::vec2>(m_offsets.uvs, vertices) : std::span<glm::vec2>{}};
+	const std::span<rgba8> tints{!interleaved ? stream.mapped<rgba8>(m_offsets.tints, vertices) : std::span<rgba8>{}};
+	const std::span<indexed_draw_command> commands{stream.mapped<indexed_draw_command>(m_offsets.commands, draws)};
+	const std::span<u32> draw_indices{stream.mapped<u32>(m_offsets.draw_indices, draws)};
+	const std::span<u32> mapped_u32_indices{stream.mapped<u32>(m_offsets.u32_indices, u32_indices)};
+	const std::span<u16> mapped_u16_indices{stream.mapped<u16>(m_offsets.u16_indices, u16_indices)};
+
+	std::iota(draw_indices.begin(), draw_indices.end(), 0u);
+
+	usize draw{0};
+	usize vertex_offset{0};
+	usize u32_offset{0};
+	usize u16_offset{0};
+	for (usize slot : range) {
+		const mesh& mesh{meshes[slot]};
+
+		if (interleaved) {
+			std::ranges::copy(mesh.vertices, interleaved_vertices.begin() + vertex_offset);
+		}
+		else {
+			std::ranges::transform(mesh.vertices, positions.begin() + vertex_offset, &basic_renderer_vertex::position);
+			std::ranges::transform(mesh.vertices, uvs.begin() + vertex_offset, &basic_renderer_vertex::uv);
+			std::ranges::transform(mesh.vertices, tints.begin() + vertex_offset, &basic_renderer_vertex::tint);
+		}
+		const batched_texture* batched{batched_texture_of(mesh)};
+		const glm::vec4 texture_info{batched != nullptr ? glm::vec4{batched->scale, batched->layer, 0} : glm::vec4{1, 1, -1, 0}};
+		draw_infos[draw] = {mesh.mat, glm::vec4{1.0f}, texture_info};
+		if (m_index_formats[draw] == index_format::u32) {
+			std::ranges::copy(mesh.indices, mapped_u32_indices.begin() + u32_offset);
+			commands[draw] = {u32(mesh.indices.size()), 1, u32(m_offsets.u32_indices / sizeof(u32) + u32_offset), i32(vertex_offset),
+							  u32(draw)};
+			u32_offset += mesh.indices.size();
+		}
+		else {
+			std::ranges::transform(mesh.indices, mapped_u16_indices.begin() + u16_offset, [](u32 index) { return u16(index); });
+			commands[draw] = {u32(mesh.indices.size()), 1, u32(m_offsets.u16_indices / sizeof(u16) + u16_offset), i32(vertex_offset),
+							  u32(draw)};
+			u16_offset += mesh.indices.size();
+		}
+		vertex_offset += mesh.vertices.size();
+		++draw;
+	}
 
-	m_data.emplace_back(0, 0);
-	for (const mesh& mesh : range) {
-		const mesh_draw_info start{m_data.back()};
+	for (static_mesh_id id : static_range) {
+		const static_mesh& mesh{*m_renderer->m_static_meshes[usize(id)]};
+		const rgbaf tint{mesh.tint};
 
-		m_renderer->m_vbuffer_positions.set_region(start.vertex_offset, mesh.positions);
-		m_renderer->m_vbuffer_uvs.set_region(start.vertex_offset, mesh.uvs);
-		m_renderer->m_vbuffer_tints.set_region(start.vertex_offset, mesh.tints);
-		m_renderer->m_ibuffer.set_region(start.index_offset, mesh.indices);
-		m_data.emplace_back(start.vertex_offset + mesh.positions.size(), start.index_offset + mesh.indices.size());
+		draw_infos[draw] = {mesh.mat, glm::vec4{tint.r, tint.g, tint.b, tint.a}, glm::vec4{1, 1, -1, 0}};
+		commands[draw] = {u32(mesh.index_count), 1, 0, 0, u32(draw)};
+		++draw;
 	}
-
-	m_renderer->context().set_index_buffer(m_renderer->m_ibuffer);
 }
 
 tr::basic_renderer::drawer::drawer(drawer&& r) noexcept
 	: m_renderer{std::exchange(r.m_renderer, std::nullopt)}
 	, m_range{r.m_range}
-	, m_data{std::move(r.m_data)}
+	, m_static_range{r.m_static_range}
+	, m_index_formats{std::move(r.m_index_formats)}
+	, m_offsets{r.m_offsets}
+	, m_draw_data_bound{r.m_draw_data_bound}
+	, m_bound_index_format{r.m_bound_index_format}
 {
 }
 
@@ -56,7 +157,11 @@ tr::basic_renderer::drawer& tr::basic_renderer::drawer::operator=(drawer&& r) no
 	clean_up();
 	m_renderer = std::exchange(r.m_renderer, std::nullopt);
 	m_range = r.m_range;
-	m_data = std::move(r.m_data);
+	m_static_range = r.m_static_range;
+	m_index_formats = std::move(r.m_index_formats);
+	m_offsets = r.m_offsets;
+	m_draw_data_bound = r.m_draw_data_bound;
+	m_bound_index_format = r.m_bound_index_format;
 	return *this;
 }
 
@@ -64,12 +169,22 @@ tr::basic_renderer::drawer& tr::basic_renderer::drawer::operator=(drawer&& r) no
 
 int tr::basic_renderer::drawer::min_layer() const
 {
-	return !m_range.empty() ? m_range.front().layer : INT_MAX;
+	const int min_layer{!m_range.empty() ? layer_of(m_range.front()) : INT_MAX};
+	return !m_static_range.empty() ? std::min(min_layer, layer_of(m_static_range.front())) : min_layer;
 }
 
 int tr::basic_renderer::drawer::max_layer() const
 {
-	return !m_range.empty() ? m_range.back().layer : INT_MIN;
+	const int max_layer{!m_range.empty() ? layer_of(m_range.back()) : INT_MIN};
+	return !m_static_range.empty() ? std::max(max_layer, layer_of(m_static_range.back())) : max_layer;
+}
+
+int tr::basic_renderer::drawer::next_layer(int layer) const
+{
+	const auto layer_of{[this](auto slot_or_id) { return this->layer_of(slot_or_id); }};
+	const auto it{std::ranges::lower_bound(m_range, layer, std::less{}, layer_of)};
+	const auto static_it{std::ranges::lower_bound(m_static_range, layer, std::less{}, layer_of)};
+	return std::min(it != m_range.end() ? layer_of(*it) : INT_MAX, static_it != m_static_range.end() ? layer_of(*static_it) : INT_MAX);
 }
 
 //
@@ -78,8 +193,10 @@ void tr::basic_renderer::drawer::draw_layer(int layer, const render_target& targ
 {
 	TR_ASSERT(m_renderer.has_ref(), "Tried to draw a layer from a moved-from basic renderer drawer.");
 
-	const auto range{std::ranges::equal_range(m_range, layer, std::less{}, &mesh::layer)};
-	if (range.empty()) {
+	const auto layer_of{[this](auto slot_or_id) { return this->layer_of(slot_or_id); }};
+	const auto range{std::ranges::equal_range(m_range, layer, std::less{}, layer_of)};
+	const auto static_range{std::ranges::equal_range(m_static_range, layer, std::less{}, layer_of)};
+	if (range.empty() && static_range.empty()) {
 		return;
 	}
 
@@ -88,25 +205,18 @@ void tr::basic_renderer::drawer::draw_layer(int layer, const render_target& targ
 	setup_context(context);
 	context.set_render_target(target);
 
-	std::vector<mesh_draw_info>::const_iterator data_it{m_data.begin() + (range.begin() - m_range.begin())};
-	for (const mesh& mesh : range) {
-		const usize mesh_indices{std::next(data_it)->index_offset - data_it->index_offset};
-
-		setup_draw_call_state(context, mesh.texture, mesh.mat, mesh.blend_mode);
-		context.set_vertex_buffer(m_renderer->m_vbuffer_positions, 0, data_it->vertex_offset);
-		context.set_vertex_buffer(m_renderer->m_vbuffer_uvs, 1, data_it->vertex_offset);
-		context.set_vertex_buffer(m_renderer->m_vbuffer_tints, 2, data_it->vertex_offset);
-		context.draw_indexed(mesh.type, data_it->index_offset, mesh_indices);
-
-		++data_it;
+	usize draw_index{m_range.size() + (static_range.begin() - m_static_range.begin())};
+	for (static_mesh_id id : static_range) {
+		draw_static_mesh(context, id, draw_index++);
 	}
+	draw_meshes(context, range.begin() - m_range.begin(), range.end() - m_range.begin());
 }
 
 void tr::basic_renderer::drawer::draw(const render_target& target)
 {
 	TR_ASSERT(m_renderer.has_ref(), "Tried to draw from a moved-from basic renderer drawer.");
 
-	if (m_range.empty()) {
+	if (m_range.empty() && m_static_range.empty()) {
 		return;
 	};
 
@@ -115,17 +225,67 @@ void tr::basic_renderer::drawer::draw(const render_target& target)
 	setup_context(context);
 	context.set_render_target(target);
 
-	std::vector<mesh_draw_info>::const_iterator data_it{m_data.begin()};
-	for (const mesh& mesh : m_range) {
-		const usize mesh_indices{std::next(data_it)->index_offset - data_it->index_offset};
+	// Retained meshes are drawn before the primitives added to the same layer.
+	usize drawn{0};
+	usize draw_index{m_range.size()};
+	const auto layer_of{[this](auto slot_or_id) { return this->layer_of(slot_or_id); }};
+	for (static_mesh_id id : m_static_range) {
+		const auto end{std::ranges::lower_bound(m_range.begin() + drawn, m_range.end(), layer_of(id), std::less{}, layer_of)};
+		draw_meshes(context, drawn, end - m_range.begin());
+		drawn = end - m_range.begin();
+		draw_static_mesh(context, id, draw_index++);
+	}
+	draw_meshes(context, drawn, m_range.size());
+}
 
-		setup_draw_call_state(context, mesh.texture, mesh.mat, mesh.blend_mode);
-		context.set_vertex_buffer(m_renderer->m_vbuffer_positions, 0, data_it->vertex_offset);
-		context.set_vertex_buffer(m_renderer->m_vbuffer_uvs, 1, data_it->vertex_offset);
-		context.set_vertex_buffer(m_renderer->m_vbuffer_tints, 2, data_it->vertex_offset);
-		context.draw_indexed(mesh.type, data_it->index_offset, mesh_indices);
+//
+
+int tr::basic_renderer::drawer::layer_of(usize slot) const
+{
+	return m_renderer->m_meshes[slot].layer;
+}
+
+int tr::basic_renderer::drawer::layer_of(static_mesh_id id) const
+{
+	return m_renderer->m_static_meshes[usize(id)]->layer;
+}
+
+tr::index_format tr::basic_renderer::drawer::index_format_of(const mesh& mesh)
+{
+	return mesh.vertices.size() > UINT16_MAX ? index_format::u32 : index_format::u16;
+}
+
+int tr::basic_renderer::drawer::draw_index_slot() const
+{
+	return m_renderer->m_vertex_layout == tr::vertex_layout::interleaved ? 1 : 3;
+}
 
-		++data_it;
+const tr::basic_renderer::batched_texture* tr::basic_renderer::drawer::batched_texture_of(const mesh& mesh) const
+{
+	if (mesh.texture.empty() || m_renderer->m_batched_textures.empty()) {
+		return nullptr;
+	}
+
+	const auto it{m_renderer->m_batched_textures.find(&*mesh.texture)};
+	return it != m_renderer->m_batched_textures.end() && it->second.array.has_value() ? &it->second : nullptr;
+}
+
+bool tr::basic_renderer::drawer::batchable(usize l, usize r) const
+{
+	const mesh& lmesh{m_renderer->m_meshes[m_range[l]]};
+	const mesh& rmesh{m_renderer->m_meshes[m_range[r]]};
+	if (m_index_formats[l] != m_index_formats[r] || lmesh.type != rmesh.type || lmesh.blend_mode != rmesh.blend_mode) {
+		return false;
+	}
+
+	// Meshes whose textures were gathered into the same texture array can be batched despite using different textures.
+	const batched_texture* lbatched{batched_texture_of(lmesh)};
+	const batched_texture* rbatched{batched_texture_of(rmesh)};
+	if (lbatched != nullptr && rbatched != nullptr) {
+		return lbatched->array == rbatched->array;
+	}
+	else {
+		return lbatched == rbatched && lmesh.texture == rmesh.texture;
 	}
 }
 
@@ -138,34 +298,125 @@ void tr::basic_renderer::drawer::setup_context(graphics_context& context)
 		context.set_depth_test(false);
 		context.set_shader_pipeline(m_renderer->m_pipeline);
 		context.set_blend_mode(m_renderer->m_last_blend_mode);
-		context.set_vertex_format(context.vertex2_format());
-		context.set_index_buffer(m_renderer->m_ibuffer);
+		context.set_vertex_format(m_renderer->m_vertex_format);
+		m_draw_data_bound = false;
+		m_bound_index_format = std::nullopt;
+	}
+}
+
+void tr::basic_renderer::drawer::bind_draw_data(graphics_context& context)
+{
+	if (!m_draw_data_bound) {
+		const stream_buffer& stream{m_renderer->m_stream_buffer};
+		const usize draws{m_range.size() + m_static_range.size()};
+
+		context.set_storage_buffer(0, stream, m_offsets.draw_infos, draws * sizeof(draw_info));
+		context.set_draw_indirect_buffer(stream);
+		context.set_vertex_buffer(stream, draw_index_slot(), m_offsets.draw_indices, sizeof(u32));
+		m_draw_data_bound = true;
 	}
 }
 
-void tr::basic_renderer::drawer::setup_draw_call_state(graphics_context& context, texture_ref texture_ref, const glm::mat4& transform,
-													   const blend_mode& blend_mode)
+void tr::basic_renderer::drawer::setup_draw_call_state(graphics_context& context, texture_ref texture_ref, const blend_mode& blend_mode)
 {
 	m_renderer->m_pipeline.fragment_shader().set_uniform(1, std::move(texture_ref));
+	set_blend_mode(context, blend_mode);
+}
 
-	if (m_renderer->m_last_transform != transform) {
-		m_renderer->m_last_transform = transform;
-		m_renderer->m_pipeline.vertex_shader().set_uniform(0, m_renderer->m_last_transform);
-	}
+void tr::basic_renderer::drawer::setup_draw_call_state(graphics_context& context, const texture_array& array, const blend_mode& blend_mode)
+{
+	m_renderer->m_pipeline.fragment_shader().set_uniform(2, array);
+	set_blend_mode(context, blend_mode);
+}
 
+void tr::basic_renderer::drawer::set_blend_mode(graphics_context& context, const blend_mode& blend_mode)
+{
 	if (m_renderer->m_last_blend_mode != blend_mode) {
 		m_renderer->m_last_blend_mode = blend_mode;
 		context.set_blend_mode(m_renderer->m_last_blend_mode);
 	}
 }
 
+void tr::basic_renderer::drawer::draw_meshes(graphics_context& context, usize first, usize last)
+{
+	if (first == last) {
+		return;
+	}
+
+	const stream_buffer& stream{m_renderer->m_stream_buffer};
+	bind_draw_data(context);
+	if (!m_bound_index_format.has_value()) {
+		if (m_renderer->m_vertex_layout == tr::vertex_layout::interleaved) {
+			context.set_vertex_buffer(stream, 0, m_offsets.vertices, sizeof(basic_renderer_vertex));
+		}
+		else {
+			context.set_vertex_buffer(stream, 0, m_offsets.positions, sizeof(glm::vec2));
+			context.set_vertex_buffer(stream, 1, m_offsets.uvs, sizeof(glm::vec2));
+			context.set_vertex_buffer(stream, 2, m_offsets.tints, sizeof(rgba8));
+		}
+	}
+
+	while (first != last) {
+		usize batch_end{first + 1};
+		while (batch_end != last && batchable(first, batch_end)) {
+			++batch_end;
+		}
+
+		const mesh& mesh{m_renderer->m_meshes[m_range[first]]};
+		if (const batched_texture* batched{batched_texture_of(mesh)}) {
+			setup_draw_call_state(context, m_renderer->m_texture_arrays[*batched->array].array, mesh.blend_mode);
+		}
+		else {
+			setup_draw_call_state(context, mesh.texture, mesh.blend_mode);
+		}
+		if (m_bound_index_format != m_index_formats[first]) {
+			m_bound_index_format = m_index_formats[first];
+			context.set_index_buffer(stream, *m_bound_index_format);
+		}
+		context.draw_indexed_indirect(mesh.type, m_offsets.commands + first * sizeof(indexed_draw_command), batch_end - first);
+		first = batch_end;
+	}
+}
+
+void tr::basic_renderer::drawer::draw_static_mesh(graphics_context& context, static_mesh_id id, usize draw_index)
+{
+	const static_mesh& mesh{*m_renderer->m_static_meshes[usize(id)]};
+	if (!mesh.visible) {
+		return;
+	}
+
+	bind_draw_data(context);
+	setup_draw_call_state(context, mesh.texture, mesh.blend_mode);
+	if (const auto* buffers{std::get_if<static_attribute_buffers>(&mesh.vertices)}) {
+		context.set_vertex_buffer(buffers->positions, 0, 0);
+		context.set_vertex_buffer(buffers->uvs, 1, 0);
+		context.set_vertex_buffer(buffers->tints, 2, 0);
+	}
+	else {
+		context.set_vertex_buffer(std::get<static_vertex_buffer<basic_renderer_vertex>>(mesh.vertices), 0, 0);
+	}
+	context.set_index_buffer(mesh.indices);
+	m_bound_index_format = std::nullopt;
+	context.draw_indexed_indirect(mesh.type, m_offsets.commands + draw_index * sizeof(indexed_draw_command), 1);
+}
+
 //
 
 void tr::basic_renderer::drawer::clean_up()
 {
 	if (m_renderer.has_ref()) {
-		m_renderer->m_meshes.erase(m_range.begin(), m_range.end());
+		if (!m_range.empty() || !m_static_range.empty()) {
+			m_renderer->m_stream_buffer.fence();
+		}
+		m_renderer->free_meshes(m_range);
+		m_renderer->m_index_formats = std::move(m_index_formats);
 #ifdef TR_ENABLE_ASSERTS
+		// Meshes outside of the drawn range are kept into the next frame, which then can't be compared to this one.
+		if (!m_renderer->m_mesh_order.empty()) {
+			m_renderer->m_allocation_check.invalidate();
+		}
+		const bool steady{m_renderer->m_allocation_check.end_frame(m_renderer->m_allocations)};
+		TR_ASSERT(steady, "A basic renderer allocated storage while drawing the same workload as in the previous frame.");
 		m_renderer->m_locked = false;
 #endif
 	}
@@ -4,7 +4,7 @@
 //                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#include "../include/tr/sysgfx/circle_renderer.hpp"
+#include "../../include/tr/sysgfx/circle_renderer.hpp"
 
 ///////////////////////////////////////////////////////////// CIRCLE RENDERER /////////////////////////////////////////////////////////////
 
@@ -19,14 +19,14 @@ tr::circle_renderer::circle_renderer(graphics_context& context, float render_sca
 	: m_id{context.allocate_renderer_id()}
 	, m_pipeline{context, vertex_shader{context, circle_renderer_vert}, fragment_shader{context, circle_renderer_frag}}
 	, m_vertex_format{context, vertex_format_bindings}
-	, m_shader_circles{context}
+	, m_stream_buffer{context}
 	, m_quad_vertices{context, std::array<glm::u8vec2, 4>{{{0, 0}, {0, 1}, {1, 1}, {1, 0}}}}
 {
 	m_pipeline.set_label("(tr) Circle Renderer Pipeline");
 	m_pipeline.vertex_shader().set_label("(tr) Circle Renderer Vertex Shader");
 	m_pipeline.fragment_shader().set_label("(tr) Circle Renderer Fragment Shader");
 	m_vertex_format.set_label("(tr) Circle Renderer Vertex Format");
-	m_shader_circles.set_label("(tr) Circle Renderer Circle Buffer");
+	m_stream_buffer.set_label("(tr) Circle Renderer Stream Buffer");
 	m_quad_vertices.set_label("(tr) Circle Renderer Quad Buffer");
 
 	set_render_scale(render_scale);
@@ -38,9 +38,17 @@ void tr::circle_renderer::set_render_scale(float render_scale)
 {
 	TR_ASSERT(!m_locked, "Tried to set render scale on a locked circle renderer.");
 
+	m_render_scale = render_scale;
 	m_pipeline.vertex_shader().set_uniform(1, render_scale);
 }
 
+void tr::circle_renderer::set_culling(bool culling)
+{
+	TR_ASSERT(!m_locked, "Tried to set culling on a locked circle renderer.");
+
+	m_culling = culling;
+}
+
 void tr::circle_renderer::set_default_transform(const glm::mat4& mat)
 {
 	TR_ASSERT(!m_locked, "Tried to set default transform on a locked circle renderer.");
@@ -52,14 +60,14 @@ void tr::circle_renderer::set_layer_transform(int layer, const glm::mat4& mat)
 {
 	TR_ASSERT(!m_locked, "Tried to set default layer transform on a locked circle renderer.");
 
-	m_layers[layer].transform = mat;
+	get_layer(layer).transform = mat;
 }
 
 void tr::circle_renderer::set_layer_blend_mode(int layer, const blend_mode& blend_mode)
 {
 	TR_ASSERT(!m_locked, "Tried to set default layer blending mode on a locked circle renderer.");
 
-	m_layers[layer].blend_mode = blend_mode;
+	get_layer(layer).blend_mode = blend_mode;
 }
 
 //
@@ -68,28 +76,47 @@ void tr::circle_renderer::add_circle(int layer, tr::circle circle, rgba8 color)
 {
 	TR_ASSERT(!m_locked, "Tried to add a circle to a locked circle renderer.");
 
-	m_layers[layer].circles.emplace_back(circle.center, circle.radius, 0, color, rgba8{color.r, color.b, color.b, 0});
+	push_circle(layer, {circle.center, circle.radius, 0, color, rgba8{color.r, color.b, color.b, 0}});
 }
 
 void tr::circle_renderer::add_circle_outline(int layer, tr::circle circle, float outline_thickness, rgba8 color)
 {
 	TR_ASSERT(!m_locked, "Tried to add a circle outline to a locked circle renderer.");
 
-	m_layers[layer].circles.emplace_back(circle.center, circle.radius, outline_thickness, rgba8{color.r, color.b, color.b, 0}, color);
+	push_circle(layer, {circle.center, circle.radius, outline_thickness, rgba8{color.r, color.b, color.b, 0}, color});
 }
 
 void tr::circle_renderer::add_outlined_circle(int layer, tr::circle circle, float outline_thickness, rgba8 fill_color, rgba8 outline_color)
 {
 	TR_ASSERT(!m_locked, "Tried to add an outlined circle to a locked circle renderer.");
 
-	m_layers[layer].circles.emplace_back(circle.center, circle.radius, outline_thickness, fill_color, outline_color);
+	push_circle(layer, {circle.center, circle.radius, outline_thickness, fill_color, outline_color});
+}
+
+//
+
+tr::usize tr::circle_renderer::allocations() const
+{
+	return m_allocations;
+}
+
+bool tr::circle_renderer::culling() const
+{
+	return m_culling;
+}
+
+tr::usize tr::circle_renderer::culled_circles() const
+{
+	return m_culled_circles;
 }
 
 //
 
 tr::circle_renderer::drawer tr::circle_renderer::create_drawer(int min_layer, int max_layer)
 {
-	return drawer{*this, {m_layers.lower_bound(min_layer), m_layers.upper_bound(max_layer)}};
+	return drawer{*this,
+				  {std::ranges::lower_bound(m_layers, min_layer, std::less{}, &layer::priority),
+				   std::ranges::upper_bound(m_layers, max_layer, std::less{}, &layer::priority)}};
 }
 
 tr::circle_renderer::drawer tr::circle_renderer::create_drawer()
@@ -100,4 +127,32 @@ tr::circle_renderer::drawer tr::circle_renderer::create_drawer()
 void tr::circle_renderer::draw(const render_target& target)
 {
 	create_drawer().draw(target);
+}
+
+//
+
+tr::circle_renderer::layer& tr::circle_renderer::get_layer(int layer)
+{
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.add_workload(layer);
+#endif
+
+	const auto it{std::ranges::lower_bound(m_layers, layer, std::less{}, &circle_renderer::layer::priority)};
+	if (it != m_layers.end() && it->priority == layer) {
+		return *it;
+	}
+
+	if (m_layers.size() == m_layers.capacity()) {
+		++m_allocations;
+	}
+	return *m_layers.emplace(it, layer);
+}
+
+void tr::circle_renderer::push_circle(int layer, const circle& circle)
+{
+	std::vector<circle_renderer::circle>& circles{get_layer(layer).circles};
+	if (circles.size() == circles.capacity()) {
+		++m_allocations;
+	}
+	circles.push_back(circle);
 }
\ No newline at end of file
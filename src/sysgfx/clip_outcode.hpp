@@ -0,0 +1,20 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides the clip outcode computation shared by the culling of the renderers (internal to the sysgfx module).                         //
+//                                                                                                                                       //
+// The outcode of a point is the bitmask of the clip planes (left, right, bottom, top) it lies outside of after being transformed. A     //
+// shape lies entirely outside of the render target if the outcodes of all of its corners share a bit.                                   //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../../include/tr/utility/integer.hpp"
+
+namespace tr {
+	// Gets the bitmask of the clip planes a point lies outside of after being transformed.
+	inline u8 clip_outcode(const glm::mat4& mat, glm::vec2 point)
+	{
+		const glm::vec4 clip{mat * glm::vec4{point, 0, 1}};
+		return u8((clip.x < -clip.w) | (clip.x > clip.w) << 1 | (clip.y < -clip.w) << 2 | (clip.y > clip.w) << 3);
+	}
+} // namespace tr
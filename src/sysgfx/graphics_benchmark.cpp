@@ -11,12 +11,16 @@
 
 ////////////////////////////////////////////////////////////// GPU BENCHMARK //////////////////////////////////////////////////////////////
 
+namespace tr {
+	namespace {
+		// Empty measurement deque returned for scopes without any measurements.
+		const std::deque<duration> no_measurements;
+	} // namespace
+} // namespace tr
+
 tr::graphics_benchmark::graphics_benchmark(graphics_context& context)
-	: m_qo{{context}}
 {
-	const graphics_context::glapi& gl{context.make_current_and_return_glapi()};
-
-	gl.generate_queries(1, out_handle(m_qo));
+	allocate_queries(context);
 }
 
 void tr::graphics_benchmark::deleter::operator()(unsigned int id) const
@@ -30,39 +34,87 @@ void tr::graphics_benchmark::deleter::operator()(unsigned int id) const
 
 tr::graphics_context& tr::graphics_benchmark::context() const
 {
-	return m_qo.get_deleter().context;
+	return m_queries.front().get_deleter().context;
 }
 
 //
 
 void tr::graphics_benchmark::start()
 {
-	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
+	TR_ASSERT(!m_active_measurement.has_value(), "Tried to start a graphics benchmark measurement while another one is ongoing.");
 
-	gl.begin_query(GL_TIME_ELAPSED, m_qo.get());
+	m_active_measurement = start_measurement(std::string{});
 }
 
 void tr::graphics_benchmark::stop()
 {
-	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
+	TR_ASSERT(m_active_measurement.has_value(), "Tried to stop a graphics benchmark measurement that wasn't started.");
+
+	stop_measurement(*m_active_measurement);
+	m_active_measurement.reset();
+}
+
+void tr::graphics_benchmark::start_scope(std::string_view name)
+{
+	TR_ASSERT(!name.empty(), "Tried to start a graphics benchmark scope with an empty name.");
+
+	const usize parent_name_length{m_scope_name.size()};
+	if (!m_scope_name.empty()) {
+		m_scope_name.push_back('/');
+	}
+	m_scope_name.append(name);
+	m_active_scopes.push_back({start_measurement(std::string{m_scope_name}), parent_name_length});
+}
+
+void tr::graphics_benchmark::stop_scope()
+{
+	TR_ASSERT(!m_active_scopes.empty(), "Tried to stop a graphics benchmark scope while none are ongoing.");
 
-	gl.end_query(GL_TIME_ELAPSED);
+	stop_measurement(m_active_scopes.back().measurement);
+	m_scope_name.resize(m_active_scopes.back().parent_name_length);
+	m_active_scopes.pop_back();
 }
 
 void tr::graphics_benchmark::fetch()
 {
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
-	i64 result;
-	gl.get_query_object_i64v(m_qo.get(), GL_QUERY_RESULT, &result);
-	if (m_durations.size() == 256) {
-		m_durations.pop_front();
+	// Timestamps are written in order, so once we hit an unavailable measurement, none of the following ones are available either.
+	while (!m_pending.empty() && m_pending.front().end != 0) {
+		pending_measurement& measurement{m_pending.front()};
+		int available;
+		gl.get_query_object_iv(measurement.end, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available) {
+			break;
+		}
+
+		i64 start;
+		i64 end;
+		gl.get_query_object_i64v(measurement.start, GL_QUERY_RESULT, &start);
+		gl.get_query_object_i64v(measurement.end, GL_QUERY_RESULT, &end);
+		std::deque<duration>& durations{m_durations[std::move(measurement.scope)]};
+		if (durations.size() == max_measurements) {
+			durations.pop_front();
+		}
+		durations.emplace_back(tr::insecs{end - start});
+
+		m_free_queries.push_back(measurement.start);
+		m_free_queries.push_back(measurement.end);
+		m_pending.pop_front();
+		++m_popped_measurements;
 	}
-	m_durations.emplace_back(tr::insecs{result});
 }
 
 void tr::graphics_benchmark::clear()
 {
+	for (const pending_measurement& measurement : m_pending) {
+		m_free_queries.push_back(measurement.start);
+		if (measurement.end != 0) {
+			m_free_queries.push_back(measurement.end);
+		}
+	}
+	m_popped_measurements += m_pending.size();
+	m_pending.clear();
 	m_durations.clear();
 }
 
@@ -70,30 +122,102 @@ void tr::graphics_benchmark::clear()
 
 tr::duration tr::graphics_benchmark::latest() const
 {
-	return !m_durations.empty() ? m_durations.back() : duration::zero();
+	return latest({});
+}
+
+tr::duration tr::graphics_benchmark::latest(std::string_view scope) const
+{
+	const std::deque<duration>& durations{measurements(scope)};
+	return !durations.empty() ? durations.back() : duration::zero();
 }
 
 tr::duration tr::graphics_benchmark::min() const
 {
-	return !m_durations.empty() ? *std::ranges::min_element(m_durations) : duration::zero();
+	return min({});
+}
+
+tr::duration tr::graphics_benchmark::min(std::string_view scope) const
+{
+	const std::deque<duration>& durations{measurements(scope)};
+	return !durations.empty() ? *std::ranges::min_element(durations) : duration::zero();
 }
 
 tr::duration tr::graphics_benchmark::max() const
 {
-	return !m_durations.empty() ? *std::ranges::max_element(m_durations) : duration::zero();
+	return max({});
+}
+
+tr::duration tr::graphics_benchmark::max(std::string_view scope) const
+{
+	const std::deque<duration>& durations{measurements(scope)};
+	return !durations.empty() ? *std::ranges::max_element(durations) : duration::zero();
 }
 
 tr::duration tr::graphics_benchmark::avg() const
 {
-	if (m_durations.empty()) {
+	return avg({});
+}
+
+tr::duration tr::graphics_benchmark::avg(std::string_view scope) const
+{
+	const std::deque<duration>& durations{measurements(scope)};
+	if (durations.empty()) {
 		return duration::zero();
 	}
 	else {
-		return sum(m_durations, duration::zero()) / m_durations.size();
+		return sum(durations, duration::zero()) / durations.size();
 	}
 }
 
 const std::deque<tr::duration>& tr::graphics_benchmark::measurements() const
 {
-	return m_durations;
+	return measurements({});
+}
+
+const std::deque<tr::duration>& tr::graphics_benchmark::measurements(std::string_view scope) const
+{
+	const auto it{m_durations.find(scope)};
+	return it != m_durations.end() ? it->second : no_measurements;
 }
+
+//
+
+void tr::graphics_benchmark::allocate_queries(graphics_context& context)
+{
+	const graphics_context::glapi& gl{context.make_current_and_return_glapi()};
+
+	std::array<unsigned int, query_block_size> ids;
+	gl.generate_queries(ids.size(), ids.data());
+	for (unsigned int id : ids) {
+		m_queries.emplace_back(id, deleter{context});
+		m_free_queries.push_back(id);
+	}
+}
+
+unsigned int tr::graphics_benchmark::record_timestamp()
+{
+	if (m_free_queries.empty()) {
+		allocate_queries(context());
+	}
+
+	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
+
+	const unsigned int id{m_free_queries.back()};
+	m_free_queries.pop_back();
+	gl.query_counter(id, GL_TIMESTAMP);
+	return id;
+}
+
+tr::usize tr::graphics_benchmark::start_measurement(std::string&& scope)
+{
+	m_pending.push_back({std::move(scope), record_timestamp(), 0});
+	return m_popped_measurements + m_pending.size() - 1;
+}
+
+void tr::graphics_benchmark::stop_measurement(usize index)
+{
+	// The measurement may have been dropped by .clear() while it was ongoing.
+	if (index >= m_popped_measurements) {
+		m_pending[index - m_popped_measurements].end = record_timestamp();
+	}
+}
\ No newline at end of file
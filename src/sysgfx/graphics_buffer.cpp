@@ -22,6 +22,7 @@ void tr::graphics_buffer::deleter::operator()(unsigned int id) const
 {
 	const graphics_context::glapi& gl{context.make_current_and_return_glapi()};
 
+	context.forget_buffer(id);
 	gl.delete_buffers(1, &id);
 }
 
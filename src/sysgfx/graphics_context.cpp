@@ -9,9 +9,12 @@
 #include "../../include/tr/sysgfx/gl_defines.hpp"
 #include "../../include/tr/sysgfx/index_buffer.hpp"
 #include "../../include/tr/sysgfx/shader_pipeline.hpp"
+#include "../../include/tr/sysgfx/stream_buffer.hpp"
 #include "../../include/tr/sysgfx/texture.hpp"
 #include "../../include/tr/sysgfx/window.hpp"
+#include "../../include/tr/utility/binary_io.hpp"
 #include "../../include/tr/utility/enum.hpp"
+#include "../../include/tr/utility/iostream.hpp"
 #include <SDL3/SDL.h>
 
 ////////////////////////////////////////////////////// GRAPHICS CONTEXT OPENING ERROR /////////////////////////////////////////////////////
@@ -61,6 +64,7 @@ namespace tr {
 
 tr::graphics_context::glapi::glapi()
 	: allocate_2d_texture_storage{gl_function_address("glTextureStorage2D")}
+	, allocate_3d_texture_storage{gl_function_address("glTextureStorage3D")}
 	, allocate_buffer_storage{gl_function_address("glNamedBufferStorage")}
 	, begin_query{gl_function_address("glBeginQuery")}
 	, bind_buffer{gl_function_address("glBindBuffer")}
@@ -74,9 +78,11 @@ tr::graphics_context::glapi::glapi()
 	, clear{gl_function_address("glClear")}
 	, clear_texture_image{gl_function_address("glClearTexImage")}
 	, clear_texture_sub_image{gl_function_address("glClearTexSubImage")}
+	, client_wait_sync{gl_function_address("glClientWaitSync")}
 	, copy_image_sub_data{gl_function_address("glCopyImageSubData")}
 	, create_buffers{gl_function_address("glCreateBuffers")}
 	, create_framebuffers{gl_function_address("glCreateFramebuffers")}
+	, create_program{gl_function_address("glCreateProgram")}
 	, create_program_pipelines{gl_function_address("glCreateProgramPipelines")}
 	, create_shader_program_v{gl_function_address("glCreateShaderProgramv")}
 	, create_textures{gl_function_address("glCreateTextures")}
@@ -86,6 +92,7 @@ tr::graphics_context::glapi::glapi()
 	, delete_program{gl_function_address("glDeleteProgram")}
 	, delete_program_pipelines{gl_function_address("glDeleteProgramPipelines")}
 	, delete_queries{gl_function_address("glDeleteQueries")}
+	, delete_sync{gl_function_address("glDeleteSync")}
 	, delete_textures{gl_function_address("glDeleteTextures")}
 	, delete_vertex_arrays{gl_function_address("glDeleteVertexArrays")}
 	, disable{gl_function_address("glDisable")}
@@ -96,24 +103,34 @@ tr::graphics_context::glapi::glapi()
 	, enable{gl_function_address("glEnable")}
 	, enable_vertex_array_attribute{gl_function_address("glEnableVertexArrayAttrib")}
 	, end_query{gl_function_address("glEndQuery")}
+	, fence_sync{gl_function_address("glFenceSync")}
+	, finish{gl_function_address("glFinish")}
 	, generate_queries{gl_function_address("glGenQueries")}
 	, generate_texture_mipmap{gl_function_address("glGenerateTextureMipmap")}
 	, get_error{gl_function_address("glGetError")}
 	, get_buffer_parameter_iv{gl_function_address("glGetNamedBufferParameteriv")}
 	, get_integer_v{gl_function_address("glGetIntegerv")}
 	, get_object_label{gl_function_address("glGetObjectLabel")}
+	, get_program_binary{gl_function_address("glGetProgramBinary")}
 	, get_program_info_log{gl_function_address("glGetProgramInfoLog")}
 	, get_program_interface_iv{gl_function_address("glGetProgramInterfaceiv")}
 	, get_program_iv{gl_function_address("glGetProgramiv")}
 	, get_program_resource_iv{gl_function_address("glGetProgramResourceiv")}
 	, get_program_resource_name{gl_function_address("glGetProgramResourceName")}
 	, get_query_object_i64v{gl_function_address("glGetQueryObjecti64v")}
+	, get_query_object_iv{gl_function_address("glGetQueryObjectiv")}
 	, get_string{gl_function_address("glGetString")}
 	, get_texture_parameter_fv{gl_function_address("glGetTextureParameterfv")}
+	, get_texture_level_parameter_iv{gl_function_address("glGetTextureLevelParameteriv")}
 	, get_texture_parameter_iv{gl_function_address("glGetTextureParameteriv")}
+	, get_texture_sub_image{gl_function_address("glGetTextureSubImage")}
 	, invalidate_buffer_data{gl_function_address("glInvalidateBufferData")}
 	, map_buffer_range{gl_function_address("glMapNamedBufferRange")}
+	, multi_draw_elements_indirect{gl_function_address("glMultiDrawElementsIndirect")}
+	, query_counter{gl_function_address("glQueryCounter")}
+	, read_pixels{gl_function_address("glReadPixels")}
 	, set_2d_texture_sub_image{gl_function_address("glTextureSubImage2D")}
+	, set_3d_texture_sub_image{gl_function_address("glTextureSubImage3D")}
 	, set_buffer_sub_data{gl_function_address("glNamedBufferSubData")}
 	, set_clear_color{gl_function_address("glClearColor")}
 	, set_clear_depth{gl_function_address("glClearDepth")}
@@ -121,9 +138,12 @@ tr::graphics_context::glapi::glapi()
 	, set_debug_message_callback{gl_function_address("glDebugMessageCallback")}
 	, set_debug_message_control{gl_function_address("glDebugMessageControl")}
 	, set_framebuffer_texture{gl_function_address("glNamedFramebufferTexture")}
+	, set_max_shader_compiler_threads{gl_function_address("glMaxShaderCompilerThreadsKHR")}
 	, set_object_label{gl_function_address("glObjectLabel")}
 	, set_pixel_store_i{gl_function_address("glPixelStorei")}
 	, set_polygon_mode{gl_function_address("glPolygonMode")}
+	, set_program_binary{gl_function_address("glProgramBinary")}
+	, set_program_parameter_i{gl_function_address("glProgramParameteri")}
 	, set_program_uniform_1f{gl_function_address("glProgramUniform1f")}
 	, set_program_uniform_1fv{gl_function_address("glProgramUniform1fv")}
 	, set_program_uniform_2f{gl_function_address("glProgramUniform2f")}
@@ -284,6 +304,28 @@ namespace tr {
 			}
 			return context;
 		}
+
+		// How long to wait for a fence in a single wait call (in nanoseconds).
+		constexpr std::uint64_t fence_wait_timeout{1'000'000'000};
+
+		// Magic bytes at the start of a shader cache entry.
+		constexpr std::string_view shader_cache_magic{"trsc"};
+		// The version of the shader cache entry format.
+		constexpr u32 shader_cache_version{1};
+
+		// Gets the file name of the shader cache entry of a shader (a stable FNV-1a hash of its type and source).
+		std::string shader_cache_entry_name(unsigned int type, std::string_view source)
+		{
+			u64 hash{0xCBF29CE484222325};
+			const auto hash_byte{[&](u8 byte) { hash = (hash ^ byte) * 0x100000001B3; }};
+			for (int i = 0; i < 4; ++i) {
+				hash_byte(u8(type >> (i * 8)));
+			}
+			for (char chr : source) {
+				hash_byte(u8(chr));
+			}
+			return TR_FMT::format("{:016x}.bin", hash);
+		}
 	} // namespace
 } // namespace tr
 
@@ -306,6 +348,15 @@ tr::graphics_context::graphics_context(window_view window)
 		static int logger_id{0};
 		logger.replace_backend_with<console_logger>(TR_FMT::format("gfx{}", logger_id++));
 	}
+
+	if (SDL_GL_ExtensionSupported("GL_KHR_parallel_shader_compile") && m_glapi.set_max_shader_compiler_threads != nullptr) {
+		m_glapi.set_max_shader_compiler_threads(UINT_MAX);
+		m_parallel_shader_compile = true;
+	}
+
+	int storage_buffer_offset_alignment;
+	m_glapi.get_integer_v(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storage_buffer_offset_alignment);
+	m_storage_buffer_offset_alignment = usize(storage_buffer_offset_alignment);
 }
 
 void tr::graphics_context::deleter::operator()(SDL_GLContextState* context) const
@@ -352,6 +403,63 @@ const tr::vertex_format& tr::graphics_context::vertex2_format()
 	return *m_vertex2_format;
 }
 
+tr::usize tr::graphics_context::storage_buffer_offset_alignment() const
+{
+	return m_storage_buffer_offset_alignment;
+}
+
+//
+
+const tr::graphics_state_stats& tr::graphics_context::state_stats() const
+{
+	return m_state_stats;
+}
+
+void tr::graphics_context::reset_state_stats()
+{
+	m_state_stats = {};
+}
+
+//
+
+void tr::graphics_context::enable_shader_cache(const std::filesystem::path& directory)
+{
+	const glapi& gl{make_current_and_return_glapi()};
+
+	int binary_formats{0};
+	gl.get_integer_v(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_formats);
+	if (binary_formats == 0) {
+		logger.log(severity::warning, "Shader cache not enabled: the driver doesn't support program binaries.");
+		return;
+	}
+
+	std::error_code ec;
+	std::filesystem::create_directories(directory, ec);
+	if (ec) {
+		logger.log(severity::warning, "Shader cache not enabled: failed to create directory '{}'.", directory.string());
+		return;
+	}
+
+	const struct info context_info{info()};
+	std::string driver{TR_FMT::format("{}\n{}\n{}", context_info.vendor, context_info.renderer, context_info.gl_version)};
+	m_shader_cache = shader_cache{directory, std::move(driver)};
+}
+
+void tr::graphics_context::disable_shader_cache()
+{
+	m_shader_cache.reset();
+}
+
+bool tr::graphics_context::shader_cache_enabled() const
+{
+	return m_shader_cache.has_value();
+}
+
+const tr::shader_binary_cache_stats& tr::graphics_context::shader_cache_stats() const
+{
+	return m_shader_cache_stats;
+}
+
 //
 
 tr::renderer_id tr::graphics_context::allocate_renderer_id()
@@ -374,18 +482,24 @@ void tr::graphics_context::set_wireframe_mode(bool arg)
 {
 	const glapi& gl{make_current_and_return_glapi()};
 
-	gl.set_polygon_mode(GL_FRONT_AND_BACK, arg ? GL_LINE : GL_FILL);
+	if (record_state_change(m_shadow_state.wireframe_mode != arg)) {
+		gl.set_polygon_mode(GL_FRONT_AND_BACK, arg ? GL_LINE : GL_FILL);
+		m_shadow_state.wireframe_mode = arg;
+	}
 }
 
 void tr::graphics_context::set_face_culling(bool arg)
 {
 	const glapi& gl{make_current_and_return_glapi()};
 
-	if (arg) {
-		gl.enable(GL_CULL_FACE);
-	}
-	else {
-		gl.disable(GL_CULL_FACE);
+	if (record_state_change(m_shadow_state.face_culling != arg)) {
+		if (arg) {
+			gl.enable(GL_CULL_FACE);
+		}
+		else {
+			gl.disable(GL_CULL_FACE);
+		}
+		m_shadow_state.face_culling = arg;
 	}
 }
 
@@ -393,11 +507,14 @@ void tr::graphics_context::set_depth_test(bool arg)
 {
 	const glapi& gl{make_current_and_return_glapi()};
 
-	if (arg) {
-		gl.enable(GL_DEPTH_TEST);
-	}
-	else {
-		gl.disable(GL_DEPTH_TEST);
+	if (record_state_change(m_shadow_state.depth_test != arg)) {
+		if (arg) {
+			gl.enable(GL_DEPTH_TEST);
+		}
+		else {
+			gl.disable(GL_DEPTH_TEST);
+		}
+		m_shadow_state.depth_test = arg;
 	}
 }
 
@@ -426,7 +543,7 @@ void tr::graphics_context::set_render_target(const render_target& target)
 		changed_render_target = true;
 	}
 
-	if (changed_render_target) {
+	if (record_state_change(changed_render_target)) {
 		m_render_target = target;
 	}
 }
@@ -435,16 +552,22 @@ void tr::graphics_context::set_shader_pipeline(const shader_pipeline& pipeline)
 {
 	const glapi& gl{make_current_and_return_glapi()};
 
-	gl.bind_program_pipeline(pipeline.m_ppo.get());
+	if (record_state_change(m_shadow_state.pipeline != pipeline.m_ppo.get())) {
+		gl.bind_program_pipeline(pipeline.m_ppo.get());
+		m_shadow_state.pipeline = pipeline.m_ppo.get();
+	}
 }
 
 void tr::graphics_context::set_blend_mode(const blend_mode& bm)
 {
 	const glapi& gl{make_current_and_return_glapi()};
 
-	gl.set_separate_blend_equations(to_underlying(bm.rgb_fn), to_underlying(bm.alpha_fn));
-	gl.set_separate_blend_function(to_underlying(bm.rgb_src), to_underlying(bm.rgb_dst), to_underlying(bm.alpha_src),
-								   to_underlying(bm.alpha_dst));
+	if (record_state_change(m_shadow_state.blending != bm)) {
+		gl.set_separate_blend_equations(to_underlying(bm.rgb_fn), to_underlying(bm.alpha_fn));
+		gl.set_separate_blend_function(to_underlying(bm.rgb_src), to_underlying(bm.rgb_dst), to_underlying(bm.alpha_src),
+									   to_underlying(bm.alpha_dst));
+		m_shadow_state.blending = bm;
+	}
 }
 
 void tr::graphics_context::set_vertex_format(const vertex_format& format)
@@ -456,35 +579,62 @@ void tr::graphics_context::set_vertex_format(const vertex_format& format)
 	m_vertex_format_label = format.label();
 #endif
 
-	gl.bind_vertex_array(format.m_vao.get());
+	if (record_state_change(m_shadow_state.vao != format.m_vao.get())) {
+		gl.bind_vertex_array(format.m_vao.get());
+		m_shadow_state.vao = format.m_vao.get();
+		// Vertex and index buffer bindings are part of the VAO state, and we don't know what they are in the newly bound VAO.
+		std::ranges::fill(m_shadow_state.vertex_buffers, std::nullopt);
+		m_shadow_state.index_buffer_id.reset();
+		m_shadow_state.index_buffer_format.reset();
+	}
 }
 
 void tr::graphics_context::set_vertex_buffer(const basic_static_vertex_buffer& buffer, int slot, ssize offset, usize stride)
 {
-	const glapi& gl{make_current_and_return_glapi()};
-
-	gl.bind_vertex_buffer(slot, buffer.id(), offset, stride);
+	bind_vertex_buffer(buffer.id(), slot, offset, stride);
 }
 
 void tr::graphics_context::set_vertex_buffer(const basic_dyn_vertex_buffer& buffer, int slot, ssize offset, usize stride)
 {
-	const glapi& gl{make_current_and_return_glapi()};
+	bind_vertex_buffer(buffer.id(), slot, offset, stride);
+}
 
-	gl.bind_vertex_buffer(slot, buffer.id(), offset, stride);
+void tr::graphics_context::set_vertex_buffer(const stream_buffer& buffer, int slot, ssize offset, usize stride)
+{
+	bind_vertex_buffer(buffer.id(), slot, offset, stride);
 }
 
 void tr::graphics_context::set_index_buffer(const static_index_buffer& buffer)
 {
-	const glapi& gl{make_current_and_return_glapi()};
-
-	gl.bind_buffer(GL_ELEMENT_ARRAY_BUFFER, buffer.id());
+	bind_index_buffer(buffer.id());
+	m_shadow_state.index_buffer_format = buffer.format();
 }
 
 void tr::graphics_context::set_index_buffer(const dyn_index_buffer& buffer)
+{
+	bind_index_buffer(buffer.id());
+	m_shadow_state.index_buffer_format = buffer.format();
+}
+
+void tr::graphics_context::set_index_buffer(const stream_buffer& buffer, index_format format)
+{
+	bind_index_buffer(buffer.id());
+	m_shadow_state.index_buffer_format = format;
+}
+
+void tr::graphics_context::set_draw_indirect_buffer(const stream_buffer& buffer)
 {
 	const glapi& gl{make_current_and_return_glapi()};
 
-	gl.bind_buffer(GL_ELEMENT_ARRAY_BUFFER, buffer.id());
+	if (record_state_change(m_shadow_state.draw_indirect_buffer_id != buffer.id())) {
+		gl.bind_buffer(GL_DRAW_INDIRECT_BUFFER, buffer.id());
+		m_shadow_state.draw_indirect_buffer_id = buffer.id();
+	}
+}
+
+void tr::graphics_context::set_storage_buffer(unsigned int index, const stream_buffer& buffer, usize offset, usize size)
+{
+	bind_storage_buffer(index, buffer.id(), offset, size);
 }
 
 //
@@ -535,6 +685,7 @@ void tr::graphics_context::draw(primitive type, usize offset, usize vertices)
 {
 	const glapi& gl{make_current_and_return_glapi()};
 
+	generate_dirty_mipmaps();
 	gl.draw_arrays(to_underlying(type), offset, vertices);
 }
 
@@ -542,6 +693,7 @@ void tr::graphics_context::draw_instances(primitive type, usize offset, usize ve
 {
 	const glapi& gl{make_current_and_return_glapi()};
 
+	generate_dirty_mipmaps();
 	gl.draw_arrays_instanced(to_underlying(type), offset, vertices, instances);
 }
 
@@ -549,26 +701,269 @@ void tr::graphics_context::draw_indexed(primitive type, usize offset, usize indi
 {
 	const glapi& gl{make_current_and_return_glapi()};
 
-	gl.draw_elements(to_underlying(type), indices, GL_UNSIGNED_SHORT, reinterpret_cast<const void*>(offset * sizeof(u16)));
+	TR_ASSERT(m_shadow_state.index_buffer_format.has_value(), "Tried to draw indexed primitives without setting an index buffer.");
+	const index_format format{*m_shadow_state.index_buffer_format};
+
+	generate_dirty_mipmaps();
+	gl.draw_elements(to_underlying(type), indices, to_underlying(format),
+					 reinterpret_cast<const void*>(offset * index_size(format)));
 }
 
 void tr::graphics_context::draw_indexed_instances(primitive type, usize offset, usize indices, int instances)
 {
 	const glapi& gl{make_current_and_return_glapi()};
 
-	gl.draw_elements_instanced(to_underlying(type), indices, GL_UNSIGNED_SHORT, reinterpret_cast<const void*>(offset * sizeof(u16)),
-							   instances);
+	TR_ASSERT(m_shadow_state.index_buffer_format.has_value(), "Tried to draw indexed primitives without setting an index buffer.");
+	const index_format format{*m_shadow_state.index_buffer_format};
+
+	generate_dirty_mipmaps();
+	gl.draw_elements_instanced(to_underlying(type), indices, to_underlying(format),
+							   reinterpret_cast<const void*>(offset * index_size(format)), instances);
+}
+
+void tr::graphics_context::draw_indexed_indirect(primitive type, usize offset, usize draws)
+{
+	const glapi& gl{make_current_and_return_glapi()};
+
+	TR_ASSERT(m_shadow_state.index_buffer_format.has_value(), "Tried to draw indexed primitives without setting an index buffer.");
+	const index_format format{*m_shadow_state.index_buffer_format};
+
+	generate_dirty_mipmaps();
+	gl.multi_draw_elements_indirect(to_underlying(type), to_underlying(format), reinterpret_cast<const void*>(offset), draws, 0);
 }
 
 //
 
 const tr::graphics_context::glapi& tr::graphics_context::make_current_and_return_glapi() const
 {
-	SDL_GL_MakeCurrent(m_window, m_ptr.get());
+	if (SDL_GL_GetCurrentContext() != m_ptr.get() || SDL_GL_GetCurrentWindow() != m_window) {
+		SDL_GL_MakeCurrent(m_window, m_ptr.get());
+		++m_state_stats.make_current_issued;
+	}
+	else {
+		++m_state_stats.make_current_elided;
+	}
 
 	return m_glapi;
 }
 
+void tr::graphics_context::wait_for_fence(void* fence) const
+{
+	const glapi& gl{make_current_and_return_glapi()};
+
+	unsigned int result;
+	do {
+		result = gl.client_wait_sync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, fence_wait_timeout);
+	} while (result == GL_TIMEOUT_EXPIRED);
+
+	// A failed wait (for example, on an invalid fence) says nothing about whether the commands before the fence are done.
+	if (result == GL_WAIT_FAILED) {
+		gl.finish();
+	}
+}
+
+//
+
+bool tr::graphics_context::record_state_change(bool changed) const
+{
+	++(changed ? m_state_stats.issued : m_state_stats.elided);
+	return changed;
+}
+
+void tr::graphics_context::bind_vertex_buffer(unsigned int id, int slot, ssize offset, usize stride)
+{
+	const glapi& gl{make_current_and_return_glapi()};
+
+	const vertex_buffer_binding binding{id, offset, stride};
+	if (record_state_change(m_shadow_state.vertex_buffers[slot] != binding)) {
+		gl.bind_vertex_buffer(slot, id, offset, stride);
+		m_shadow_state.vertex_buffers[slot] = binding;
+	}
+}
+
+void tr::graphics_context::bind_index_buffer(unsigned int id)
+{
+	const glapi& gl{make_current_and_return_glapi()};
+
+	if (record_state_change(m_shadow_state.index_buffer_id != id)) {
+		gl.bind_buffer(GL_ELEMENT_ARRAY_BUFFER, id);
+		m_shadow_state.index_buffer_id = id;
+	}
+}
+
+void tr::graphics_context::bind_storage_buffer(unsigned int index, unsigned int id, usize offset, usize size)
+{
+	const glapi& gl{make_current_and_return_glapi()};
+
+	if (index >= m_shadow_state.storage_buffers.size()) {
+		record_state_change(true);
+		gl.bind_buffer_range(GL_SHADER_STORAGE_BUFFER, index, id, offset, size);
+		return;
+	}
+
+	const storage_buffer_binding binding{id, offset, size};
+	if (record_state_change(m_shadow_state.storage_buffers[index] != binding)) {
+		gl.bind_buffer_range(GL_SHADER_STORAGE_BUFFER, index, id, offset, size);
+		m_shadow_state.storage_buffers[index] = binding;
+	}
+}
+
+void tr::graphics_context::invalidate_shadow_state()
+{
+	m_shadow_state = {};
+	m_render_target.reset();
+	m_active_renderer = renderer_id::no_renderer;
+}
+
+void tr::graphics_context::forget_buffer(unsigned int id)
+{
+	for (std::optional<vertex_buffer_binding>& binding : m_shadow_state.vertex_buffers) {
+		if (binding.has_value() && binding->buffer == id) {
+			binding.reset();
+		}
+	}
+	for (std::optional<storage_buffer_binding>& binding : m_shadow_state.storage_buffers) {
+		if (binding.has_value() && binding->buffer == id) {
+			binding.reset();
+		}
+	}
+	if (m_shadow_state.index_buffer_id == id) {
+		m_shadow_state.index_buffer_id.reset();
+		m_shadow_state.index_buffer_format.reset();
+	}
+	if (m_shadow_state.draw_indirect_buffer_id == id) {
+		m_shadow_state.draw_indirect_buffer_id.reset();
+	}
+}
+
+void tr::graphics_context::forget_shader_pipeline(unsigned int id)
+{
+	if (m_shadow_state.pipeline == id) {
+		m_shadow_state.pipeline.reset();
+	}
+}
+
+void tr::graphics_context::forget_vertex_format(unsigned int id)
+{
+	if (m_shadow_state.vao == id) {
+		m_shadow_state.vao.reset();
+		std::ranges::fill(m_shadow_state.vertex_buffers, std::nullopt);
+		m_shadow_state.index_buffer_id.reset();
+		m_shadow_state.index_buffer_format.reset();
+	}
+}
+
+//
+
+unsigned int tr::graphics_context::create_shader_program(unsigned int type, zstring_view source)
+{
+	const unsigned int cached_program{load_cached_shader_program(type, source)};
+	if (cached_program != 0) {
+		return cached_program;
+	}
+
+	const unsigned int program{compile_shader_program(type, source)};
+	store_cached_shader_program(program, type, source);
+	return program;
+}
+
+unsigned int tr::graphics_context::compile_shader_program(unsigned int type, zstring_view source)
+{
+	const glapi& gl{make_current_and_return_glapi()};
+
+	if (m_shader_cache.has_value()) {
+		++m_shader_cache_stats.misses;
+	}
+	return gl.create_shader_program_v(type, 1, reinterpret_cast<const char**>(&source));
+}
+
+unsigned int tr::graphics_context::load_cached_shader_program(unsigned int type, std::string_view source)
+{
+	if (!m_shader_cache.has_value()) {
+		return 0;
+	}
+
+	const std::filesystem::path path{m_shader_cache->directory / shader_cache_entry_name(type, source)};
+	std::error_code ec;
+	if (!std::filesystem::is_regular_file(path, ec)) {
+		return 0;
+	}
+
+	u32 binary_format;
+	std::vector<std::byte> binary;
+	try {
+		std::ifstream file{open_file_r(path, std::ios::binary)};
+		u32 version;
+		std::string driver;
+		u32 cached_type;
+		std::string cached_source;
+		const bool valid_header{read_binary_magic(file, shader_cache_magic)};
+		if (valid_header) {
+			read_binary(file, version, driver, cached_type, cached_source, binary_format);
+		}
+		if (!valid_header || version != shader_cache_version || driver != m_shader_cache->driver || cached_type != type ||
+			cached_source != source) {
+			++m_shader_cache_stats.rejected;
+			return 0;
+		}
+		binary = flush_binary(file);
+	}
+	catch (std::exception&) {
+		++m_shader_cache_stats.rejected;
+		return 0;
+	}
+
+	const glapi& gl{make_current_and_return_glapi()};
+	const unsigned int program{gl.create_program()};
+	gl.set_program_parameter_i(program, GL_PROGRAM_SEPARABLE, GL_TRUE);
+	gl.set_program_binary(program, binary_format, binary.data(), int(binary.size()));
+	int linked;
+	gl.get_program_iv(program, GL_LINK_STATUS, &linked);
+	if (!linked) {
+		gl.delete_program(program);
+		++m_shader_cache_stats.rejected;
+		return 0;
+	}
+	++m_shader_cache_stats.hits;
+	return program;
+}
+
+void tr::graphics_context::store_cached_shader_program(unsigned int program, unsigned int type, std::string_view source)
+{
+	if (!m_shader_cache.has_value()) {
+		return;
+	}
+
+	const glapi& gl{make_current_and_return_glapi()};
+	int linked;
+	gl.get_program_iv(program, GL_LINK_STATUS, &linked);
+	if (!linked) {
+		return;
+	}
+
+	// glCreateShaderProgramv links before GL_PROGRAM_BINARY_RETRIEVABLE_HINT can be set, so a driver is free to not provide a binary.
+	int length{0};
+	gl.get_program_iv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0) {
+		return;
+	}
+	std::vector<std::byte> binary(length);
+	u32 binary_format;
+	gl.get_program_binary(program, length, &length, &binary_format, binary.data());
+	binary.resize(length);
+
+	const std::filesystem::path path{m_shader_cache->directory / shader_cache_entry_name(type, source)};
+	try {
+		std::ofstream file{open_file_w(path, std::ios::binary)};
+		write_binary_magic(file, shader_cache_magic);
+		write_binary(file, shader_cache_version, m_shader_cache->driver, u32(type), source, binary_format,
+					 std::span<const std::byte>{binary});
+	}
+	catch (std::exception&) {
+		logger.log(severity::warning, "Failed to write shader cache entry '{}'.", path.string());
+	}
+}
+
 //
 
 bool tr::graphics_context::is_fbo_of_render_target(unsigned int fbo)
@@ -600,7 +995,7 @@ void tr::graphics_context::set_texture_unit(unsigned int unit, texture_ref textu
 	const glapi& gl{make_current_and_return_glapi()};
 
 	if (!texture.empty()) {
-		if (m_texture_units[unit] != texture && texture->m_handle != 0) {
+		if (record_state_change(m_texture_units[unit] != texture && texture->m_handle != 0)) {
 			gl.bind_textures(unit, 1, &texture->m_handle);
 		}
 	}
@@ -625,6 +1020,36 @@ void tr::graphics_context::rebind_texture_units(const texture& texture)
 	}
 }
 
+void tr::graphics_context::mark_mipmaps_dirty(unsigned int texture)
+{
+	if (std::ranges::find(m_dirty_mipmaps, texture) == m_dirty_mipmaps.end()) {
+		m_dirty_mipmaps.push_back(texture);
+	}
+}
+
+void tr::graphics_context::forget_dirty_mipmaps(unsigned int texture)
+{
+	std::erase(m_dirty_mipmaps, texture);
+}
+
+void tr::graphics_context::generate_dirty_mipmaps()
+{
+	if (m_dirty_mipmaps.empty()) {
+		return;
+	}
+
+	const glapi& gl{make_current_and_return_glapi()};
+	for (unsigned int texture : m_dirty_mipmaps) {
+		gl.generate_texture_mipmap(texture);
+	}
+	m_dirty_mipmaps.clear();
+}
+
+tr::u64 tr::graphics_context::allocate_texture_version()
+{
+	return m_next_texture_version++;
+}
+
 //
 
 #ifdef TR_ENABLE_GL_CHECKS
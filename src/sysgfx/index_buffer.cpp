@@ -13,6 +13,7 @@
 tr::static_index_buffer::static_index_buffer(graphics_context& context, std::span<const u16> data)
 	: graphics_buffer{context}
 	, m_size{std::ssize(data)}
+	, m_format{index_format::u16}
 {
 	const graphics_context::glapi& gl{context.make_current_and_return_glapi()};
 
@@ -22,8 +23,37 @@ tr::static_index_buffer::static_index_buffer(graphics_context& context, std::spa
 	}
 }
 
+tr::static_index_buffer::static_index_buffer(graphics_context& context, std::span<const u32> data)
+	: graphics_buffer{context}
+	, m_size{std::ssize(data)}
+	, m_format{index_format::u32}
+{
+	const graphics_context::glapi& gl{context.make_current_and_return_glapi()};
+
+	gl.allocate_buffer_storage(id(), m_size * sizeof(u32), data.data(), 0);
+	if (gl.get_error() == GL_OUT_OF_MEMORY) {
+		throw out_of_memory{"index buffer allocation"};
+	}
+}
+
+tr::index_format tr::static_index_buffer::format() const
+{
+	return m_format;
+}
+
 ////////////////////////////////////////////////////////// DYNAMIC INDEX BUFFER ///////////////////////////////////////////////////////////
 
+tr::dyn_index_buffer::dyn_index_buffer(graphics_context& context, index_format format)
+	: graphics_buffer{context}
+	, m_format{format}
+{
+}
+
+tr::index_format tr::dyn_index_buffer::format() const
+{
+	return m_format;
+}
+
 bool tr::dyn_index_buffer::empty() const
 {
 	return m_size == 0;
@@ -60,7 +90,7 @@ void tr::dyn_index_buffer::reserve(usize capacity)
 		capacity = std::bit_ceil(capacity);
 
 		reallocate();
-		gl.allocate_buffer_storage(id(), capacity * sizeof(u16), nullptr, GL_DYNAMIC_STORAGE_BIT);
+		gl.allocate_buffer_storage(id(), capacity * index_size(m_format), nullptr, GL_DYNAMIC_STORAGE_BIT);
 		if (gl.get_error() == GL_OUT_OF_MEMORY) {
 			throw out_of_memory{"allocation of index buffer '{}'", label()};
 		}
@@ -74,6 +104,7 @@ void tr::dyn_index_buffer::reserve(usize capacity)
 
 void tr::dyn_index_buffer::set_region(usize offset, std::span<const u16> data)
 {
+	TR_ASSERT(m_format == index_format::u16, "Tried to set 16-bit indices in 32-bit index buffer '{}'.", label());
 	TR_ASSERT(offset + data.size() <= m_size, "Tried to set out-of-bounds region [{}, {}) in index buffer '{}' of size {}.", offset,
 			  offset + data.size(), label(), m_size);
 
@@ -82,7 +113,24 @@ void tr::dyn_index_buffer::set_region(usize offset, std::span<const u16> data)
 	gl.set_buffer_sub_data(id(), offset * sizeof(u16), data.size() * sizeof(u16), data.data());
 }
 
+void tr::dyn_index_buffer::set_region(usize offset, std::span<const u32> data)
+{
+	TR_ASSERT(m_format == index_format::u32, "Tried to set 32-bit indices in 16-bit index buffer '{}'.", label());
+	TR_ASSERT(offset + data.size() <= m_size, "Tried to set out-of-bounds region [{}, {}) in index buffer '{}' of size {}.", offset,
+			  offset + data.size(), label(), m_size);
+
+	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
+
+	gl.set_buffer_sub_data(id(), offset * sizeof(u32), data.size() * sizeof(u32), data.data());
+}
+
 void tr::dyn_index_buffer::set(std::span<const u16> data)
+{
+	resize(data.size());
+	set_region(0, data);
+}
+
+void tr::dyn_index_buffer::set(std::span<const u32> data)
 {
 	resize(data.size());
 	set_region(0, data);
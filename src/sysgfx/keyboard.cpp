@@ -198,26 +198,4 @@ std::size_t boost::hash<tr::scan_chord>::operator()(tr::scan_chord chord) const
 std::size_t boost::hash<tr::key_chord>::operator()(tr::key_chord chord) const
 {
 	return (static_cast<std::size_t>(chord.key) << 32) | static_cast<std::size_t>(chord.mods);
-}
-
-//////////////////////////////////////////////////////////////// BINARY IO ////////////////////////////////////////////////////////////////
-
-void tr::binary_reader<tr::scan_chord>::operator()(std::istream& is, tr::scan_chord& out) const
-{
-	read_binary(is, out.mods, out.scan);
-}
-
-void tr::binary_writer<tr::scan_chord>::operator()(std::ostream& os, const tr::scan_chord& in) const
-{
-	write_binary(os, in.mods, in.scan);
-}
-
-void tr::binary_reader<tr::key_chord>::operator()(std::istream& is, tr::key_chord& out) const
-{
-	read_binary(is, out.mods, out.key);
-}
-
-void tr::binary_writer<tr::key_chord>::operator()(std::ostream& os, const tr::key_chord& in) const
-{
-	write_binary(os, in.mods, in.key);
 }
\ No newline at end of file
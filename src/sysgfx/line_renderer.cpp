@@ -0,0 +1,185 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements line_renderer.hpp.                                                                                                         //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/tr/sysgfx/line_renderer.hpp"
+
+////////////////////////////////////////////////////////////// LINE RENDERER //////////////////////////////////////////////////////////////
+
+namespace {
+// Vertex shader source code.
+#include <generated/line_renderer_vert.hpp>
+// Fragment shader source code.
+#include <generated/line_renderer_frag.hpp>
+
+// Gets the direction of a segment (or zero if the segment is degenerate).
+glm::vec2 segment_direction(glm::vec2 start, glm::vec2 end)
+{
+	const float length{glm::distance(start, end)};
+	return length > 0 ? (end - start) / length : glm::vec2{};
+}
+
+// Gets the normal of the bisector splitting the join between two segments (or zero if the join can't be split).
+glm::vec2 join_normal(glm::vec2 in, glm::vec2 out)
+{
+	// Segments that double back on themselves have no meaningful bisector.
+	const glm::vec2 normal{in + out};
+	return glm::dot(normal, normal) > 1e-6f ? normal : glm::vec2{};
+}
+} // namespace
+
+tr::line_renderer::line_renderer(graphics_context& context, float render_scale)
+	: m_id{context.allocate_renderer_id()}
+	, m_pipeline{context, vertex_shader{context, line_renderer_vert}, fragment_shader{context, line_renderer_frag}}
+	, m_vertex_format{context, vertex_format_bindings}
+	, m_stream_buffer{context}
+	, m_quad_vertices{context, std::array<glm::u8vec2, 4>{{{0, 0}, {0, 1}, {1, 1}, {1, 0}}}}
+{
+	m_pipeline.set_label("(tr) Line Renderer Pipeline");
+	m_pipeline.vertex_shader().set_label("(tr) Line Renderer Vertex Shader");
+	m_pipeline.fragment_shader().set_label("(tr) Line Renderer Fragment Shader");
+	m_vertex_format.set_label("(tr) Line Renderer Vertex Format");
+	m_stream_buffer.set_label("(tr) Line Renderer Stream Buffer");
+	m_quad_vertices.set_label("(tr) Line Renderer Quad Buffer");
+
+	set_render_scale(render_scale);
+}
+
+//
+
+tr::graphics_context& tr::line_renderer::context() const
+{
+	return m_pipeline.context();
+}
+
+//
+
+void tr::line_renderer::set_render_scale(float render_scale)
+{
+	TR_ASSERT(!m_locked, "Tried to set render scale on a locked line renderer.");
+
+	m_pipeline.vertex_shader().set_uniform(1, render_scale);
+}
+
+void tr::line_renderer::set_default_transform(const glm::mat4& mat)
+{
+	TR_ASSERT(!m_locked, "Tried to set default transform on a locked line renderer.");
+
+	m_default_transform = mat;
+}
+
+void tr::line_renderer::set_layer_transform(int layer, const glm::mat4& mat)
+{
+	TR_ASSERT(!m_locked, "Tried to set default layer transform on a locked line renderer.");
+
+	get_layer(layer).transform = mat;
+}
+
+void tr::line_renderer::set_layer_blend_mode(int layer, const blend_mode& blend_mode)
+{
+	TR_ASSERT(!m_locked, "Tried to set default layer blending mode on a locked line renderer.");
+
+	get_layer(layer).blend_mode = blend_mode;
+}
+
+//
+
+void tr::line_renderer::add_line(int layer, const line_segment& line, float width, rgba8 color, line_cap cap)
+{
+	TR_ASSERT(!m_locked, "Tried to add a line to a locked line renderer.");
+
+	push_segments(layer, std::array{line.a, line.b}, false, width, color, cap);
+}
+
+void tr::line_renderer::add_polyline(int layer, std::span<const glm::vec2> points, float width, rgba8 color, line_cap cap)
+{
+	TR_ASSERT(!m_locked, "Tried to add a polyline to a locked line renderer.");
+
+	push_segments(layer, points, false, width, color, cap);
+}
+
+void tr::line_renderer::add_polygon_outline(int layer, std::span<const glm::vec2> points, float width, rgba8 color)
+{
+	TR_ASSERT(!m_locked, "Tried to add a polygon outline to a locked line renderer.");
+
+	push_segments(layer, points, true, width, color, line_cap::round);
+}
+
+//
+
+tr::usize tr::line_renderer::allocations() const
+{
+	return m_allocations;
+}
+
+//
+
+tr::line_renderer::drawer tr::line_renderer::create_drawer(int min_layer, int max_layer)
+{
+	return drawer{*this,
+				  {std::ranges::lower_bound(m_layers, min_layer, std::less{}, &layer::priority),
+				   std::ranges::upper_bound(m_layers, max_layer, std::less{}, &layer::priority)}};
+}
+
+tr::line_renderer::drawer tr::line_renderer::create_drawer()
+{
+	return drawer{*this, m_layers};
+}
+
+void tr::line_renderer::draw(const render_target& target)
+{
+	create_drawer().draw(target);
+}
+
+//
+
+tr::line_renderer::layer& tr::line_renderer::get_layer(int layer)
+{
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.add_workload(layer);
+#endif
+
+	const auto it{std::ranges::lower_bound(m_layers, layer, std::less{}, &line_renderer::layer::priority)};
+	if (it != m_layers.end() && it->priority == layer) {
+		return *it;
+	}
+
+	if (m_layers.size() == m_layers.capacity()) {
+		++m_allocations;
+	}
+	return *m_layers.emplace(it, layer);
+}
+
+void tr::line_renderer::push_segments(int layer, std::span<const glm::vec2> points, bool closed, float width, rgba8 color, line_cap cap)
+{
+	if (points.size() < 2) {
+		return;
+	}
+
+	const usize count{closed ? points.size() : points.size() - 1};
+	std::vector<segment>& segments{get_layer(layer).segments};
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.add_workload(count);
+#endif
+	if (segments.size() + count > segments.capacity()) {
+		++m_allocations;
+	}
+
+	// Interior ends are rounded so that the caps of neighbouring segments form round joins. Each join is split in half along the bisector
+	// of its segments, and every segment only draws its own half so that translucent joins aren't blended twice.
+	constexpr u32 round{u32(line_cap::round)};
+	for (usize i = 0; i < count; ++i) {
+		const glm::vec2 start{points[i]};
+		const glm::vec2 end{points[(i + 1) % points.size()]};
+		const glm::vec2 direction{segment_direction(start, end)};
+		const bool first{i == 0 && !closed};
+		const bool last{i == count - 1 && !closed};
+		const glm::vec2 previous{points[(i + points.size() - 1) % points.size()]};
+		const glm::vec2 next{points[(i + 2) % points.size()]};
+		const glm::vec2 start_join{first ? glm::vec2{} : join_normal(segment_direction(previous, start), direction)};
+		const glm::vec2 end_join{last ? glm::vec2{} : join_normal(direction, segment_direction(end, next))};
+		segments.push_back({start, end, width, color, (first ? u32(cap) : round) | (last ? u32(cap) : round) << 2, start_join, end_join});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements the drawer from line_renderer.hpp.                                                                                         //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/tr/sysgfx/line_renderer.hpp"
+
+////////////////////////////////////////////////////////////////// DRAWER /////////////////////////////////////////////////////////////////
+
+tr::line_renderer::drawer::drawer(line_renderer& renderer, std::ranges::subrange<std::vector<layer>::iterator> range)
+	: layered_instance_drawer{renderer, range}
+{
+	upload();
+}
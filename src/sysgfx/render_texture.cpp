@@ -7,6 +7,7 @@
 tr::render_texture::render_texture(graphics_context& context)
 	: texture{context}
 {
+	m_renderable = true;
 }
 
 tr::render_texture::render_texture(graphics_context& context, glm::ivec2 size, mipmaps mipmaps, pixel_format format)
@@ -14,6 +15,7 @@ tr::render_texture::render_texture(graphics_context& context, glm::ivec2 size, m
 {
 	const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
 
+	m_renderable = true;
 	gl.create_framebuffers(1, &m_fbo);
 	gl.set_framebuffer_texture(m_fbo, GL_COLOR_ATTACHMENT0, m_handle, 0);
 }
@@ -59,8 +59,12 @@ void tr::shader_base::texture_unit::set(texture_ref texture)
 ////////////////////////////////////////////////////////////////// SHADER /////////////////////////////////////////////////////////////////
 
 tr::shader_base::shader_base(graphics_context& context, zstring_view source, unsigned int type)
-	: m_program{context.make_current_and_return_glapi().create_shader_program_v(type, 1, reinterpret_cast<const char**>(&source)),
-				{context}}
+	: shader_base{context, context.create_shader_program(type, source)}
+{
+}
+
+tr::shader_base::shader_base(graphics_context& context, unsigned int program)
+	: m_program{program, {context}}
 {
 	const graphics_context::glapi& gl{context.make_current_and_return_glapi()};
 
@@ -192,12 +196,31 @@ tr::graphics_context& tr::shader_base::context() const
 	return m_program.get_deleter().context;
 }
 
+namespace tr {
+	namespace {
+		// Gets the bytes of a uniform value.
+		template <class T> std::span<const std::byte> uniform_bytes(const T& value)
+		{
+			return std::as_bytes(std::span{&value, 1});
+		}
+		// Gets the bytes of an array uniform value.
+		template <class T> std::span<const std::byte> uniform_bytes(std::span<const T> value)
+		{
+			return std::as_bytes(value);
+		}
+	} // namespace
+} // namespace tr
+
 //
 
 void tr::shader_base::set_uniform(int index, bool value)
 {
 	TR_ASSERT_SHADER_UNIFORM(bool);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_1i(m_program.get(), index, value);
@@ -207,6 +230,10 @@ void tr::shader_base::set_uniform(int index, int value)
 {
 	TR_ASSERT_SHADER_UNIFORM(int);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_1i(m_program.get(), index, value);
@@ -216,6 +243,10 @@ void tr::shader_base::set_uniform(int index, std::span<const int> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(int);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_1iv(m_program.get(), index, value.size(), value.data());
@@ -225,6 +256,10 @@ void tr::shader_base::set_uniform(int index, glm::ivec2 value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::ivec2);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_2i(m_program.get(), index, value.x, value.y);
@@ -234,6 +269,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::ivec2> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::ivec2);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_2iv(m_program.get(), index, value.size(), value_ptr(value[0]));
@@ -243,6 +282,10 @@ void tr::shader_base::set_uniform(int index, glm::ivec3 value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::ivec3);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_3i(m_program.get(), index, value.x, value.y, value.z);
@@ -252,6 +295,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::ivec3> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::ivec3);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_3iv(m_program.get(), index, value.size(), value_ptr(value[0]));
@@ -261,6 +308,10 @@ void tr::shader_base::set_uniform(int index, glm::ivec4 value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::ivec4);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_4i(m_program.get(), index, value.x, value.y, value.z, value.w);
@@ -270,6 +321,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::ivec4> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::ivec4);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_4iv(m_program.get(), index, value.size(), value_ptr(value[0]));
@@ -279,6 +334,10 @@ void tr::shader_base::set_uniform(int index, unsigned int value)
 {
 	TR_ASSERT_SHADER_UNIFORM(unsigned int);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_1ui(m_program.get(), index, value);
@@ -288,6 +347,10 @@ void tr::shader_base::set_uniform(int index, std::span<const unsigned int> value
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(unsigned int);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_1uiv(m_program.get(), index, value.size(), value.data());
@@ -297,6 +360,10 @@ void tr::shader_base::set_uniform(int index, glm::uvec2 value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::uvec2);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_2ui(m_program.get(), index, value.x, value.y);
@@ -306,6 +373,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::uvec2> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::uvec2);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_2uiv(m_program.get(), index, value.size(), value_ptr(value[0]));
@@ -315,6 +386,10 @@ void tr::shader_base::set_uniform(int index, glm::uvec3 value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::uvec3);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_3ui(m_program.get(), index, value.x, value.y, value.z);
@@ -324,6 +399,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::uvec3> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::uvec3);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_3uiv(m_program.get(), index, value.size(), value_ptr(value[0]));
@@ -333,6 +412,10 @@ void tr::shader_base::set_uniform(int index, glm::uvec4 value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::uvec4);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_4ui(m_program.get(), index, value.x, value.y, value.z, value.w);
@@ -342,6 +425,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::uvec4> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::uvec4);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_4uiv(m_program.get(), index, value.size(), value_ptr(value[0]));
@@ -351,6 +438,10 @@ void tr::shader_base::set_uniform(int index, float value)
 {
 	TR_ASSERT_SHADER_UNIFORM(float);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_1f(m_program.get(), index, value);
@@ -360,6 +451,10 @@ void tr::shader_base::set_uniform(int index, std::span<const float> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(float);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_1fv(m_program.get(), index, value.size(), value.data());
@@ -369,6 +464,10 @@ void tr::shader_base::set_uniform(int index, glm::vec2 value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::vec2);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_2f(m_program.get(), index, value.x, value.y);
@@ -378,6 +477,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::vec2> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::vec2);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_2fv(m_program.get(), index, value.size(), value_ptr(value[0]));
@@ -387,6 +490,10 @@ void tr::shader_base::set_uniform(int index, glm::vec3 value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::vec3);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_3f(m_program.get(), index, value.x, value.y, value.z);
@@ -396,6 +503,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::vec3> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::vec3);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_3fv(m_program.get(), index, value.size(), value_ptr(value[0]));
@@ -405,6 +516,10 @@ void tr::shader_base::set_uniform(int index, glm::vec4 value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::vec4);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_4f(m_program.get(), index, value.x, value.y, value.z, value.w);
@@ -414,6 +529,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::vec4> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::vec4);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_4fv(m_program.get(), index, value.size(), value_ptr(value[0]));
@@ -423,6 +542,10 @@ void tr::shader_base::set_uniform(int index, const glm::mat2& value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::mat2);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix2fv(m_program.get(), index, 1, false, value_ptr(value));
@@ -432,6 +555,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::mat2> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::mat2);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix2fv(m_program.get(), index, value.size(), false, value_ptr(value[0]));
@@ -441,6 +568,10 @@ void tr::shader_base::set_uniform(int index, const glm::mat3& value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::mat3);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix3fv(m_program.get(), index, 1, false, value_ptr(value));
@@ -450,6 +581,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::mat3> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::mat3);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix3fv(m_program.get(), index, value.size(), false, value_ptr(value[0]));
@@ -459,6 +594,10 @@ void tr::shader_base::set_uniform(int index, const glm::mat4& value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::mat4);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix4fv(m_program.get(), index, 1, false, value_ptr(value));
@@ -468,6 +607,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::mat4> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::mat4);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix4fv(m_program.get(), index, value.size(), false, value_ptr(value[0]));
@@ -477,6 +620,10 @@ void tr::shader_base::set_uniform(int index, const glm::mat2x3& value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::mat2x3);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix2x3fv(m_program.get(), index, 1, false, value_ptr(value));
@@ -486,6 +633,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::mat2x3> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::mat2x3);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix2x3fv(m_program.get(), index, value.size(), false, value_ptr(value[0]));
@@ -495,6 +646,10 @@ void tr::shader_base::set_uniform(int index, const glm::mat2x4& value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::mat2x4);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix2x4fv(m_program.get(), index, 1, false, value_ptr(value));
@@ -504,6 +659,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::mat2x4> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::mat2x4);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix2x4fv(m_program.get(), index, value.size(), false, value_ptr(value[0]));
@@ -513,6 +672,10 @@ void tr::shader_base::set_uniform(int index, const glm::mat3x2& value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::mat3x2);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix3x2fv(m_program.get(), index, 1, false, value_ptr(value));
@@ -522,6 +685,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::mat3x2> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::mat3x2);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix3x2fv(m_program.get(), index, value.size(), false, value_ptr(value[0]));
@@ -531,6 +698,10 @@ void tr::shader_base::set_uniform(int index, const glm::mat3x4& value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::mat3x4);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix3x4fv(m_program.get(), index, 1, false, value_ptr(value));
@@ -540,6 +711,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::mat3x4> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::mat3x4);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix3x4fv(m_program.get(), index, value.size(), false, value_ptr(value[0]));
@@ -549,6 +724,10 @@ void tr::shader_base::set_uniform(int index, const glm::mat4x2& value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::mat4x2);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix4x2fv(m_program.get(), index, 1, false, value_ptr(value));
@@ -558,6 +737,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::mat4x2> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::mat4x2);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix4x2fv(m_program.get(), index, value.size(), false, value_ptr(value[0]));
@@ -567,6 +750,10 @@ void tr::shader_base::set_uniform(int index, const glm::mat4x3& value)
 {
 	TR_ASSERT_SHADER_UNIFORM(glm::mat4x3);
 
+	if (!update_uniform_value(index, uniform_bytes(value), 1)) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix4x3fv(m_program.get(), index, 1, false, value_ptr(value));
@@ -576,6 +763,10 @@ void tr::shader_base::set_uniform(int index, std::span<const glm::mat4x3> value)
 {
 	TR_ASSERT_SHADER_ARRAY_UNIFORM(glm::mat4x3);
 
+	if (!update_uniform_value(index, uniform_bytes(value), value.size())) {
+		return;
+	}
+
 	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
 
 	gl.set_program_uniform_matrix4x3fv(m_program.get(), index, value.size(), false, value_ptr(value[0]));
@@ -586,8 +777,9 @@ void tr::shader_base::set_uniform(int index, texture_ref texture)
 #ifdef TR_ENABLE_GL_CHECKS
 	const auto uniform_it{m_uniforms.find(index)};
 	TR_ASSERT(uniform_it != m_uniforms.end(), "Tried to set uniform with invalid index '{}' in shader '{}'.", index, label());
-	TR_ASSERT(uniform_it->second.type == glsl_type::sampler2D && uniform_it->second.array_size == 1,
-			  "Tried to set uniform with signature '{}' in shader '{}' with a value of type 'sampler2D'.", uniform_it->second, label());
+	TR_ASSERT((uniform_it->second.type == glsl_type::sampler2D || uniform_it->second.type == glsl_type::sampler2DArray) &&
+				  uniform_it->second.array_size == 1,
+			  "Tried to set uniform with signature '{}' in shader '{}' with a texture value.", uniform_it->second, label());
 #endif
 
 	auto unit_it{m_texture_units.find(index)};
@@ -599,9 +791,7 @@ void tr::shader_base::set_uniform(int index, texture_ref texture)
 
 void tr::shader_base::set_storage_buffer(unsigned int index, basic_shader_buffer& buffer)
 {
-	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
-
-	gl.bind_buffer_range(GL_SHADER_STORAGE_BUFFER, index, buffer.id(), 0, buffer.header_size() + buffer.array_size());
+	context().bind_storage_buffer(index, buffer.id(), 0, buffer.header_size() + buffer.array_size());
 }
 
 void tr::shader_base::set_uniform_buffer(unsigned int index, const basic_uniform_buffer& buffer)
@@ -636,6 +826,41 @@ std::string tr::shader_base::label() const
 	}
 }
 
+//
+
+bool tr::shader_base::update_uniform_value(int index, std::span<const std::byte> value, usize locations)
+{
+	// Locations that don't exist are ignored by OpenGL, so there is nothing to shadow.
+	if (index < 0) {
+		return true;
+	}
+
+	// Every element of an array uniform occupies its own location, so each one is shadowed separately. This keeps the shadows correct
+	// when an array is set at once and its elements are later set individually (or the other way around).
+	const usize size{value.size() / locations};
+	TR_ASSERT(size <= sizeof(uniform_value::bytes), "Tried to set a uniform location to a value larger than {} bytes.",
+			  sizeof(uniform_value::bytes));
+	if (usize(index) + locations > m_uniform_values.size()) {
+		m_uniform_values.resize(usize(index) + locations);
+	}
+
+	const std::span<uniform_value> last_values{std::span{m_uniform_values}.subspan(index, locations)};
+	bool changed{false};
+	for (usize i = 0; i < locations && !changed; ++i) {
+		const uniform_value& last_value{last_values[i]};
+		changed = last_value.size != size || !std::ranges::equal(std::span{last_value.bytes}.first(size), value.subspan(i * size, size));
+	}
+	if (!context().record_state_change(changed)) {
+		return false;
+	}
+
+	for (usize i = 0; i < locations; ++i) {
+		std::ranges::copy(value.subspan(i * size, size), last_values[i].bytes.begin());
+		last_values[i].size = u8(size);
+	}
+	return true;
+}
+
 ////////////////////////////////////////////////////////////// SHADER CLASSES /////////////////////////////////////////////////////////////
 
 tr::vertex_shader::vertex_shader(graphics_context& context, zstring_view source)
@@ -643,6 +868,11 @@ tr::vertex_shader::vertex_shader(graphics_context& context, zstring_view source)
 {
 }
 
+tr::vertex_shader::vertex_shader(graphics_context& context, unsigned int program)
+	: shader_base{context, program}
+{
+}
+
 tr::vertex_shader tr::load_vertex_shader(graphics_context& context, const std::filesystem::path& path)
 {
 	try {
@@ -667,6 +897,11 @@ tr::fragment_shader::fragment_shader(graphics_context& context, zstring_view sou
 {
 }
 
+tr::fragment_shader::fragment_shader(graphics_context& context, unsigned int program)
+	: shader_base{context, program}
+{
+}
+
 tr::fragment_shader tr::load_fragment_shader(graphics_context& context, const std::filesystem::path& path)
 {
 	try {
@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements shader_batch.hpp.                                                                                                          //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/tr/sysgfx/shader_batch.hpp"
+#include "../../include/tr/sysgfx/gl_defines.hpp"
+#include "../../include/tr/sysgfx/graphics_context.hpp"
+
+/////////////////////////////////////////////////////////////// SHADER BATCH //////////////////////////////////////////////////////////////
+
+tr::shader_batch::shader_batch(graphics_context& context)
+	: m_context{context}
+{
+}
+
+void tr::shader_batch::deleter::operator()(unsigned int id) const
+{
+	const graphics_context::glapi& gl{context.make_current_and_return_glapi()};
+
+	gl.delete_program(id);
+}
+
+//
+
+tr::graphics_context& tr::shader_batch::context() const
+{
+	return m_context;
+}
+
+//
+
+tr::usize tr::shader_batch::add_vertex_shader(std::string source)
+{
+	return add_shader(GL_VERTEX_SHADER, std::move(source));
+}
+
+tr::usize tr::shader_batch::add_fragment_shader(std::string source)
+{
+	return add_shader(GL_FRAGMENT_SHADER, std::move(source));
+}
+
+//
+
+tr::usize tr::shader_batch::size() const
+{
+	return m_entries.size();
+}
+
+tr::usize tr::shader_batch::finished() const
+{
+	// Without parallel compilation, querying the completion status isn't possible without blocking.
+	if (!m_context.m_parallel_shader_compile) {
+		return m_entries.size();
+	}
+
+	if (m_finished != m_entries.size()) {
+		const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
+		for (const entry& shader : m_entries) {
+			if (!shader.finished) {
+				int completed;
+				gl.get_program_iv(shader.program.get(), GL_COMPLETION_STATUS_KHR, &completed);
+				if (completed) {
+					shader.finished = true;
+					++m_finished;
+				}
+			}
+		}
+	}
+	return m_finished;
+}
+
+bool tr::shader_batch::ready() const
+{
+	return finished() == m_entries.size();
+}
+
+//
+
+tr::vertex_shader tr::shader_batch::take_vertex_shader(usize index)
+{
+	return vertex_shader{m_context, take_program(index, GL_VERTEX_SHADER)};
+}
+
+tr::fragment_shader tr::shader_batch::take_fragment_shader(usize index)
+{
+	return fragment_shader{m_context, take_program(index, GL_FRAGMENT_SHADER)};
+}
+
+tr::owning_shader_pipeline tr::shader_batch::take_pipeline(usize vshader, usize fshader)
+{
+	return owning_shader_pipeline{m_context, take_vertex_shader(vshader), take_fragment_shader(fshader)};
+}
+
+//
+
+tr::usize tr::shader_batch::add_shader(unsigned int type, std::string&& source)
+{
+	const unsigned int cached_program{m_context.load_cached_shader_program(type, source)};
+	if (cached_program != 0) {
+		m_entries.push_back({program_handle{cached_program, {m_context}}, type, {}, true, true});
+		++m_finished;
+	}
+	else {
+		const unsigned int program{m_context.compile_shader_program(type, source)};
+		m_entries.push_back({program_handle{program, {m_context}}, type, std::move(source), false, false});
+	}
+	return m_entries.size() - 1;
+}
+
+unsigned int tr::shader_batch::take_program(usize index, unsigned int type)
+{
+	TR_ASSERT(index < m_entries.size(), "Tried to take out-of-bounds shader {} from a batch of {} shaders.", index, m_entries.size());
+	entry& shader{m_entries[index]};
+	TR_ASSERT(shader.program.has_value(), "Tried to take shader {} out of a batch twice.", index);
+	TR_ASSERT(shader.type == type, "Tried to take shader {} out of a batch as the wrong type of shader.", index);
+
+	if (!shader.cached) {
+		m_context.store_cached_shader_program(shader.program.get(), shader.type, shader.source);
+		shader.source = {};
+	}
+	if (!shader.finished) {
+		shader.finished = true;
+		++m_finished;
+	}
+	return shader.program.release();
+}
\ No newline at end of file
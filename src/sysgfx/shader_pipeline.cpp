@@ -50,6 +50,7 @@ void tr::shader_pipeline::deleter::operator()(unsigned int id) const
 {
 	const graphics_context::glapi& gl{context.make_current_and_return_glapi()};
 
+	context.forget_shader_pipeline(id);
 	gl.delete_program_pipelines(1, &id);
 }
 
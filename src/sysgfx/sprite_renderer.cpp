@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements sprite_renderer.hpp.                                                                                                       //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/tr/sysgfx/sprite_renderer.hpp"
+#include "../../include/tr/utility/norm_cast.hpp"
+
+///////////////////////////////////////////////////////////// SPRITE RENDERER /////////////////////////////////////////////////////////////
+
+namespace {
+// Vertex shader source code.
+#include <generated/sprite_renderer_vert.hpp>
+// Fragment shader source code.
+#include <generated/sprite_renderer_frag.hpp>
+} // namespace
+
+tr::sprite_renderer::sprite_renderer(graphics_context& context)
+	: m_id{context.allocate_renderer_id()}
+	, m_pipeline{context, vertex_shader{context, sprite_renderer_vert}, fragment_shader{context, sprite_renderer_frag}}
+	, m_vertex_format{context, vertex_format_bindings}
+	, m_stream_buffer{context}
+	, m_quad_vertices{context, std::array<glm::u8vec2, 4>{{{0, 0}, {0, 1}, {1, 1}, {1, 0}}}}
+{
+	m_pipeline.set_label("(tr) Sprite Renderer Pipeline");
+	m_pipeline.vertex_shader().set_label("(tr) Sprite Renderer Vertex Shader");
+	m_pipeline.fragment_shader().set_label("(tr) Sprite Renderer Fragment Shader");
+	m_vertex_format.set_label("(tr) Sprite Renderer Vertex Format");
+	m_stream_buffer.set_label("(tr) Sprite Renderer Stream Buffer");
+	m_quad_vertices.set_label("(tr) Sprite Renderer Quad Buffer");
+
+	// Every slot is given its own texture unit up front, even if it is never used.
+	for (int slot = 0; slot < texture_slots; ++slot) {
+		set_texture(slot, texture_ref{});
+	}
+}
+
+//
+
+tr::graphics_context& tr::sprite_renderer::context() const
+{
+	return m_pipeline.context();
+}
+
+//
+
+void tr::sprite_renderer::set_texture(int slot, texture_ref texture)
+{
+	TR_ASSERT(!m_locked, "Tried to set texture on a locked sprite renderer.");
+	TR_ASSERT(slot >= 0 && slot < texture_slots, "Tried to set invalid texture slot {} on a sprite renderer.", slot);
+
+	m_pipeline.fragment_shader().set_uniform(1 + slot, std::move(texture));
+}
+
+void tr::sprite_renderer::set_default_transform(const glm::mat4& mat)
+{
+	TR_ASSERT(!m_locked, "Tried to set default transform on a locked sprite renderer.");
+
+	m_default_transform = mat;
+}
+
+void tr::sprite_renderer::set_layer_transform(int layer, const glm::mat4& mat)
+{
+	TR_ASSERT(!m_locked, "Tried to set default layer transform on a locked sprite renderer.");
+
+	get_layer(layer).transform = mat;
+}
+
+void tr::sprite_renderer::set_layer_blend_mode(int layer, const blend_mode& blend_mode)
+{
+	TR_ASSERT(!m_locked, "Tried to set default layer blending mode on a locked sprite renderer.");
+
+	get_layer(layer).blend_mode = blend_mode;
+}
+
+//
+
+void tr::sprite_renderer::add_sprite(int layer, glm::vec2 position, glm::vec2 size, angle rotation, const rectangle<float>& uvs, rgba8 tint,
+									 u16 texture_slot)
+{
+	const float turns{rotation.turns() - std::floor(rotation.turns())};
+	const glm::vec2 br{uvs.tl + uvs.size};
+	add_sprite(layer, {position, size,
+					   glm::u16vec4{norm_cast<u16>(uvs.tl.x), norm_cast<u16>(uvs.tl.y), norm_cast<u16>(br.x), norm_cast<u16>(br.y)}, tint,
+					   norm_cast<u16>(turns), texture_slot});
+}
+
+void tr::sprite_renderer::add_sprite(int layer, const sprite& sprite)
+{
+	add_sprites(layer, {&sprite, 1});
+}
+
+void tr::sprite_renderer::add_sprites(int layer, std::span<const sprite> sprites)
+{
+	TR_ASSERT(!m_locked, "Tried to add sprites to a locked sprite renderer.");
+	TR_ASSERT(std::ranges::all_of(sprites,
+								  [](const sprite& sprite) {
+									  return sprite.texture_slot < texture_slots || sprite.texture_slot == sprite::untextured;
+								  }),
+			  "Tried to add a sprite with an invalid texture slot to a sprite renderer.");
+
+	std::vector<sprite>& layer_sprites{get_layer(layer).sprites};
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.add_workload(sprites.size());
+#endif
+	if (layer_sprites.size() + sprites.size() > layer_sprites.capacity()) {
+		++m_allocations;
+	}
+	layer_sprites.insert(layer_sprites.end(), sprites.begin(), sprites.end());
+}
+
+//
+
+tr::usize tr::sprite_renderer::allocations() const
+{
+	return m_allocations;
+}
+
+//
+
+tr::sprite_renderer::drawer tr::sprite_renderer::create_drawer(int min_layer, int max_layer)
+{
+	return drawer{*this,
+				  {std::ranges::lower_bound(m_layers, min_layer, std::less{}, &layer::priority),
+				   std::ranges::upper_bound(m_layers, max_layer, std::less{}, &layer::priority)}};
+}
+
+tr::sprite_renderer::drawer tr::sprite_renderer::create_drawer()
+{
+	return drawer{*this, m_layers};
+}
+
+void tr::sprite_renderer::draw(const render_target& target)
+{
+	create_drawer().draw(target);
+}
+
+//
+
+tr::sprite_renderer::layer& tr::sprite_renderer::get_layer(int layer)
+{
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.add_workload(layer);
+#endif
+
+	const auto it{std::ranges::lower_bound(m_layers, layer, std::less{}, &sprite_renderer::layer::priority)};
+	if (it != m_layers.end() && it->priority == layer) {
+		return *it;
+	}
+
+	if (m_layers.size() == m_layers.capacity()) {
+		++m_allocations;
+	}
+	return *m_layers.emplace(it, layer);
+}
\ No newline at end of file
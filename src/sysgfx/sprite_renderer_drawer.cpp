@@ -0,0 +1,15 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements the drawer from sprite_renderer.hpp.                                                                                       //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/tr/sysgfx/sprite_renderer.hpp"
+
+////////////////////////////////////////////////////////////////// DRAWER /////////////////////////////////////////////////////////////////
+
+tr::sprite_renderer::drawer::drawer(sprite_renderer& renderer, std::ranges::subrange<std::vector<layer>::iterator> range)
+	: layered_instance_drawer{renderer, range}
+{
+	upload();
+}
@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements the non-templated parts of stream_buffer.hpp.                                                                              //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/tr/sysgfx/stream_buffer.hpp"
+#include "../../include/tr/sysgfx/gl_defines.hpp"
+#include "../../include/tr/sysgfx/graphics_context.hpp"
+#include "../../include/tr/utility/exception.hpp"
+
+////////////////////////////////////////////////////////////// STREAM BUFFER //////////////////////////////////////////////////////////////
+
+namespace tr {
+	namespace {
+		// Flags used for both the storage and the mapping of a stream buffer.
+		constexpr unsigned int stream_buffer_flags{GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT};
+		// Minimum capacity of a region, keeps the starts of regions suitably aligned for any element type.
+		constexpr usize min_region_capacity{256};
+	} // namespace
+} // namespace tr
+
+tr::stream_buffer::stream_buffer(graphics_context& context, usize regions)
+	: graphics_buffer{context}
+{
+	TR_ASSERT(regions > 0, "Tried to create a stream buffer with no regions.");
+
+	m_fences.reserve(regions);
+	for (usize i = 0; i < regions; ++i) {
+		m_fences.emplace_back(fence_deleter{context});
+	}
+}
+
+void tr::stream_buffer::fence_deleter::operator()(void* fence) const
+{
+	const graphics_context::glapi& gl{context.make_current_and_return_glapi()};
+
+	gl.delete_sync(fence);
+}
+
+//
+
+tr::usize tr::stream_buffer::region_capacity() const
+{
+	return m_region_capacity;
+}
+
+tr::usize tr::stream_buffer::region_size() const
+{
+	return m_region_size;
+}
+
+//
+
+void tr::stream_buffer::begin_region(usize capacity)
+{
+	if (m_region_size != 0 && !m_fences[m_region].has_value()) {
+		fence();
+	}
+
+	if (capacity > m_region_capacity) {
+		const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
+
+		capacity = std::bit_ceil(std::max(capacity, min_region_capacity));
+
+		// The old buffer is implicitly unmapped, and the driver keeps it alive until the GPU is done reading from it.
+		reallocate();
+		gl.allocate_buffer_storage(id(), capacity * m_fences.size(), nullptr, stream_buffer_flags);
+		m_map = static_cast<std::byte*>(gl.map_buffer_range(id(), 0, capacity * m_fences.size(), stream_buffer_flags));
+		if (gl.get_error() == GL_OUT_OF_MEMORY || m_map == nullptr) {
+			throw out_of_memory{"allocation of stream buffer '{}'", label()};
+		}
+		for (fence_handle& fence : m_fences) {
+			fence.reset();
+		}
+		m_region_capacity = capacity;
+		m_region = 0;
+	}
+	else {
+		m_region = (m_region + 1) % m_fences.size();
+		wait_for_region(m_region);
+	}
+	m_region_size = 0;
+}
+
+tr::usize tr::stream_buffer::allocate(usize size, usize alignment)
+{
+	const usize offset{(m_region_size + alignment - 1) / alignment * alignment};
+
+	TR_ASSERT(offset + size <= m_region_capacity, "Tried to allocate {} bytes past the end of a region of stream buffer '{}' (capacity {}).",
+			  offset + size - m_region_capacity, label(), m_region_capacity);
+
+	m_region_size = offset + size;
+	return m_region * m_region_capacity + offset;
+}
+
+std::span<std::byte> tr::stream_buffer::mapped(usize offset, usize size) const
+{
+	TR_ASSERT(offset + size <= m_region_capacity * m_fences.size(),
+			  "Tried to get out-of-bounds mapped region [{}, {}) of stream buffer '{}' of size {}.", offset, offset + size, label(),
+			  m_region_capacity * m_fences.size());
+
+	return {m_map + offset, size};
+}
+
+void tr::stream_buffer::fence()
+{
+	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
+
+	m_fences[m_region].reset(gl.fence_sync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+}
+
+//
+
+void tr::stream_buffer::wait_for_region(usize region)
+{
+	if (!m_fences[region].has_value()) {
+		return;
+	}
+
+	context().wait_for_fence(m_fences[region].get());
+	m_fences[region].reset();
+}
\ No newline at end of file
@@ -0,0 +1,328 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements text_renderer.hpp.                                                                                                         //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/tr/sysgfx/text_renderer.hpp"
+#include "../../include/tr/sysgfx/bitmap.hpp"
+
+////////////////////////////////////////////////////////////// TEXT RENDERER //////////////////////////////////////////////////////////////
+
+namespace {
+// Vertex shader source code.
+#include <generated/text_renderer_vert.hpp>
+// Fragment shader source code.
+#include <generated/text_renderer_frag.hpp>
+} // namespace
+
+tr::text_renderer::text_renderer(graphics_context& context)
+	: m_id{context.allocate_renderer_id()}
+	, m_atlas{context, initial_atlas_size}
+	, m_pipeline{context, vertex_shader{context, text_renderer_vert}, fragment_shader{context, text_renderer_frag}}
+	, m_vertex_format{context, vertex_format_bindings}
+	, m_stream_buffer{context}
+	, m_quad_vertices{context, std::array<glm::u8vec2, 4>{{{0, 0}, {0, 1}, {1, 1}, {1, 0}}}}
+{
+	m_atlas.set_label("(tr) Text Renderer Glyph Atlas");
+	m_pipeline.set_label("(tr) Text Renderer Pipeline");
+	m_pipeline.vertex_shader().set_label("(tr) Text Renderer Vertex Shader");
+	m_pipeline.fragment_shader().set_label("(tr) Text Renderer Fragment Shader");
+	m_vertex_format.set_label("(tr) Text Renderer Vertex Format");
+	m_stream_buffer.set_label("(tr) Text Renderer Stream Buffer");
+	m_quad_vertices.set_label("(tr) Text Renderer Quad Buffer");
+
+	// Glyphs are drawn pixel-for-pixel, so nearest filtering keeps them crisp and prevents bleeding between neighbouring glyphs.
+	m_atlas.set_filtering(min_filter::nearest, mag_filter::nearest);
+	// The atlas texture is rebound automatically whenever it grows.
+	m_pipeline.fragment_shader().set_uniform(0, m_atlas);
+}
+
+//
+
+tr::graphics_context& tr::text_renderer::context() const
+{
+	return m_pipeline.context();
+}
+
+//
+
+tr::usize tr::text_renderer::add_font(ttfont&& font)
+{
+	TR_ASSERT(!m_locked, "Tried to add a font to a locked text renderer.");
+
+	if (m_fonts.size() == m_fonts.capacity()) {
+		++m_allocations;
+	}
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.invalidate();
+#endif
+	m_fonts.push_back({std::move(font), 0});
+	return m_fonts.size() - 1;
+}
+
+//
+
+void tr::text_renderer::set_default_transform(const glm::mat4& mat)
+{
+	TR_ASSERT(!m_locked, "Tried to set default transform on a locked text renderer.");
+
+	m_default_transform = mat;
+}
+
+void tr::text_renderer::set_layer_transform(int layer, const glm::mat4& mat)
+{
+	TR_ASSERT(!m_locked, "Tried to set default layer transform on a locked text renderer.");
+
+	get_layer(layer).transform = mat;
+}
+
+void tr::text_renderer::set_layer_blend_mode(int layer, const blend_mode& blend_mode)
+{
+	TR_ASSERT(!m_locked, "Tried to set default layer blending mode on a locked text renderer.");
+
+	get_layer(layer).blend_mode = blend_mode;
+}
+
+//
+
+void tr::text_renderer::add_text(int layer, glm::vec2 pos, usize font, float size, std::string_view text, rgba8 color, int max_w,
+								 halign align)
+{
+	const text_span span{text, color};
+	add_text(layer, pos, font, size, {&span, 1}, max_w, align);
+}
+
+void tr::text_renderer::add_text(int layer, glm::vec2 pos, usize font, float size, std::span<const text_span> spans, int max_w,
+								 halign align)
+{
+	TR_ASSERT(!m_locked, "Tried to add text to a locked text renderer.");
+	TR_ASSERT(font < m_fonts.size(), "Tried to add text with invalid font index {} to a text renderer.", font);
+
+	font_entry& entry{m_fonts[font]};
+	if (entry.size != size) {
+		entry.font.resize(size);
+		entry.size = size;
+	}
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.add_workload(font);
+	m_allocation_check.add_workload(size);
+	m_allocation_check.add_workload(max_w);
+	for (const text_span& span : spans) {
+		m_allocation_check.add_workload(span.text);
+	}
+#endif
+
+	// The spans are joined so that lines can be split and broken across them.
+	usize text_size{0};
+	for (const text_span& span : spans) {
+		text_size += span.text.size();
+	}
+	if (text_size > m_text_scratch.capacity()) {
+		++m_allocations;
+		m_text_scratch.reserve(text_size);
+	}
+	if (spans.size() > m_span_ends.capacity()) {
+		++m_allocations;
+		m_span_ends.reserve(spans.size());
+	}
+	m_text_scratch.clear();
+	m_span_ends.clear();
+	for (const text_span& span : spans) {
+		m_text_scratch += span.text;
+		m_span_ends.push_back(m_text_scratch.size());
+	}
+
+	const usize lines_capacity{m_lines.capacity()};
+	m_lines.clear();
+	split_into_lines(m_text_scratch, m_lines);
+	if (max_w != unlimited_width) {
+		m_lines = break_overlong_lines(std::move(m_lines), entry.font, max_w);
+	}
+	if (m_lines.capacity() != lines_capacity) {
+		++m_allocations;
+	}
+	const std::vector<std::string_view>& lines{m_lines};
+
+	if (lines.size() > m_line_widths.capacity()) {
+		++m_allocations;
+		m_line_widths.reserve(lines.size());
+	}
+	m_line_widths.clear();
+	for (std::string_view line : lines) {
+		m_line_widths.push_back(line_width(font, line));
+	}
+	const int box_width{max_w == unlimited_width ? std::ranges::max(m_line_widths) : max_w};
+
+	std::vector<glyph>& glyphs{get_layer(layer).glyphs};
+	usize span{0};
+	for (usize i = 0; i < lines.size(); ++i) {
+		int offset{0};
+		switch (align) {
+		case halign::left:
+			break;
+		case halign::center:
+			offset = (box_width - m_line_widths[i]) / 2;
+			break;
+		case halign::right:
+			offset = box_width - m_line_widths[i];
+			break;
+		}
+		const glm::vec2 line_pos{glm::round(pos + glm::vec2{offset, int(i) * entry.font.line_skip()})};
+
+		int x{0};
+		codepoint prev{0};
+		for (utf8::iterator it = utf8::begin(lines[i]); it != utf8::end(lines[i]); ++it) {
+			const codepoint cp{*it};
+			if (prev != 0) {
+				x += cached_kerning(font, prev, cp);
+			}
+			const int advance{cache_glyph(font, cp)};
+
+			// Glyph bitmaps span the entire height of the line, so they are placed at its top.
+			const glyph_key key{font, size, cp};
+			if (m_atlas.contains(key)) {
+				while (usize(it.base() - m_text_scratch.data()) >= m_span_ends[span]) {
+					++span;
+				}
+				if (glyphs.size() == glyphs.capacity()) {
+					++m_allocations;
+				}
+				const rectangle<u16>& rect{m_atlas.raw(key)};
+				glyphs.push_back({{line_pos.x + x, line_pos.y}, glm::u16vec4{rect.tl, rect.size}, spans[span].color});
+			}
+			x += advance;
+			prev = cp;
+		}
+	}
+}
+
+//
+
+tr::usize tr::text_renderer::cached_glyphs() const
+{
+	return m_advances.size();
+}
+
+void tr::text_renderer::clear_glyph_cache()
+{
+	TR_ASSERT(!m_locked, "Tried to clear the glyph cache of a locked text renderer.");
+	TR_ASSERT(std::ranges::all_of(m_layers, [](const layer& layer) { return layer.glyphs.empty(); }),
+			  "Tried to clear the glyph cache of a text renderer with text waiting to be drawn.");
+
+	m_atlas.clear();
+	m_advances.clear();
+	m_kerning.clear();
+#ifdef TR_ENABLE_ASSERTS
+	// The cleared glyphs have to be rasterized again, which allocates even if the same text is drawn as in the previous frame.
+	m_allocation_check.invalidate();
+#endif
+}
+
+//
+
+tr::usize tr::text_renderer::allocations() const
+{
+	return m_allocations;
+}
+
+//
+
+tr::text_renderer::drawer tr::text_renderer::create_drawer(int min_layer, int max_layer)
+{
+	return drawer{*this,
+				  {std::ranges::lower_bound(m_layers, min_layer, std::less{}, &layer::priority),
+				   std::ranges::upper_bound(m_layers, max_layer, std::less{}, &layer::priority)}};
+}
+
+tr::text_renderer::drawer tr::text_renderer::create_drawer()
+{
+	return drawer{*this, m_layers};
+}
+
+void tr::text_renderer::draw(const render_target& target)
+{
+	create_drawer().draw(target);
+}
+
+//
+
+tr::usize tr::text_renderer::glyph_key_hash::operator()(const glyph_key& key) const
+{
+	usize hash{boost::hash<usize>{}(key.font)};
+	boost::hash_combine(hash, key.size);
+	boost::hash_combine(hash, key.cp);
+	return hash;
+}
+
+tr::usize tr::text_renderer::kerning_key_hash::operator()(const kerning_key& key) const
+{
+	usize hash{boost::hash<usize>{}(key.font)};
+	boost::hash_combine(hash, key.size);
+	boost::hash_combine(hash, key.prev);
+	boost::hash_combine(hash, key.next);
+	return hash;
+}
+
+tr::text_renderer::layer& tr::text_renderer::get_layer(int layer)
+{
+#ifdef TR_ENABLE_ASSERTS
+	m_allocation_check.add_workload(layer);
+#endif
+
+	const auto it{std::ranges::lower_bound(m_layers, layer, std::less{}, &text_renderer::layer::priority)};
+	if (it != m_layers.end() && it->priority == layer) {
+		return *it;
+	}
+
+	if (m_layers.size() == m_layers.capacity()) {
+		++m_allocations;
+	}
+	return *m_layers.emplace(it, layer);
+}
+
+int tr::text_renderer::cache_glyph(usize font, codepoint cp)
+{
+	font_entry& entry{m_fonts[font]};
+	const glyph_key key{font, entry.size, cp};
+	auto it{m_advances.find(key)};
+	if (it == m_advances.end()) {
+		// Rasterizing a glyph always allocates its bitmap, so every cached glyph counts as an allocation.
+		++m_allocations;
+		// Glyphs are rasterized in white so that they can be tinted freely.
+		const bitmap bitmap{entry.font.render(cp, {255, 255, 255, 255})};
+		if (bitmap.size().x > 0 && bitmap.size().y > 0) {
+			m_atlas.add(key, bitmap);
+		}
+		it = m_advances.emplace(key, entry.font.metrics(cp).advance).first;
+	}
+	return it->second;
+}
+
+int tr::text_renderer::cached_kerning(usize font, codepoint prev, codepoint next)
+{
+	font_entry& entry{m_fonts[font]};
+	const kerning_key key{font, entry.size, prev, next};
+	auto it{m_kerning.find(key)};
+	if (it == m_kerning.end()) {
+		if (m_kerning.size() >= m_kerning.max_load()) {
+			++m_allocations;
+		}
+		it = m_kerning.emplace(key, entry.font.kerning(prev, next)).first;
+	}
+	return it->second;
+}
+
+int tr::text_renderer::line_width(usize font, std::string_view line)
+{
+	int width{0};
+	codepoint prev{0};
+	for (codepoint cp : utf8::range(line)) {
+		if (prev != 0) {
+			width += cached_kerning(font, prev, cp);
+		}
+		width += cache_glyph(font, cp);
+		prev = cp;
+	}
+	return width;
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements the drawer from text_renderer.hpp.                                                                                         //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/tr/sysgfx/text_renderer.hpp"
+
+////////////////////////////////////////////////////////////////// DRAWER /////////////////////////////////////////////////////////////////
+
+tr::text_renderer::drawer::drawer(text_renderer& renderer, std::ranges::subrange<std::vector<layer>::iterator> range)
+	: layered_instance_drawer{renderer, range}
+{
+	upload();
+}
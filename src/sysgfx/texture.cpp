@@ -7,6 +7,7 @@
 #include "../../include/tr/sysgfx/texture.hpp"
 #include "../../include/tr/sysgfx/gl_defines.hpp"
 #include "../../include/tr/sysgfx/graphics_context.hpp"
+#include "../../include/tr/sysgfx/render_target.hpp"
 #include "../../include/tr/sysgfx/texture_ref.hpp"
 #include "../../include/tr/utility/enum.hpp"
 
@@ -141,6 +142,21 @@ namespace tr {
 				TR_UNREACHABLE;
 			}
 		}
+
+		// Converts a minifying filter to its equivalent that doesn't use mipmaps.
+		int base_min_filter(int filter)
+		{
+			switch (filter) {
+			case GL_NEAREST_MIPMAP_NEAREST:
+			case GL_NEAREST_MIPMAP_LINEAR:
+				return GL_NEAREST;
+			case GL_LINEAR_MIPMAP_NEAREST:
+			case GL_LINEAR_MIPMAP_LINEAR:
+				return GL_LINEAR;
+			default:
+				return filter;
+			}
+		}
 	} // namespace
 } // namespace tr
 
@@ -149,16 +165,19 @@ namespace tr {
 tr::texture::texture(graphics_context& context)
 	: m_context{context}
 	, m_size{0, 0}
+	, m_version{context.allocate_texture_version()}
 {
 	const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
 
 	gl.create_textures(GL_TEXTURE_2D, 1, &m_handle);
 }
 
-tr::texture::texture(graphics_context& context, unsigned int handle, glm::ivec2 size)
+tr::texture::texture(graphics_context& context, unsigned int handle, glm::ivec2 size, bool mipmapped)
 	: m_context{context}
 	, m_handle{handle}
 	, m_size{size}
+	, m_mipmapped{mipmapped}
+	, m_version{context.allocate_texture_version()}
 {
 }
 
@@ -178,21 +197,23 @@ tr::texture::texture(texture&& r) noexcept
 	: m_context{r.m_context}
 	, m_handle{std::exchange(r.m_handle, 0)}
 	, m_size{r.m_size}
+	, m_mipmapped{r.m_mipmapped}
+	, m_renderable{r.m_renderable}
+	, m_version{r.m_version}
 	, m_references{std::move(r.m_references)}
 {
-	for (texture_ref& ref : m_references) {
-		ref.rebind(*this);
-	}
+	m_references.for_each([this](texture_ref& ref) { ref.rebind(*this); });
 }
 
 tr::texture::~texture()
 {
 	const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
 
-	gl.delete_textures(1, &m_handle);
-	for (texture_ref& ref : m_references) {
-		ref.unbind();
+	if (m_mipmapped) {
+		m_context.forget_dirty_mipmaps(m_handle);
 	}
+	gl.delete_textures(1, &m_handle);
+	unbind_references();
 }
 
 //
@@ -201,14 +222,19 @@ tr::texture& tr::texture::operator=(texture&& r) noexcept
 {
 	const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
 
-	gl.delete_textures(1, &m_handle);
-	for (texture_ref& ref : m_references) {
-		ref.unbind();
+	if (m_mipmapped) {
+		m_context.forget_dirty_mipmaps(m_handle);
 	}
+	gl.delete_textures(1, &m_handle);
+	unbind_references();
 
 	m_handle = std::exchange(r.m_handle, 0);
 	m_size = r.m_size;
+	m_mipmapped = r.m_mipmapped;
+	m_renderable = r.m_renderable;
+	m_version = r.m_version;
 	m_references = std::move(r.m_references);
+	m_references.for_each([this](texture_ref& ref) { ref.rebind(*this); });
 	return *this;
 }
 
@@ -222,6 +248,11 @@ tr::texture tr::texture::reallocate(glm::ivec2 size, mipmaps mipmaps, pixel_form
 
 	unsigned int old_handle{m_handle};
 	glm::ivec2 old_size{m_size};
+	const bool old_mipmapped{m_mipmapped};
+	// Out-of-date mipmaps of the old storage are released along with it.
+	if (m_mipmapped) {
+		m_context.forget_dirty_mipmaps(m_handle);
+	}
 
 	if (m_size != glm::ivec2{0, 0}) {
 		unsigned int new_handle;
@@ -262,10 +293,12 @@ tr::texture tr::texture::reallocate(glm::ivec2 size, mipmaps mipmaps, pixel_form
 		throw out_of_memory{"texture allocation"};
 	}
 	m_size = size;
+	m_mipmapped = levels > 1;
+	m_version = m_context.allocate_texture_version();
 
 	m_context.rebind_texture_units(*this);
 
-	return texture{m_context, old_handle, old_size};
+	return texture{m_context, old_handle, old_size, old_mipmapped};
 }
 
 //
@@ -280,6 +313,14 @@ glm::ivec2 tr::texture::size() const
 	return m_size;
 }
 
+std::optional<tr::u64> tr::texture::version() const
+{
+	if (m_renderable) {
+		return std::nullopt;
+	}
+	return m_version;
+}
+
 //
 
 void tr::texture::set_filtering(min_filter min_filter, mag_filter mag_filter)
@@ -290,6 +331,7 @@ void tr::texture::set_filtering(min_filter min_filter, mag_filter mag_filter)
 
 	gl.set_texture_parameter_i(m_handle, GL_TEXTURE_MIN_FILTER, to_underlying(min_filter));
 	gl.set_texture_parameter_i(m_handle, GL_TEXTURE_MAG_FILTER, to_underlying(mag_filter));
+	m_version = m_context.allocate_texture_version();
 }
 
 void tr::texture::set_wrap(wrap wrap)
@@ -301,6 +343,7 @@ void tr::texture::set_wrap(wrap wrap)
 	gl.set_texture_parameter_i(m_handle, GL_TEXTURE_WRAP_S, to_underlying(wrap));
 	gl.set_texture_parameter_i(m_handle, GL_TEXTURE_WRAP_T, to_underlying(wrap));
 	gl.set_texture_parameter_i(m_handle, GL_TEXTURE_WRAP_R, to_underlying(wrap));
+	m_version = m_context.allocate_texture_version();
 }
 
 void tr::texture::set_border_color(rgbaf color)
@@ -310,6 +353,7 @@ void tr::texture::set_border_color(rgbaf color)
 	const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
 
 	gl.set_texture_parameter_fv(m_handle, GL_TEXTURE_BORDER_COLOR, &color.r);
+	m_version = m_context.allocate_texture_version();
 }
 
 //
@@ -321,6 +365,7 @@ void tr::texture::clear(const rgbaf& color)
 	const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
 
 	gl.clear_texture_image(m_handle, 0, GL_RGBA, GL_FLOAT, &color);
+	mark_modified();
 }
 
 void tr::texture::clear_region(const rectangle<int>& region, const rgbaf& color)
@@ -330,6 +375,7 @@ void tr::texture::clear_region(const rectangle<int>& region, const rgbaf& color)
 	const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
 
 	gl.clear_texture_sub_image(m_handle, 0, region.tl.x, region.tl.y, 0, region.size.x, region.size.y, 1, GL_RGBA, GL_FLOAT, &color);
+	mark_modified();
 }
 
 void tr::texture::copy_region(glm::ivec2 tl, const texture& src, const rectangle<int>& region)
@@ -340,6 +386,7 @@ void tr::texture::copy_region(glm::ivec2 tl, const texture& src, const rectangle
 
 	gl.copy_image_sub_data(src.m_handle, GL_TEXTURE_2D, 0, region.tl.x, region.tl.y, 0, m_handle, GL_TEXTURE_2D, 0, tl.x, tl.y, 0,
 						   region.size.x, region.size.y, 1);
+	mark_modified();
 }
 
 void tr::texture::set_region(glm::ivec2 tl, const sub_bitmap& bitmap)
@@ -356,7 +403,7 @@ void tr::texture::set_region(glm::ivec2 tl, const sub_bitmap& bitmap)
 	gl.set_pixel_store_i(GL_UNPACK_ROW_LENGTH, bitmap.pitch() / pixel_bytes(bitmap.format()));
 	gl.set_2d_texture_sub_image(m_handle, 0, tl.x, tl.y, bitmap.size().x, bitmap.size().y, gl_format(bitmap.format()),
 								gl_type(bitmap.format()), bitmap.data());
-	gl.generate_texture_mipmap(m_handle);
+	mark_modified();
 }
 
 //
@@ -384,4 +431,359 @@ void tr::texture::set_label(std::string_view label)
 	if (!empty()) {
 		gl.set_object_label(GL_TEXTURE, m_handle, label.size(), label.data());
 	}
+}
+
+//
+
+void tr::texture::mark_modified()
+{
+	m_version = m_context.allocate_texture_version();
+	if (m_mipmapped) {
+		m_context.mark_mipmaps_dirty(m_handle);
+	}
+}
+
+void tr::texture::unbind_references()
+{
+	m_references.clear([](texture_ref& ref) { ref.unbind(); });
+}
+
+////////////////////////////////////////////////////////////// TEXTURE ARRAY //////////////////////////////////////////////////////////////
+
+tr::texture_array::texture_array(graphics_context& context, glm::ivec2 size, int layers, pixel_format format)
+	: texture{context, 0, size, false}
+	, m_layers{layers}
+{
+	allocate(gl_tex_format(format));
+}
+
+tr::texture_array::texture_array(const texture& prototype, glm::ivec2 size, int layers)
+	: texture{prototype.m_context, 0, size, false}
+	, m_layers{layers}
+{
+	TR_ASSERT(!prototype.empty(), "Tried to create a texture array from an empty prototype texture.");
+
+	const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
+
+	int internal_format;
+	gl.get_texture_level_parameter_iv(prototype.m_handle, 0, GL_TEXTURE_INTERNAL_FORMAT, &internal_format);
+	allocate(internal_format);
+
+	// Texture arrays don't have mipmaps, so mipmapped filtering is replaced by its base filter.
+	int min_filter;
+	gl.get_texture_parameter_iv(prototype.m_handle, GL_TEXTURE_MIN_FILTER, &min_filter);
+	gl.set_texture_parameter_i(m_handle, GL_TEXTURE_MIN_FILTER, base_min_filter(min_filter));
+
+	int mag_filter;
+	gl.get_texture_parameter_iv(prototype.m_handle, GL_TEXTURE_MAG_FILTER, &mag_filter);
+	gl.set_texture_parameter_i(m_handle, GL_TEXTURE_MAG_FILTER, mag_filter);
+}
+
+void tr::texture_array::allocate(unsigned int internal_format)
+{
+	TR_ASSERT(m_size.x > 0 && m_size.y > 0 && m_layers > 0, "Tried to allocate a texture array with an invalid size of {}x{}x{}", m_size.x,
+			  m_size.y, m_layers);
+
+	const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
+
+	gl.create_textures(GL_TEXTURE_2D_ARRAY, 1, &m_handle);
+	gl.allocate_3d_texture_storage(m_handle, 1, internal_format, m_size.x, m_size.y, m_layers);
+	if (gl.get_error() == GL_OUT_OF_MEMORY) {
+		throw out_of_memory{"texture array allocation"};
+	}
+	gl.set_texture_parameter_i(m_handle, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	gl.set_texture_parameter_i(m_handle, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	gl.set_texture_parameter_i(m_handle, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+//
+
+tr::texture_array::operator texture_ref() const
+{
+	return static_cast<const texture&>(*this);
+}
+
+//
+
+int tr::texture_array::layers() const
+{
+	return m_layers;
+}
+
+bool tr::texture_array::layerable(const texture& texture)
+{
+	if (texture.empty()) {
+		return false;
+	}
+
+	const graphics_context::glapi& gl{texture.m_context.make_current_and_return_glapi()};
+
+	int min_filter;
+	gl.get_texture_parameter_iv(texture.m_handle, GL_TEXTURE_MIN_FILTER, &min_filter);
+	int wraps[2];
+	gl.get_texture_parameter_iv(texture.m_handle, GL_TEXTURE_WRAP_S, &wraps[0]);
+	gl.get_texture_parameter_iv(texture.m_handle, GL_TEXTURE_WRAP_T, &wraps[1]);
+
+	// Layers are always sampled clamped to their edge and without mipmaps, so textures sampled otherwise would look different.
+	const bool samples_mipmaps{texture.m_mipmapped && base_min_filter(min_filter) != min_filter};
+	return wraps[0] == int(GL_CLAMP_TO_EDGE) && wraps[1] == int(GL_CLAMP_TO_EDGE) && !samples_mipmaps;
+}
+
+bool tr::texture_array::compatible(const texture& texture) const
+{
+	if (texture.empty() || texture.size().x > m_size.x || texture.size().y > m_size.y || !layerable(texture)) {
+		return false;
+	}
+
+	const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
+
+	int formats[2];
+	gl.get_texture_level_parameter_iv(m_handle, 0, GL_TEXTURE_INTERNAL_FORMAT, &formats[0]);
+	gl.get_texture_level_parameter_iv(texture.m_handle, 0, GL_TEXTURE_INTERNAL_FORMAT, &formats[1]);
+	int min_filters[2];
+	gl.get_texture_parameter_iv(m_handle, GL_TEXTURE_MIN_FILTER, &min_filters[0]);
+	gl.get_texture_parameter_iv(texture.m_handle, GL_TEXTURE_MIN_FILTER, &min_filters[1]);
+	int mag_filters[2];
+	gl.get_texture_parameter_iv(m_handle, GL_TEXTURE_MAG_FILTER, &mag_filters[0]);
+	gl.get_texture_parameter_iv(texture.m_handle, GL_TEXTURE_MAG_FILTER, &mag_filters[1]);
+
+	return formats[0] == formats[1] && min_filters[0] == base_min_filter(min_filters[1]) && mag_filters[0] == mag_filters[1];
+}
+
+//
+
+void tr::texture_array::clear_layer(int layer, const rgbaf& color)
+{
+	TR_ASSERT(layer >= 0 && layer < m_layers, "Tried to clear out-of-bounds layer {} in a texture array with {} layers.", layer, m_layers);
+
+	const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
+
+	gl.clear_texture_sub_image(m_handle, 0, 0, 0, layer, m_size.x, m_size.y, 1, GL_RGBA, GL_FLOAT, &color);
+	mark_modified();
+}
+
+void tr::texture_array::copy_to_layer(int layer, glm::ivec2 tl, const texture& src, const rectangle<int>& region)
+{
+	TR_ASSERT(layer >= 0 && layer < m_layers, "Tried to copy to out-of-bounds layer {} in a texture array with {} layers.", layer, m_layers);
+	TR_ASSERT(rectangle<int>{size()}.contains(tl + region.size),
+			  "Tried to copy to out-of-bounds region from ({}, {}) to ({}, {}) in a texture array with size {}x{}.", tl.x, tl.y,
+			  tl.x + region.size.x, tl.y + region.size.y, m_size.x, m_size.y);
+
+	const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
+
+	gl.copy_image_sub_data(src.m_handle, GL_TEXTURE_2D, 0, region.tl.x, region.tl.y, 0, m_handle, GL_TEXTURE_2D_ARRAY, 0, tl.x, tl.y,
+						   layer, region.size.x, region.size.y, 1);
+	mark_modified();
+}
+
+void tr::texture_array::set_layer_region(int layer, glm::ivec2 tl, const sub_bitmap& bitmap)
+{
+	TR_ASSERT(layer >= 0 && layer < m_layers, "Tried to set out-of-bounds layer {} in a texture array with {} layers.", layer, m_layers);
+	TR_ASSERT(rectangle<int>{size()}.contains(tl + bitmap.size()),
+			  "Tried to set out-of-bounds region from ({}, {}) to ({}, {}) in a texture array with size {}x{}.", tl.x, tl.y,
+			  tl.x + bitmap.size().x, tl.y + bitmap.size().y, m_size.x, m_size.y);
+
+	const graphics_context::glapi& gl{m_context.make_current_and_return_glapi()};
+
+	gl.set_pixel_store_i(GL_UNPACK_ALIGNMENT, 1);
+	gl.set_pixel_store_i(GL_UNPACK_ROW_LENGTH, bitmap.pitch() / pixel_bytes(bitmap.format()));
+	gl.set_3d_texture_sub_image(m_handle, 0, tl.x, tl.y, layer, bitmap.size().x, bitmap.size().y, 1, gl_format(bitmap.format()),
+								gl_type(bitmap.format()), bitmap.data());
+	mark_modified();
+}
+
+///////////////////////////////////////////////////////////// TEXTURE UPLOADER ////////////////////////////////////////////////////////////
+
+tr::texture_uploader::texture_uploader(graphics_context& context, usize staging_capacity)
+	: m_staging{context}
+	, m_staging_capacity{staging_capacity}
+{
+	m_staging.set_label("(tr) Texture Uploader Staging Buffer");
+}
+
+//
+
+tr::graphics_context& tr::texture_uploader::context() const
+{
+	return m_staging.context();
+}
+
+tr::usize tr::texture_uploader::staging_capacity() const
+{
+	return m_staging_capacity;
+}
+
+//
+
+void tr::texture_uploader::set_region(texture& texture, glm::ivec2 tl, const sub_bitmap& bitmap)
+{
+	TR_ASSERT(!texture.empty(), "Tried to upload to a region of an empty texture.");
+	TR_ASSERT(rectangle<int>{texture.size()}.contains(tl + bitmap.size()),
+			  "Tried to upload to out-of-bounds region from ({}, {}) to ({}, {}) in a texture with size {}x{}.", tl.x, tl.y,
+			  tl.x + bitmap.size().x, tl.y + bitmap.size().y, texture.size().x, texture.size().y);
+
+	const usize offset{stage(bitmap)};
+	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
+
+	gl.bind_buffer(GL_PIXEL_UNPACK_BUFFER, m_staging.id());
+	gl.set_pixel_store_i(GL_UNPACK_ALIGNMENT, 1);
+	gl.set_pixel_store_i(GL_UNPACK_ROW_LENGTH, 0);
+	gl.set_2d_texture_sub_image(texture.m_handle, 0, tl.x, tl.y, bitmap.size().x, bitmap.size().y, gl_format(bitmap.format()),
+								gl_type(bitmap.format()), reinterpret_cast<const void*>(offset));
+	gl.bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	texture.mark_modified();
+}
+
+void tr::texture_uploader::set_layer_region(texture_array& array, int layer, glm::ivec2 tl, const sub_bitmap& bitmap)
+{
+	TR_ASSERT(layer >= 0 && layer < array.layers(), "Tried to upload to out-of-bounds layer {} in a texture array with {} layers.", layer,
+			  array.layers());
+	TR_ASSERT(rectangle<int>{array.size()}.contains(tl + bitmap.size()),
+			  "Tried to upload to out-of-bounds region from ({}, {}) to ({}, {}) in a texture array with size {}x{}.", tl.x, tl.y,
+			  tl.x + bitmap.size().x, tl.y + bitmap.size().y, array.size().x, array.size().y);
+
+	const usize offset{stage(bitmap)};
+	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
+
+	gl.bind_buffer(GL_PIXEL_UNPACK_BUFFER, m_staging.id());
+	gl.set_pixel_store_i(GL_UNPACK_ALIGNMENT, 1);
+	gl.set_pixel_store_i(GL_UNPACK_ROW_LENGTH, 0);
+	gl.set_3d_texture_sub_image(array.m_handle, 0, tl.x, tl.y, layer, bitmap.size().x, bitmap.size().y, 1, gl_format(bitmap.format()),
+								gl_type(bitmap.format()), reinterpret_cast<const void*>(offset));
+	gl.bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	array.mark_modified();
+}
+
+//
+
+tr::usize tr::texture_uploader::stage(const sub_bitmap& bitmap)
+{
+	const usize row_size{bitmap.size().x * pixel_bytes(bitmap.format())};
+	const usize size{row_size * bitmap.size().y};
+
+	// Uploads that don't fit into the current region move on to the next one, fencing the current one.
+	constexpr usize alignment{4};
+	if (m_staging.region_size() + alignment + size > m_staging.region_capacity()) {
+		m_staging.begin_region(std::max(size + alignment, m_staging_capacity));
+	}
+
+	const usize offset{m_staging.allocate(size, alignment)};
+	const std::span<std::byte> staging{m_staging.mapped(offset, size)};
+	for (int y = 0; y < bitmap.size().y; ++y) {
+		std::copy_n(bitmap.data() + y * bitmap.pitch(), row_size, staging.begin() + y * row_size);
+	}
+	return offset;
+}
+
+///////////////////////////////////////////////////////////// TEXTURE READBACK ////////////////////////////////////////////////////////////
+
+tr::texture_readback::texture_readback(const texture& texture, const rectangle<int>& region, pixel_format format)
+	: m_buffer{texture.m_context}
+	, m_fence{fence_deleter{texture.m_context}}
+	, m_size{region.size}
+	, m_format{format}
+	, m_flipped{false}
+{
+	TR_ASSERT(!texture.empty(), "Tried to read back a region of an empty texture.");
+	TR_ASSERT(rectangle<int>{texture.size()}.contains(region.tl + region.size),
+			  "Tried to read back out-of-bounds region from ({}, {}) to ({}, {}) in a texture with size {}x{}.", region.tl.x, region.tl.y,
+			  region.tl.x + region.size.x, region.tl.y + region.size.y, texture.size().x, texture.size().y);
+
+	allocate_buffer();
+	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
+
+	gl.bind_buffer(GL_PIXEL_PACK_BUFFER, m_buffer.id());
+	gl.set_pixel_store_i(GL_PACK_ALIGNMENT, 1);
+	gl.get_texture_sub_image(texture.m_handle, 0, region.tl.x, region.tl.y, 0, m_size.x, m_size.y, 1, gl_format(format), gl_type(format),
+							 m_size.x * m_size.y * pixel_bytes(format), nullptr);
+	gl.bind_buffer(GL_PIXEL_PACK_BUFFER, 0);
+	m_fence.reset(gl.fence_sync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+}
+
+tr::texture_readback::texture_readback(graphics_context& context, const render_target& target, pixel_format format)
+	: m_buffer{context}
+	, m_fence{fence_deleter{context}}
+	, m_size{target.m_viewport.size}
+	, m_format{format}
+	, m_flipped{true}
+{
+	allocate_buffer();
+	const graphics_context::glapi& gl{context.make_current_and_return_glapi()};
+
+	const int bottom{target.m_fbo_size.y - target.m_viewport.tl.y - target.m_viewport.size.y};
+	gl.bind_framebuffer(GL_READ_FRAMEBUFFER, target.m_fbo);
+	gl.bind_buffer(GL_PIXEL_PACK_BUFFER, m_buffer.id());
+	gl.set_pixel_store_i(GL_PACK_ALIGNMENT, 1);
+	gl.read_pixels(target.m_viewport.tl.x, bottom, m_size.x, m_size.y, gl_format(format), gl_type(format), nullptr);
+	gl.bind_buffer(GL_PIXEL_PACK_BUFFER, 0);
+	m_fence.reset(gl.fence_sync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+}
+
+void tr::texture_readback::fence_deleter::operator()(void* fence) const
+{
+	const graphics_context::glapi& gl{context.make_current_and_return_glapi()};
+
+	gl.delete_sync(fence);
+}
+
+//
+
+tr::graphics_context& tr::texture_readback::context() const
+{
+	return m_buffer.context();
+}
+
+//
+
+glm::ivec2 tr::texture_readback::size() const
+{
+	return m_size;
+}
+
+bool tr::texture_readback::ready() const
+{
+	if (m_ready) {
+		return true;
+	}
+
+	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
+
+	const unsigned int result{gl.client_wait_sync(m_fence.get(), GL_SYNC_FLUSH_COMMANDS_BIT, 0)};
+	m_ready = result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+	// A fence that can't be waited on would never be signaled, so it's reported as finished and get() waits for all commands instead.
+	return m_ready || result == GL_WAIT_FAILED;
+}
+
+tr::bitmap tr::texture_readback::get() const
+{
+	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
+
+	if (!m_ready) {
+		context().wait_for_fence(m_fence.get());
+		m_ready = true;
+	}
+
+	const usize row_size{m_size.x * pixel_bytes(m_format)};
+	const usize size{row_size * m_size.y};
+	const std::byte* data{static_cast<const std::byte*>(gl.map_buffer_range(m_buffer.id(), 0, size, GL_MAP_READ_BIT))};
+	bitmap bitmap{m_size, m_format};
+	for (int y = 0; y < m_size.y; ++y) {
+		const int src_y{m_flipped ? m_size.y - 1 - y : y};
+		std::copy_n(data + src_y * row_size, row_size, bitmap.data() + y * bitmap.pitch());
+	}
+	gl.unmap_buffer(m_buffer.id());
+	return bitmap;
+}
+
+//
+
+void tr::texture_readback::allocate_buffer()
+{
+	const graphics_context::glapi& gl{context().make_current_and_return_glapi()};
+
+	const usize size{m_size.x * m_size.y * pixel_bytes(m_format)};
+	gl.allocate_buffer_storage(m_buffer.id(), std::max(size, usize{1}), nullptr, GL_MAP_READ_BIT | GL_CLIENT_STORAGE_BIT);
+	if (gl.get_error() == GL_OUT_OF_MEMORY) {
+		throw out_of_memory{"allocation of texture readback buffer"};
+	}
 }
\ No newline at end of file
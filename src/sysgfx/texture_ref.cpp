@@ -12,14 +12,14 @@
 tr::texture_ref::texture_ref(const texture& tex)
 	: m_ref{tex}
 {
-	tex.m_references.emplace_back(*this);
+	m_ref->m_references.push_front(*this);
 }
 
 tr::texture_ref::texture_ref(const texture_ref& r)
 	: m_ref{r.m_ref}
 {
 	if (!empty()) {
-		m_ref->m_references.emplace_back(*this);
+		m_ref->m_references.push_front(*this);
 	}
 }
 
@@ -27,14 +27,14 @@ tr::texture_ref::texture_ref(texture_ref&& r) noexcept
 	: m_ref{std::exchange(r.m_ref, std::nullopt)}
 {
 	if (!empty()) {
-		std::ranges::replace(m_ref->m_references, tr::ref{r}, tr::ref{*this});
+		m_ref->m_references.replace(r, *this);
 	}
 }
 
 tr::texture_ref::~texture_ref()
 {
 	if (!empty()) {
-		unstable_erase(m_ref->m_references, std::ranges::find(m_ref->m_references, *this));
+		m_ref->m_references.erase(*this);
 	}
 }
 
@@ -43,7 +43,7 @@ tr::texture_ref::~texture_ref()
 tr::texture_ref& tr::texture_ref::operator=(std::nullopt_t)
 {
 	if (!empty()) {
-		unstable_erase(m_ref->m_references, std::ranges::find(m_ref->m_references, *this));
+		m_ref->m_references.erase(*this);
 	}
 	m_ref = std::nullopt;
 	return *this;
@@ -52,39 +52,50 @@ tr::texture_ref& tr::texture_ref::operator=(std::nullopt_t)
 tr::texture_ref& tr::texture_ref::operator=(const texture& tex)
 {
 	if (!empty()) {
-		unstable_erase(m_ref->m_references, std::ranges::find(m_ref->m_references, *this));
+		m_ref->m_references.erase(*this);
 	}
 	m_ref = tex;
-	tex.m_references.emplace_back(*this);
+	m_ref->m_references.push_front(*this);
 	return *this;
 }
 
 tr::texture_ref& tr::texture_ref::operator=(const texture_ref& r)
 {
 	if (!empty()) {
-		unstable_erase(m_ref->m_references, std::ranges::find(m_ref->m_references, *this));
+		m_ref->m_references.erase(*this);
 	}
 	m_ref = r.m_ref;
 	if (!empty()) {
-		m_ref->m_references.emplace_back(*this);
+		m_ref->m_references.push_front(*this);
 	}
 	return *this;
 }
 
 tr::texture_ref& tr::texture_ref::operator=(texture_ref&& r) noexcept
 {
+	if (this == &r) {
+		return *this;
+	}
+
 	if (!empty()) {
-		unstable_erase(m_ref->m_references, std::ranges::find(m_ref->m_references, *this));
+		m_ref->m_references.erase(*this);
 	}
 	m_ref = std::exchange(r.m_ref, std::nullopt);
 	if (!empty()) {
-		std::ranges::replace(m_ref->m_references, tr::ref{r}, tr::ref{*this});
+		m_ref->m_references.replace(r, *this);
 	}
 	return *this;
 }
 
 //
 
+bool tr::operator==(const texture_ref& l, const texture_ref& r)
+{
+	return l.m_ref == r.m_ref;
+}
+
+//
+
 const tr::texture& tr::texture_ref::operator*() const
 {
 	return *m_ref;
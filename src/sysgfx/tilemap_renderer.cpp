@@ -0,0 +1,227 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements tilemap_renderer.hpp.                                                                                                      //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/tr/sysgfx/tilemap_renderer.hpp"
+
+///////////////////////////////////////////////////////////// TILEMAP RENDERER ////////////////////////////////////////////////////////////
+
+namespace {
+// Vertex shader source code.
+#include <generated/tilemap_renderer_vert.hpp>
+// Fragment shader source code.
+#include <generated/tilemap_renderer_frag.hpp>
+} // namespace
+
+namespace tr {
+	namespace {
+		// Gets the minimum and maximum corners of the area visible through a 2D transformation matrix.
+		std::pair<glm::vec2, glm::vec2> visible_bounds(const glm::mat4& mat)
+		{
+			const glm::mat4 inverse{glm::inverse(mat)};
+			glm::vec2 min{std::numeric_limits<float>::max()};
+			glm::vec2 max{std::numeric_limits<float>::lowest()};
+			for (glm::vec2 corner : {glm::vec2{-1, -1}, glm::vec2{1, -1}, glm::vec2{1, 1}, glm::vec2{-1, 1}}) {
+				const glm::vec4 world{inverse * glm::vec4{corner, 0, 1}};
+				min = glm::min(min, glm::vec2{world} / world.w);
+				max = glm::max(max, glm::vec2{world} / world.w);
+			}
+			return {min, max};
+		}
+	} // namespace
+} // namespace tr
+
+tr::tilemap_renderer::tilemap_renderer(graphics_context& context, glm::ivec2 size, glm::vec2 tile_size)
+	: m_id{context.allocate_renderer_id()}
+	, m_size{size}
+	, m_chunks{(size + chunk_size - 1) / chunk_size}
+	, m_tile_size{tile_size}
+	, m_tiles(usize(m_chunks.x) * usize(m_chunks.y) * chunk_tiles, empty_tile)
+	, m_chunk_tile_counts(usize(m_chunks.x) * usize(m_chunks.y), 0)
+	, m_dirty(usize(m_chunks.x) * usize(m_chunks.y), false)
+	, m_pipeline{context, vertex_shader{context, tilemap_renderer_vert}, fragment_shader{context, tilemap_renderer_frag}}
+	, m_vertex_format{context, vertex_format_bindings}
+	, m_quad_vertices{context, std::array<glm::u8vec2, 4>{{{0, 0}, {0, 1}, {1, 1}, {1, 0}}}}
+	, m_tile_buffer{context}
+{
+	TR_ASSERT(size.x > 0 && size.y > 0, "Tried to create a tilemap renderer with an invalid size of {}x{}.", size.x, size.y);
+
+	m_pipeline.set_label("(tr) Tilemap Renderer Pipeline");
+	m_pipeline.vertex_shader().set_label("(tr) Tilemap Renderer Vertex Shader");
+	m_pipeline.fragment_shader().set_label("(tr) Tilemap Renderer Fragment Shader");
+	m_vertex_format.set_label("(tr) Tilemap Renderer Vertex Format");
+	m_quad_vertices.set_label("(tr) Tilemap Renderer Quad Buffer");
+	m_tile_buffer.set_label("(tr) Tilemap Renderer Tile Buffer");
+
+	// Chunks are only ever drawn after being uploaded, so the initial contents of the buffer don't matter.
+	m_tile_buffer.resize(m_tiles.size());
+	m_pipeline.vertex_shader().set_uniform(0, m_transform);
+	m_pipeline.vertex_shader().set_uniform(1, tile_size);
+	m_pipeline.vertex_shader().set_uniform(2, chunk_size);
+}
+
+//
+
+tr::graphics_context& tr::tilemap_renderer::context() const
+{
+	return m_pipeline.context();
+}
+
+//
+
+glm::ivec2 tr::tilemap_renderer::size() const
+{
+	return m_size;
+}
+
+glm::vec2 tr::tilemap_renderer::tile_size() const
+{
+	return m_tile_size;
+}
+
+tr::u16 tr::tilemap_renderer::tile(glm::ivec2 pos) const
+{
+	return m_tiles[tile_index(pos)];
+}
+
+//
+
+void tr::tilemap_renderer::set_tile(glm::ivec2 pos, u16 tile)
+{
+	const usize index{tile_index(pos)};
+	const u16 old_tile{std::exchange(m_tiles[index], tile)};
+	if (old_tile == tile) {
+		return;
+	}
+
+	const usize chunk{index / chunk_tiles};
+	if (old_tile == empty_tile) {
+		++m_chunk_tile_counts[chunk];
+	}
+	else if (tile == empty_tile) {
+		--m_chunk_tile_counts[chunk];
+	}
+	if (!m_dirty[chunk]) {
+		m_dirty[chunk] = true;
+		m_dirty_chunks.push_back(chunk);
+	}
+}
+
+void tr::tilemap_renderer::clear()
+{
+	// Empty chunks are never drawn, so they don't need to be re-uploaded.
+	std::ranges::fill(m_tiles, empty_tile);
+	std::ranges::fill(m_chunk_tile_counts, 0);
+	std::ranges::fill(m_dirty, false);
+	m_dirty_chunks.clear();
+}
+
+void tr::tilemap_renderer::set_tileset(texture_ref texture, glm::ivec2 tiles)
+{
+	TR_ASSERT(tiles.x > 0 && tiles.y > 0, "Tried to set a tileset with an invalid size of {}x{} tiles.", tiles.x, tiles.y);
+	TR_ASSERT(usize(tiles.x) * usize(tiles.y) <= empty_tile, "Tried to set a tileset with more tiles than can be indexed.");
+
+	m_has_tileset = !texture.empty();
+	m_pipeline.vertex_shader().set_uniform(3, tiles);
+	m_pipeline.fragment_shader().set_uniform(0, std::move(texture));
+}
+
+void tr::tilemap_renderer::set_transform(const glm::mat4& mat)
+{
+	if (m_transform != mat) {
+		m_transform = mat;
+		m_pipeline.vertex_shader().set_uniform(0, m_transform);
+	}
+}
+
+void tr::tilemap_renderer::set_blend_mode(const blend_mode& blend_mode)
+{
+	m_blend_mode = blend_mode;
+}
+
+//
+
+tr::usize tr::tilemap_renderer::uploaded_chunks() const
+{
+	return m_uploaded_chunks;
+}
+
+tr::usize tr::tilemap_renderer::drawn_chunks() const
+{
+	return m_drawn_chunks;
+}
+
+//
+
+void tr::tilemap_renderer::draw(const render_target& target)
+{
+	TR_ASSERT(m_has_tileset, "Tried to draw a tilemap renderer without a tileset.");
+
+	graphics_context& context{m_pipeline.context()};
+
+	upload_dirty_chunks();
+
+	// Only the chunks overlapping the visible area are considered, and nothing is drawn if the visible area misses the map entirely
+	// (clamping its bounds would otherwise select the edge chunks).
+	m_drawn_chunks = 0;
+	const glm::vec2 chunk_extent{m_tile_size * float(chunk_size)};
+	const auto [min, max]{visible_bounds(m_transform)};
+	const glm::vec2 map_extent{glm::vec2{m_size} * m_tile_size};
+	if (max.x < 0 || max.y < 0 || min.x >= map_extent.x || min.y >= map_extent.y) {
+		return;
+	}
+	const glm::vec2 last_chunk{m_chunks - 1};
+	const glm::ivec2 min_chunk{glm::clamp(glm::floor(min / chunk_extent), glm::vec2{0}, last_chunk)};
+	const glm::ivec2 max_chunk{glm::clamp(glm::floor(max / chunk_extent), glm::vec2{0}, last_chunk)};
+
+	if (context.should_setup_renderer(m_id)) {
+		context.set_face_culling(false);
+		context.set_depth_test(false);
+		context.set_shader_pipeline(m_pipeline);
+		context.set_vertex_format(m_vertex_format);
+		context.set_vertex_buffer(m_quad_vertices, 0, 0);
+	}
+	context.set_blend_mode(m_blend_mode);
+	context.set_render_target(target);
+
+	for (int y = min_chunk.y; y <= max_chunk.y; ++y) {
+		for (int x = min_chunk.x; x <= max_chunk.x; ++x) {
+			const usize chunk{usize(y) * usize(m_chunks.x) + usize(x)};
+			if (m_chunk_tile_counts[chunk] == 0) {
+				continue;
+			}
+			m_pipeline.vertex_shader().set_uniform(4, glm::vec2{x, y} * chunk_extent);
+			context.set_vertex_buffer(m_tile_buffer, 1, chunk * chunk_tiles);
+			context.draw_instances(primitive::tri_fan, 0, 4, int(chunk_tiles));
+			++m_drawn_chunks;
+		}
+	}
+}
+
+//
+
+tr::usize tr::tilemap_renderer::tile_index(glm::ivec2 pos) const
+{
+	TR_ASSERT(pos.x >= 0 && pos.y >= 0 && pos.x < m_size.x && pos.y < m_size.y,
+			  "Tried to access out-of-bounds tile ({}, {}) of a {}x{} tilemap.", pos.x, pos.y, m_size.x, m_size.y);
+
+	const glm::ivec2 chunk{pos / chunk_size};
+	const glm::ivec2 tile{pos % chunk_size};
+	return (usize(chunk.y) * usize(m_chunks.x) + usize(chunk.x)) * chunk_tiles + usize(tile.y) * chunk_size + usize(tile.x);
+}
+
+void tr::tilemap_renderer::upload_dirty_chunks()
+{
+	m_uploaded_chunks = 0;
+	for (usize chunk : m_dirty_chunks) {
+		// Chunks that became empty again are never drawn, so they don't need to be uploaded.
+		if (m_chunk_tile_counts[chunk] != 0) {
+			m_tile_buffer.set_region(chunk * chunk_tiles, std::span{m_tiles}.subspan(chunk * chunk_tiles, chunk_tiles));
+			++m_uploaded_chunks;
+		}
+		m_dirty[chunk] = false;
+	}
+	m_dirty_chunks.clear();
+}
\ No newline at end of file
@@ -228,6 +228,12 @@ tr::ttfont tr::load_ttfont_file(const std::filesystem::path& path, float size)
 std::vector<std::string_view> tr::split_into_lines(std::string_view str)
 {
 	std::vector<std::string_view> lines;
+	split_into_lines(str, lines);
+	return lines;
+}
+
+void tr::split_into_lines(std::string_view str, std::vector<std::string_view>& lines)
+{
 	std::string_view::iterator start{str.begin()};
 	std::string_view::iterator end{std::find(start, str.end(), '\n')};
 	while (end != str.end()) {
@@ -236,7 +242,6 @@ std::vector<std::string_view> tr::split_into_lines(std::string_view str)
 		end = std::find(start, str.end(), '\n');
 	}
 	lines.push_back({start, end});
-	return lines;
 }
 
 std::vector<std::string_view> tr::break_overlong_lines(std::vector<std::string_view>&& lines, const ttfont& font, int max_w)
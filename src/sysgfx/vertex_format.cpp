@@ -60,6 +60,7 @@ void tr::vertex_format::deleter::operator()(unsigned int id) const
 {
 	const graphics_context::glapi& gl{context.make_current_and_return_glapi()};
 
+	context.forget_vertex_format(id);
 	gl.delete_vertex_arrays(1, &id);
 }
 
@@ -5,15 +5,26 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "../../include/tr/utility/binary_io.hpp"
+#include "../../include/tr/utility/exception.hpp"
 
-////////////////////////////////////////////////////////////// BINARY READING /////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////// BINARY SPAN READER ////////////////////////////////////////////////////////////
+
+void tr::binary_span_reader::throw_overrun(usize size) const
+{
+	throw custom_exception{"Binary reading error", "Tried to read past the end of the data.",
+						   TR_FMT::format("{} bytes requested, {} bytes remaining", size, remaining())};
+}
+
+/////////////////////////////////////////////////////////// BINARY SPAN WRITER ////////////////////////////////////////////////////////////
 
-void tr::binary_reader<std::string>::operator()(std::istream& is, std::string& out) const
+void tr::binary_span_writer::throw_overrun(usize size) const
 {
-	out.resize(read_binary<u32>(is));
-	is.read(out.data(), out.size());
+	throw custom_exception{"Binary writing error", "Tried to write past the end of the buffer.",
+						   TR_FMT::format("{} bytes requested, {} bytes remaining", size, remaining())};
 }
 
+////////////////////////////////////////////////////////////// BINARY READING /////////////////////////////////////////////////////////////
+
 bool tr::read_binary_magic(std::istream& is, std::string_view magic)
 {
 	for (char chr : magic) {
@@ -24,6 +35,14 @@ bool tr::read_binary_magic(std::istream& is, std::string_view magic)
 	return true;
 }
 
+bool tr::read_binary_magic(binary_span_reader& is, std::string_view magic)
+{
+	const std::span<const std::byte> data{is.remaining_bytes()};
+	const usize size{std::min(data.size(), magic.size())};
+	is.skip(size);
+	return size == magic.size() && std::ranges::equal(std::as_bytes(std::span{magic}), data.first(size));
+}
+
 std::vector<std::byte> tr::flush_binary(std::istream& is)
 {
 	std::vector<std::byte> out;
@@ -32,25 +51,9 @@ std::vector<std::byte> tr::flush_binary(std::istream& is)
 	return out;
 }
 
-////////////////////////////////////////////////////////////// BINARY WRITING /////////////////////////////////////////////////////////////
-
-void tr::binary_writer<const char*>::operator()(std::ostream& os, const char* in) const
-{
-	write_binary(os, std::string_view{in});
-}
-
-void tr::binary_writer<std::string_view>::operator()(std::ostream& os, const std::string_view& in) const
-{
-	write_binary(os, static_cast<u32>(in.size()));
-	os.write(in.data(), in.size());
-}
-
-void tr::binary_writer<std::string>::operator()(std::ostream& os, const std::string& in) const
-{
-	write_binary(os, std::string_view{in});
-}
-
-void tr::write_binary_magic(std::ostream& os, std::string_view magic)
+std::vector<std::byte> tr::flush_binary(binary_span_reader& is)
 {
-	os.write(magic.data(), magic.size());
+	const std::span<const std::byte> data{is.remaining_bytes()};
+	is.skip(data.size());
+	return {data.begin(), data.end()};
 }
\ No newline at end of file
@@ -6,7 +6,6 @@
 
 #include "../../include/tr/utility/encryption.hpp"
 #include "../../include/tr/utility/binary_io.hpp"
-#include "../../include/tr/utility/mstream.hpp"
 #include "../../include/tr/utility/rng.hpp"
 #include <lz4.h>
 
@@ -45,7 +44,7 @@ void tr::encrypt_to(std::vector<std::byte>& out, std::span<const std::byte> raw)
 
 	out.resize(LZ4_compressBound(raw.size()) + header_size);
 
-	omstream header{std::views::take(out, header_size)};
+	binary_span_writer header{std::span{out}.first(header_size)};
 	write_binary_magic(header, "tr");
 	write_binary(header, key, static_cast<u32>(raw.size()));
 
@@ -67,10 +66,13 @@ std::vector<std::byte> tr::encrypt(std::span<const std::byte> raw)
 
 void tr::decrypt_to(std::vector<std::byte>& out, std::vector<std::byte> encrypted)
 {
-	imstream header{std::views::take(encrypted, header_size)};
+	if (encrypted.size() < header_size) {
+		throw decryption_error{"Invalid compressed data header."};
+	}
+	binary_span_reader header{std::span{encrypted}.first(header_size)};
 	const std::span<const char> compressed{reinterpret_span<const char>(std::span{encrypted}).subspan(header_size)};
 
-	if (encrypted.size() < header_size || !read_binary_magic(header, "tr")) {
+	if (!read_binary_magic(header, "tr")) {
 		throw decryption_error{"Invalid compressed data header."};
 	}
 
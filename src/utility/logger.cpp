@@ -20,6 +20,19 @@ namespace tr {
 			static std::vector<std::string> registered_console_loggers;
 			return registered_console_loggers;
 		}
+
+		// The length of the longest registered console logger name, cached so it isn't recomputed on every line.
+		std::atomic<usize> g_max_console_logger_name_length{0};
+
+		// Recomputes the length of the longest registered console logger name.
+		void update_max_console_logger_name_length()
+		{
+			usize max_length{0};
+			for (const std::string& name : registered_console_loggers()) {
+				max_length = std::max(max_length, name.size());
+			}
+			g_max_console_logger_name_length = max_length;
+		}
 	} // namespace
 } // namespace tr
 
@@ -29,61 +42,64 @@ tr::console_logger::console_logger(std::string&& name)
 	TR_ASSERT(!contains(registered_console_loggers(), m_name), "Tried to register duplicate console logger '{}'", m_name);
 
 	registered_console_loggers().emplace_back(m_name);
+	update_max_console_logger_name_length();
 }
 
 tr::console_logger::~console_logger()
 {
 	unstable_erase(registered_console_loggers(), std::ranges::find(registered_console_loggers(), m_name));
+	update_max_console_logger_name_length();
 }
 
 //
 
-namespace tr {
-	namespace {
-		// String size projection.
-		usize string_size(const std::string& str)
-		{
-			return str.size();
-		}
-	} // namespace
-} // namespace tr
-
 void tr::console_logger::log(const std::tm& time, severity severity, std::string_view string)
 {
-	const usize padding{std::ranges::max_element(registered_console_loggers(), std::less{}, string_size)->size() - m_name.size()};
+	const usize padding{g_max_console_logger_name_length - m_name.size()};
 	println("[{:02}:{:02}:{:02}] [{}]{:{}} [{}] {}", time.tm_hour, time.tm_min, time.tm_sec, m_name, "", padding,
 			static_cast<char>(severity), string);
 }
 
 void tr::console_logger::log_continue(std::string_view string)
 {
-	const usize padding{std::ranges::max_element(registered_console_loggers(), std::less{}, string_size)->size() + 14};
+	const usize padding{g_max_console_logger_name_length + 14};
 	println("{:{}}--- {}", "", padding, string);
 }
 
 /////////////////////////////////////////////////////////////// FILE LOGGER ///////////////////////////////////////////////////////////////
 
+namespace tr {
+	namespace {
+		// Opens a log file, truncating it. Failing to open the file leaves the stream closed instead of throwing.
+		std::ofstream open_log_file(const std::filesystem::path& path)
+		{
+			try {
+				std::ofstream file{open_file_w(path, std::ios::trunc)};
+				file.exceptions(std::ios::goodbit);
+				return file;
+			}
+			catch (...) {
+				return std::ofstream{};
+			}
+		}
+	} // namespace
+} // namespace tr
+
 tr::file_logger::file_logger(std::filesystem::path&& path)
-	: m_path{std::move(path)}
+	: m_file{open_log_file(path)}
 {
-	try {
-		open_file_w(m_path, std::ios::trunc);
-	}
-	catch (...) {
-		return;
-	}
 }
 
 void tr::file_logger::log(const std::tm& time, severity severity, std::string_view string)
 {
-	std::ofstream file{m_path, std::ios::app};
-	println_to(file, "[{:02}:{:02}:{:02}] [{}] {}", time.tm_hour, time.tm_min, time.tm_sec, char(severity), string);
+	println_to(m_file, "[{:02}:{:02}:{:02}] [{}] {}", time.tm_hour, time.tm_min, time.tm_sec, char(severity), string);
+	m_file.flush();
 }
 
 void tr::file_logger::log_continue(std::string_view string)
 {
-	std::ofstream file{m_path, std::ios::app};
-	println_to(file, "           --- {}", string);
+	println_to(m_file, "           --- {}", string);
+	m_file.flush();
 }
 
 ///////////////////////////////////////////////////////// CONSOLE AND FILE LOGGER /////////////////////////////////////////////////////////
@@ -108,6 +124,244 @@ void tr::console_and_file_logger::log_continue(std::string_view string)
 	file_logger::log_continue(string);
 }
 
+//////////////////////////////////////////////////////////// ASYNC FILE LOGGER ////////////////////////////////////////////////////////////
+
+namespace tr {
+	namespace {
+		// Registry of live asynchronous loggers, flushed by tr::flush_async_loggers().
+		struct async_logger_registry {
+			// Mutex protecting the registry.
+			std::mutex mutex;
+			// The live asynchronous loggers.
+			std::vector<async_file_logger*> loggers;
+			// The terminate handler that was installed before ours.
+			std::terminate_handler previous_terminate_handler{nullptr};
+			// Flag used to install the terminate handler only once.
+			std::once_flag terminate_handler_installed;
+		};
+
+		// Must be a function because of the static object initialization fiasco.
+		async_logger_registry& async_loggers()
+		{
+			static async_logger_registry registry;
+			return registry;
+		}
+
+		// Terminate handler that writes out all queued messages before terminating.
+		[[noreturn]] void flush_async_loggers_and_terminate()
+		{
+			flush_async_loggers();
+			if (async_loggers().previous_terminate_handler != nullptr) {
+				async_loggers().previous_terminate_handler();
+			}
+			std::abort();
+		}
+	} // namespace
+} // namespace tr
+
+tr::async_file_logger::async_file_logger(std::filesystem::path&& path, log_overflow_policy policy, usize capacity)
+	: m_file{open_log_file(path)}
+	, m_policy{policy}
+	, m_slots{std::make_unique<slot[]>(std::bit_ceil(std::max(capacity, usize{2})))}
+	, m_mask{std::bit_ceil(std::max(capacity, usize{2})) - 1}
+{
+	for (usize i = 0; i <= m_mask; ++i) {
+		m_slots[i].sequence.store(i, std::memory_order::relaxed);
+	}
+	m_writer = std::jthread{[this](std::stop_token stoken) { writer_loop(std::move(stoken)); }};
+
+	async_logger_registry& registry{async_loggers()};
+	std::call_once(registry.terminate_handler_installed,
+				   [&] { registry.previous_terminate_handler = std::set_terminate(flush_async_loggers_and_terminate); });
+	std::lock_guard lock{registry.mutex};
+	registry.loggers.push_back(this);
+}
+
+tr::async_file_logger::~async_file_logger()
+{
+	async_logger_registry& registry{async_loggers()};
+	{
+		std::lock_guard lock{registry.mutex};
+		std::erase(registry.loggers, this);
+	}
+
+	// The writer drains the queue before exiting.
+	m_writer.request_stop();
+	signal_writer();
+	m_writer.join();
+}
+
+//
+
+namespace tr {
+	namespace {
+		// Whether the last message logged on this thread was fatal (fatal messages and their continuations are written synchronously).
+		thread_local bool t_logging_fatal{false};
+	} // namespace
+} // namespace tr
+
+void tr::async_file_logger::log(const std::tm& time, severity severity, std::string_view string)
+{
+	t_logging_fatal = severity == severity::fatal;
+	push({time, severity, false, std::string{string}});
+	if (t_logging_fatal) {
+		flush();
+	}
+}
+
+void tr::async_file_logger::log_continue(std::string_view string)
+{
+	push({{}, severity::info, true, std::string{string}});
+	if (t_logging_fatal) {
+		flush();
+	}
+}
+
+//
+
+void tr::async_file_logger::flush()
+{
+	// Flushing from the writer thread (from the terminate handler, for example) would deadlock.
+	if (std::this_thread::get_id() == m_writer.get_id()) {
+		return;
+	}
+
+	const usize target{m_push_position.load(std::memory_order::acquire)};
+	usize written{m_written.load(std::memory_order::acquire)};
+	while (written < target) {
+		m_written.wait(written, std::memory_order::acquire);
+		written = m_written.load(std::memory_order::acquire);
+	}
+}
+
+tr::usize tr::async_file_logger::dropped() const
+{
+	return m_dropped.load(std::memory_order::relaxed);
+}
+
+//
+
+void tr::async_file_logger::push(record&& value)
+{
+	while (!try_push(value)) {
+		// Fatal messages are never dropped, since they are likely the last thing logged before a crash.
+		if (m_policy != log_overflow_policy::block && !t_logging_fatal) {
+			m_dropped.fetch_add(1, std::memory_order::relaxed);
+			if (m_policy == log_overflow_policy::count) {
+				signal_writer();
+			}
+			return;
+		}
+
+		const usize written{m_written.load(std::memory_order::acquire)};
+		if (try_push(value)) {
+			break;
+		}
+		m_written.wait(written, std::memory_order::acquire);
+	}
+	signal_writer();
+}
+
+bool tr::async_file_logger::try_push(record& value)
+{
+	usize position{m_push_position.load(std::memory_order::relaxed)};
+	while (true) {
+		slot& target_slot{m_slots[position & m_mask]};
+		const usize sequence{target_slot.sequence.load(std::memory_order::acquire)};
+		const ssize difference{ssize(sequence) - ssize(position)};
+		if (difference == 0) {
+			if (m_push_position.compare_exchange_weak(position, position + 1, std::memory_order::relaxed)) {
+				target_slot.value = std::move(value);
+				target_slot.sequence.store(position + 1, std::memory_order::release);
+				return true;
+			}
+		}
+		else if (difference < 0) {
+			return false;
+		}
+		else {
+			position = m_push_position.load(std::memory_order::relaxed);
+		}
+	}
+}
+
+bool tr::async_file_logger::try_pop(record& value)
+{
+	slot& source_slot{m_slots[m_pop_position & m_mask]};
+	if (source_slot.sequence.load(std::memory_order::acquire) != m_pop_position + 1) {
+		return false;
+	}
+	value = std::move(source_slot.value);
+	source_slot.sequence.store(m_pop_position + m_mask + 1, std::memory_order::release);
+	++m_pop_position;
+	return true;
+}
+
+void tr::async_file_logger::signal_writer()
+{
+	m_signal.fetch_add(1, std::memory_order::release);
+	m_signal.notify_one();
+}
+
+void tr::async_file_logger::writer_loop(std::stop_token stoken)
+{
+	std::string batch;
+	record next;
+	usize reported_drops{0};
+	while (true) {
+		const u32 last_signal{m_signal.load(std::memory_order::acquire)};
+
+		// Batches are capped at the size of the queue so that blocked producers aren't starved by a never-ending batch.
+		usize popped{0};
+		while (popped <= m_mask && try_pop(next)) {
+			if (next.continuation) {
+				TR_FMT::format_to(std::back_inserter(batch), "           --- {}\n", next.string);
+			}
+			else {
+				TR_FMT::format_to(std::back_inserter(batch), "[{:02}:{:02}:{:02}] [{}] {}\n", next.time.tm_hour, next.time.tm_min,
+								  next.time.tm_sec, char(next.severity), next.string);
+			}
+			++popped;
+		}
+		if (m_policy == log_overflow_policy::count) {
+			const usize drops{m_dropped.load(std::memory_order::relaxed)};
+			if (drops != reported_drops) {
+				const std::tm time{tr::localtime(std::time(nullptr))};
+				TR_FMT::format_to(std::back_inserter(batch), "[{:02}:{:02}:{:02}] [{}] {} messages were dropped (log queue full).\n",
+								  time.tm_hour, time.tm_min, time.tm_sec, char(severity::warning), drops - reported_drops);
+				reported_drops = drops;
+			}
+		}
+
+		if (!batch.empty()) {
+			m_file.write(batch.data(), batch.size());
+			m_file.flush();
+			batch.clear();
+		}
+		if (popped != 0) {
+			m_written.fetch_add(popped, std::memory_order::release);
+			m_written.notify_all();
+		}
+		else if (stoken.stop_requested()) {
+			return;
+		}
+		else {
+			m_signal.wait(last_signal, std::memory_order::acquire);
+		}
+	}
+}
+
+//
+
+void tr::flush_async_loggers()
+{
+	async_logger_registry& registry{async_loggers()};
+	std::lock_guard lock{registry.mutex};
+	for (async_file_logger* logger : registry.loggers) {
+		logger->flush();
+	}
+}
+
 ////////////////////////////////////////////////////////////////// LOGGER /////////////////////////////////////////////////////////////////
 
 tr::logger::logger() {}
@@ -143,9 +397,27 @@ void tr::logger::clear_backend()
 
 //
 
+namespace tr {
+	namespace {
+		// Gets the current local time, only calling localtime when the second changes.
+		const std::tm& current_localtime()
+		{
+			thread_local std::time_t last_time{-1};
+			thread_local std::tm last_localtime{};
+
+			const std::time_t time{std::time(nullptr)};
+			if (time != last_time) {
+				last_localtime = tr::localtime(time);
+				last_time = time;
+			}
+			return last_localtime;
+		}
+	} // namespace
+} // namespace tr
+
 void tr::logger::log(severity severity, std::string_view str)
 {
-	m_backend->log(tr::localtime(std::time(nullptr)), severity, str);
+	m_backend->log(current_localtime(), severity, str);
 }
 
 void tr::logger::log(severity severity, const std::exception& err)
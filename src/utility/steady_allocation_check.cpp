@@ -0,0 +1,26 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements steady_allocation_check.hpp.                                                                                               //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/tr/utility/steady_allocation_check.hpp"
+
+///////////////////////////////////////////////////////// STEADY ALLOCATION CHECK /////////////////////////////////////////////////////////
+
+void tr::steady_allocation_check::invalidate()
+{
+	m_invalidated = true;
+}
+
+bool tr::steady_allocation_check::end_frame(usize allocations)
+{
+	const bool repeated{!m_invalidated && m_last_workload == m_workload};
+	const bool steady{!repeated || allocations == m_last_allocations};
+
+	m_last_workload = m_invalidated ? std::nullopt : std::optional{m_workload};
+	m_last_allocations = allocations;
+	m_workload = 0;
+	m_invalidated = false;
+	return steady;
+}
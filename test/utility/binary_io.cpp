@@ -6,6 +6,7 @@
 
 #include <gtest/gtest.h>
 #include <tr/utility/binary_io.hpp>
+#include <tr/utility/exception.hpp>
 #include <tr/utility/rng.hpp>
 
 #define CHECK_ROUNDTRIP(expr)                                                                                                              \
@@ -71,4 +72,82 @@ TEST(binary_io_test, containers)
 	CHECK_ROUNDTRIP(TR_MACRO_COMMA_GUARD(std::map<int, std::string>{{1, "a"}, {2, "b"}, {3, "c"}}));
 	CHECK_ROUNDTRIP(TR_MACRO_COMMA_GUARD(boost::unordered_flat_map<int, std::string>{{1, "a"}, {2, "b"}, {3, "c"}}));
 	CHECK_ROUNDTRIP(TR_MACRO_COMMA_GUARD(boost::unordered_node_map<int, std::string>{{1, "a"}, {2, "b"}, {3, "c"}}));
+}
+
+TEST(binary_io_test, span_roundtrip)
+{
+	tr::binary_buffer buffer;
+	tr::write_binary_magic(buffer, "tr");
+	tr::write_binary(buffer, 50, 1.0f, std::string{"test"}, std::vector<int>{1, 2, 3, 4, 5});
+	tr::write_binary(buffer, std::map<int, std::string>{{1, "a"}, {2, "b"}, {3, "c"}});
+
+	tr::binary_span_reader reader{buffer.bytes()};
+	EXPECT_TRUE(tr::read_binary_magic(reader, "tr"));
+	EXPECT_EQ(tr::read_binary<int>(reader), 50);
+	EXPECT_EQ(tr::read_binary<float>(reader), 1.0f);
+	EXPECT_EQ(tr::read_binary<std::string>(reader), "test");
+	EXPECT_EQ(tr::read_binary<std::vector<int>>(reader), (std::vector<int>{1, 2, 3, 4, 5}));
+	EXPECT_EQ((tr::read_binary<std::map<int, std::string>>(reader)), (std::map<int, std::string>{{1, "a"}, {2, "b"}, {3, "c"}}));
+	EXPECT_EQ(reader.position(), buffer.size());
+	EXPECT_EQ(reader.remaining(), 0);
+}
+
+TEST(binary_io_test, span_matches_stream)
+{
+	std::stringstream ios;
+	tr::binary_buffer buffer;
+
+	tr::write_binary(ios, 50, std::string_view{"test"}, std::array<float, 3>{1, 2, 3});
+	tr::write_binary(buffer, 50, std::string_view{"test"}, std::array<float, 3>{1, 2, 3});
+	EXPECT_TRUE(std::ranges::equal(tr::flush_binary(ios), buffer.bytes()));
+}
+
+TEST(binary_io_test, span_overrun)
+{
+	std::array<std::byte, 6> data{};
+
+	tr::binary_span_writer writer{data};
+	tr::write_binary(writer, 50);
+	EXPECT_EQ(writer.written_bytes().size(), sizeof(int));
+	EXPECT_THROW(tr::write_binary(writer, 50), tr::custom_exception);
+
+	tr::binary_span_reader reader{data};
+	EXPECT_EQ(tr::read_binary<int>(reader), 50);
+	EXPECT_THROW(tr::read_binary<int>(reader), tr::custom_exception);
+	EXPECT_FALSE(tr::read_binary_magic(reader, "tr!"));
+
+	// Corrupted element counts are rejected before anything is allocated.
+	tr::binary_buffer buffer;
+	tr::write_binary(buffer, UINT32_MAX, 50);
+	tr::binary_span_reader vector_reader{buffer.bytes()};
+	EXPECT_THROW(tr::read_binary<std::vector<int>>(vector_reader), tr::custom_exception);
+	tr::binary_span_reader string_reader{buffer.bytes()};
+	EXPECT_THROW(tr::read_binary<std::string>(string_reader), tr::custom_exception);
+}
+
+TEST(binary_io_test, flush)
+{
+	std::vector<std::byte> data(10000);
+	for (tr::usize i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<std::byte>(i);
+	}
+
+	std::stringstream ios;
+	ios.write(reinterpret_cast<const char*>(data.data()), data.size());
+	EXPECT_EQ(tr::flush_binary(ios), data);
+	EXPECT_FALSE(ios.fail());
+
+	// Reaching the end of a stream that throws on failure must not throw.
+	std::stringstream throwing_ios;
+	throwing_ios.exceptions(std::ios::badbit | std::ios::failbit);
+	throwing_ios.write(reinterpret_cast<const char*>(data.data()), data.size());
+	EXPECT_EQ(tr::flush_binary(throwing_ios), data);
+
+	tr::binary_span_reader reader{data};
+	reader.skip(100);
+	std::vector<unsigned char> flushed;
+	tr::flush_binary(reader, std::back_inserter(flushed));
+	EXPECT_EQ(flushed.size(), data.size() - 100);
+	EXPECT_EQ(flushed.front(), 100);
+	EXPECT_EQ(reader.remaining(), 0);
 }
\ No newline at end of file
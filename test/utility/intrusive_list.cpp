@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Tests utility/intrusive_list.hpp.                                                                                                     //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <tr/utility/intrusive_list.hpp>
+#include <tr/utility/stopwatch.hpp>
+
+struct element : tr::intrusive_list_node<element> {
+	int value;
+
+	element(int value = 0)
+		: value{value}
+	{
+	}
+};
+
+// Gets the values of the elements of a list in order.
+std::vector<int> values_of(const tr::intrusive_list<element>& list)
+{
+	std::vector<int> values;
+	list.for_each([&](element& e) { values.push_back(e.value); });
+	return values;
+}
+
+TEST(intrusive_list_test, push_front)
+{
+	element a{1}, b{2}, c{3};
+	tr::intrusive_list<element> list;
+	EXPECT_TRUE(list.empty());
+	list.push_front(a);
+	list.push_front(b);
+	list.push_front(c);
+	EXPECT_FALSE(list.empty());
+	EXPECT_EQ(values_of(list), (std::vector<int>{3, 2, 1}));
+}
+
+TEST(intrusive_list_test, erase)
+{
+	element a{1}, b{2}, c{3};
+	tr::intrusive_list<element> list;
+	list.push_front(a);
+	list.push_front(b);
+	list.push_front(c);
+	list.erase(b);
+	EXPECT_EQ(values_of(list), (std::vector<int>{3, 1}));
+	list.erase(c);
+	EXPECT_EQ(values_of(list), (std::vector<int>{1}));
+	list.erase(a);
+	EXPECT_TRUE(list.empty());
+}
+
+TEST(intrusive_list_test, replace)
+{
+	element a{1}, b{2}, c{3}, d{4};
+	tr::intrusive_list<element> list;
+	list.push_front(a);
+	list.push_front(b);
+	list.push_front(c);
+	list.replace(b, d);
+	EXPECT_EQ(values_of(list), (std::vector<int>{3, 4, 1}));
+	list.replace(c, b);
+	EXPECT_EQ(values_of(list), (std::vector<int>{2, 4, 1}));
+}
+
+TEST(intrusive_list_test, copied_node_is_unlinked)
+{
+	element a{1}, b{2};
+	tr::intrusive_list<element> list;
+	list.push_front(a);
+	list.push_front(b);
+	element copy{b};
+	tr::intrusive_list<element> other;
+	other.push_front(copy);
+	EXPECT_EQ(values_of(list), (std::vector<int>{2, 1}));
+	EXPECT_EQ(values_of(other), (std::vector<int>{2}));
+}
+
+TEST(intrusive_list_test, move)
+{
+	element a{1}, b{2};
+	tr::intrusive_list<element> list;
+	list.push_front(a);
+	list.push_front(b);
+	tr::intrusive_list<element> moved{std::move(list)};
+	EXPECT_TRUE(list.empty());
+	EXPECT_EQ(values_of(moved), (std::vector<int>{2, 1}));
+	list = std::move(moved);
+	EXPECT_TRUE(moved.empty());
+	EXPECT_EQ(values_of(list), (std::vector<int>{2, 1}));
+}
+
+TEST(intrusive_list_test, clear)
+{
+	element a{1}, b{2};
+	tr::intrusive_list<element> list;
+	list.push_front(a);
+	list.push_front(b);
+	int cleared{0};
+	list.clear([&](element& e) {
+		e.value = 0;
+		++cleared;
+	});
+	EXPECT_TRUE(list.empty());
+	EXPECT_EQ(cleared, 2);
+	EXPECT_EQ(a.value, 0);
+	EXPECT_EQ(b.value, 0);
+
+	// Cleared elements must be unlinked, so that they can be added to another list.
+	tr::intrusive_list<element> other;
+	other.push_front(a);
+	EXPECT_EQ(values_of(other), (std::vector<int>{0}));
+}
+
+// Erases, re-adds and replaces every element of a list of a given size, returning the average time taken per element.
+tr::dnsecs churn(tr::usize size)
+{
+	std::vector<element> elements(size);
+	element spare;
+	tr::intrusive_list<element> list;
+	for (element& e : elements) {
+		list.push_front(e);
+	}
+
+	constexpr int rounds{10};
+	tr::stopwatch stopwatch;
+	for (int round = 0; round < rounds; ++round) {
+		for (element& e : elements) {
+			list.erase(e);
+			list.push_front(e);
+			list.replace(e, spare);
+			list.replace(spare, e);
+		}
+	}
+	return tr::dnsecs{stopwatch.elapsed()} / (rounds * size);
+}
+
+TEST(intrusive_list_test, scales_to_10k_elements)
+{
+	// Warm up once so that the first measurement isn't penalized.
+	churn(100);
+	// The time taken per element must not grow with the size of the list. A linear search per operation would make the larger list
+	// about a hundred times slower per element, so a generous bound is used to keep the test stable on noisy machines.
+	const tr::dnsecs small{churn(100)};
+	const tr::dnsecs large{churn(10000)};
+	EXPECT_LT(large.count(), std::max(small.count(), 1.0) * 10);
+}
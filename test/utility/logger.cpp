@@ -5,6 +5,7 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <gtest/gtest.h>
+#include <tr/utility/iostream.hpp>
 #include <tr/utility/logger.hpp>
 #include <tr/utility/reference.hpp>
 
@@ -42,4 +43,91 @@ TEST(logger_test, log)
 	tr::logger logger{tr::make_logger<logger_backend_mock>()};
 	logger.log(tr::severity::info, "This is an integer: {}", 420);
 	logger.log_continue("This is a float: {:.2f}", std::numbers::pi);
+}
+
+namespace {
+	// Reads all lines of a file.
+	std::vector<std::string> read_lines(const std::filesystem::path& path)
+	{
+		std::ifstream file{path};
+		std::vector<std::string> lines;
+		for (std::string line; std::getline(file, line);) {
+			lines.push_back(std::move(line));
+		}
+		return lines;
+	}
+} // namespace
+
+TEST(logger_test, async_file_logger)
+{
+	const std::filesystem::path path{std::filesystem::temp_directory_path() / "tr_async_file_logger_test.txt"};
+	{
+		tr::logger logger{tr::make_logger<tr::async_file_logger>(std::filesystem::path{path})};
+		logger.log(tr::severity::warning, "This is an integer: {}", 420);
+		logger.log_continue("This is a float: {:.2f}", std::numbers::pi);
+		dynamic_cast<tr::async_file_logger&>(logger.backend()).flush();
+
+		const std::vector<std::string> lines{read_lines(path)};
+		ASSERT_EQ(lines.size(), 2);
+		EXPECT_TRUE(lines[0].ends_with("[W] This is an integer: 420"));
+		EXPECT_EQ(lines[1], "           --- This is a float: 3.14");
+	}
+	std::filesystem::remove(path);
+}
+
+TEST(logger_test, async_file_logger_block)
+{
+	constexpr int THREADS{4};
+	constexpr int MESSAGES_PER_THREAD{1000};
+
+	const std::filesystem::path path{std::filesystem::temp_directory_path() / "tr_async_file_logger_block_test.txt"};
+	{
+		tr::async_file_logger backend{std::filesystem::path{path}, tr::log_overflow_policy::block, 16};
+		std::vector<std::jthread> threads;
+		for (int i = 0; i < THREADS; ++i) {
+			threads.emplace_back([&backend, i] {
+				for (int j = 0; j < MESSAGES_PER_THREAD; ++j) {
+					backend.log({}, tr::severity::info, TR_FMT::format("{} {}", i, j));
+				}
+			});
+		}
+		threads.clear();
+		backend.flush();
+
+		EXPECT_EQ(backend.dropped(), 0);
+		const std::vector<std::string> lines{read_lines(path)};
+		ASSERT_EQ(lines.size(), THREADS * MESSAGES_PER_THREAD);
+		// Messages from the same thread must stay in order.
+		std::array<int, THREADS> next{};
+		for (const std::string& line : lines) {
+			int thread;
+			int message;
+			ASSERT_EQ(std::sscanf(line.c_str(), "[00:00:00] [I] %d %d", &thread, &message), 2);
+			EXPECT_EQ(message, next[thread]++);
+		}
+	}
+	std::filesystem::remove(path);
+}
+
+TEST(logger_test, async_file_logger_count)
+{
+	constexpr int MESSAGES{10000};
+
+	const std::filesystem::path path{std::filesystem::temp_directory_path() / "tr_async_file_logger_count_test.txt"};
+	{
+		tr::async_file_logger backend{std::filesystem::path{path}, tr::log_overflow_policy::count, 4};
+		for (int i = 0; i < MESSAGES; ++i) {
+			backend.log({}, tr::severity::info, "message");
+		}
+		backend.flush();
+
+		// Every message is either written or dropped, and drops are reported in the log.
+		const std::vector<std::string> lines{read_lines(path)};
+		const tr::usize written{tr::usize(std::ranges::count(lines, "[00:00:00] [I] message"))};
+		EXPECT_EQ(written + backend.dropped(), tr::usize(MESSAGES));
+		if (backend.dropped() != 0) {
+			EXPECT_TRUE(std::ranges::any_of(lines, [](const std::string& line) { return line.ends_with("(log queue full)."); }));
+		}
+	}
+	std::filesystem::remove(path);
 }
\ No newline at end of file
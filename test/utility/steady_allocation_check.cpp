@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Tests utility/steady_allocation_check.hpp.                                                                                            //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <tr/utility/steady_allocation_check.hpp>
+
+// Mock of a renderer that keeps the storage of its primitives between frames.
+struct mock_renderer {
+	std::vector<int> primitives;
+	tr::usize allocations{0};
+	tr::steady_allocation_check check;
+
+	void add(int primitive)
+	{
+		if (primitives.size() == primitives.capacity()) {
+			++allocations;
+		}
+		primitives.push_back(primitive);
+		check.add_workload(primitive);
+	}
+
+	bool draw()
+	{
+		primitives.clear();
+		return check.end_frame(allocations);
+	}
+
+	void release_storage()
+	{
+		std::vector<int>{}.swap(primitives);
+	}
+};
+
+TEST(steady_allocation_check_test, repeated_frame)
+{
+	mock_renderer renderer;
+	for (int frame = 0; frame < 3; ++frame) {
+		for (int i = 0; i < 100; ++i) {
+			renderer.add(i);
+		}
+		EXPECT_TRUE(renderer.draw());
+	}
+}
+
+TEST(steady_allocation_check_test, growing_frame)
+{
+	mock_renderer renderer;
+	for (int frame = 1; frame < 10; ++frame) {
+		for (int i = 0; i < frame * 100; ++i) {
+			renderer.add(i);
+		}
+		EXPECT_TRUE(renderer.draw());
+	}
+}
+
+TEST(steady_allocation_check_test, allocating_repeated_frame)
+{
+	mock_renderer renderer;
+	renderer.add(1);
+	EXPECT_TRUE(renderer.draw());
+	// Storage released between frames has to be allocated again, even though the workload didn't change.
+	renderer.release_storage();
+	renderer.add(1);
+	EXPECT_FALSE(renderer.draw());
+}
+
+TEST(steady_allocation_check_test, invalidate)
+{
+	mock_renderer renderer;
+	renderer.add(1);
+	EXPECT_TRUE(renderer.draw());
+	renderer.release_storage();
+	renderer.add(1);
+	renderer.check.invalidate();
+	EXPECT_TRUE(renderer.draw());
+	// The invalidated frame isn't compared to the next one either.
+	renderer.release_storage();
+	renderer.add(1);
+	EXPECT_TRUE(renderer.draw());
+	renderer.release_storage();
+	renderer.add(1);
+	EXPECT_FALSE(renderer.draw());
+}